@@ -3,39 +3,92 @@
 #define STRUCTURES_ARRAY_LIST_H
 
 #include <cstdint>
+#include <cstdio>  // std::FILE
+#include <cstring>
+#include <limits>
+#include <memory>  // std::allocator
+#include <new>  // placement new
 #include <stdexcept>  // C++ Exceptions
+#include <type_traits>
+#include <utility>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "./error_policy.h"
+#include "./mapped_file.h"
 
 namespace structures {
 
-template<typename T>
+template<typename T, typename Policy = ThrowPolicy>
 //! Classe ArrayList
+/*!
+ *  Policy decide o que acontece quando uma pre-condicao falha (lista
+ *  cheia, vazia, indice invalido): ThrowPolicy lanca std::out_of_range,
+ *  ExpectedPolicy devolve Expected com o Status e UncheckedPolicy so
+ *  verifica em debug. Veja error_policy.h.
+ */
 class ArrayList {
  public:
+    //! retorno de uma operacao que devolveria R, conforme Policy
+    template<typename R>
+    using Result = typename Policy::template result<R>;
+
     //! Metodo construtor
     ArrayList();
     //! Metodo construtor com parametro
     explicit ArrayList(std::size_t max_size);
     //! Metodo destrutor
     ~ArrayList();
+    //! construtor de movimento
+    ArrayList(ArrayList&& other);
+    //! atribuicao de movimento
+    ArrayList& operator=(ArrayList&& other);
     //! limpa lista
     void clear();
     //! adiciona no fim
-    void push_back(const T& data);
+    Result<void> push_back(const T& data) noexcept(nothrow_copy<Policy, T>);
     //! adiciona no começo
-    void push_front(const T& data);
+    Result<void> push_front(const T& data) noexcept(nothrow_copy<Policy, T>);
     //! adiciona na posicao index
-    void insert(const T& data, std::size_t index);
+    Result<void> insert(const T& data, std::size_t index)
+        noexcept(nothrow_copy<Policy, T>);
     //! metodo de adicionar em ordem
-    void insert_sorted(const T& data);
+    Result<void> insert_sorted(const T& data);
     //! remove na posicao index
-    T pop(std::size_t index);
+    Result<T> pop(std::size_t index) noexcept(nothrow_move<Policy, T>);
     //! remove do fim
-    T pop_back();
+    Result<T> pop_back() noexcept(nothrow_move<Policy, T>);
     //! remove do comeco
-    T pop_front();
+    Result<T> pop_front() noexcept(nothrow_move<Policy, T>);
     //! remove dado especifico
-    void remove(const T& data);
+    Result<void> remove(const T& data);
+    //! adiciona no fim sem lancar; Status::FULL se cheia
+    Status try_push_back(const T& data)
+        noexcept(std::is_nothrow_copy_constructible<T>::value);
+    //! remove do fim em *data sem lancar; Status::EMPTY se vazia
+    Status try_pop_back(T* data)
+        noexcept(std::is_nothrow_move_assignable<T>::value);
+    //! intercala other nesta lista, mantendo repetidos
+    /*!
+     *  As operacoes de conjunto supoem as duas listas em ordem crescente
+     *  (como insert_sorted deixa) e fazem uma passada so, no proprio
+     *  array. Repetidos contam como em std::set_union e afins. Falham com
+     *  Status::FULL se o resultado nao couber em max_size().
+     */
+    Result<void> merge(const ArrayList& other);
+    //! uniao ordenada com other
+    Result<void> set_union(const ArrayList& other);
+    //! intersecao ordenada com other
+    /*!
+     *  Com tamanhos muito diferentes usa busca exponencial na maior lista;
+     *  senao varre as duas, 4 dados por vez com SSE2 se T for inteiro de
+     *  32 bits.
+     */
+    Result<void> set_intersection(const ArrayList& other);
+    //! tira desta lista ordenada os dados de other
+    Result<void> set_difference(const ArrayList& other);
     //! verifica se a lista esta cheia
     bool full();
     //! verifica se a lista esta vazia
@@ -49,196 +102,632 @@ class ArrayList {
     //! tamanho do array
     std::size_t max_size() const;
     //! retorna dado em tal index
-    T& at(std::size_t index);
+    Result<T&> at(std::size_t index) noexcept(Policy::nothrow);
     //! retorna dado em tal index
-    T& operator[](std::size_t index);
+    T& operator[](std::size_t index) noexcept;
     //! reotorna dado em tal index sem mudar seu valor
-    const T& at(std::size_t index) const;
+    Result<const T&> at(std::size_t index) const
+        noexcept(Policy::nothrow);
     //! retorna dado em tal index sem mudar seu valor
-    const T& operator[](std::size_t index) const;
+    const T& operator[](std::size_t index) const noexcept;
+    //! grava a lista em arquivo binario (T trivialmente copiavel)
+    void save(const char* path) const;
+    //! abre lista gravada por save() via mmap, sem copiar os dados
+    /*!
+     *  Sem copy_on_write o mapeamento e' PROT_READ: mutacoes falham com
+     *  Status::READ_ONLY em qualquer Policy e uma escrita por at ou
+     *  operator[] derruba o processo com SIGSEGV, sem custo no acesso.
+     *  Com copy_on_write as escritas ficam privadas ao processo
+     *  (capacidade = tamanho salvo). verify recalcula o checksum, o que
+     *  le o arquivo inteiro.
+     */
+    static ArrayList open_mapped(const char* path,
+                                 bool copy_on_write = false,
+                                 bool verify = false);
 
  private:
+    //! cabecalho do arquivo binario (64 bytes, dados alinhados a seguir)
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianness;
+        std::uint64_t element_size;
+        std::uint64_t count;
+        std::uint64_t checksum;
+        char reserved[24];
+    };
+
+    //! remove na posicao index (valida) sem devolver o dado
+    Result<void> erase_at(std::size_t index);
+    //! construtor sobre um arquivo mapeado
+    ArrayList(MappedFile&& mapping, std::size_t count, bool read_only);
+    //! constroi dado em uma posicao ainda nao inicializada
+    void construct(std::size_t index, const T& data);
+    //! destroi dado em uma posicao (nada a fazer se trivial)
+    void destroy(std::size_t index);
+    //! abre espaco em index deslocando [index, last] para a direita
+    void shift_right(std::size_t index);
+    //! fecha o espaco em index deslocando (index, last] para a esquerda
+    void shift_left(std::size_t index);
+    //! grava em index, construindo se a posicao ainda nao foi usada
+    template<typename U>
+    void place(std::size_t index, U&& data);
+    //! descarta os dados a partir de size
+    void truncate(std::size_t size);
+    //! primeira posicao de [begin, end) que nao e' menor que data, por
+    //! busca exponencial a partir de begin
+    static std::size_t gallop(const T* contents, std::size_t begin,
+                              std::size_t end, const T& data);
+    //! intersecao por busca exponencial (listas de tamanhos distantes)
+    void intersect_galloping(const ArrayList& other);
+    //! intersecao por varredura das duas listas
+    void intersect_linear(const ArrayList& other);
+
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
     int last;
+    MappedFile mapping_;
+    bool read_only_{false};
 
     static const auto DEFAULT_MAX = 10u;
+    static const std::size_t GALLOP_RATIO = 32u;
+    static const std::uint32_t FILE_VERSION = 1u;
+    static const std::uint32_t ENDIAN_MARK = 0x01020304u;
 };
 
 }  // namespace structures
 
-#endif
-
-template <typename T>
-structures::ArrayList<T>::ArrayList() {
-  contents = new T[max_size_];
+template <typename T, typename P>
+structures::ArrayList<T, P>::ArrayList() {
+  max_size_ = DEFAULT_MAX;
+  contents = std::allocator<T>().allocate(max_size_);
   size_ = 0;
   last = -1;
 }
 
-template <typename T>
-structures::ArrayList<T>::ArrayList(std::size_t max_size) {
+template <typename T, typename P>
+structures::ArrayList<T, P>::ArrayList(std::size_t max_size) {
   max_size_ = max_size;
-  contents = new T[max_size_];
+  contents = std::allocator<T>().allocate(max_size_);
   size_ = 0;
   last = -1;
 }
 
-template <typename T>
-structures::ArrayList<T>::~ArrayList() {
-  delete [] contents;
+template <typename T, typename P>
+structures::ArrayList<T, P>::ArrayList(MappedFile&& mapping, std::size_t count,
+                                    bool read_only) {
+  mapping_ = std::move(mapping);
+  contents = reinterpret_cast<T*>(mapping_.data() + sizeof(FileHeader));
+  max_size_ = count;
+  size_ = count;
+  last = static_cast<int>(count) - 1;
+  read_only_ = read_only;
+}
+
+template <typename T, typename P>
+structures::ArrayList<T, P>::~ArrayList() {
+  clear();
+  if (!mapping_.is_open()) {
+    std::allocator<T>().deallocate(contents, max_size_);
+  }
+}
+
+template <typename T, typename P>
+structures::ArrayList<T, P>::ArrayList(ArrayList&& other) {
+  contents = other.contents;
+  size_ = other.size_;
+  max_size_ = other.max_size_;
+  last = other.last;
+  mapping_ = std::move(other.mapping_);
+  read_only_ = other.read_only_;
+  other.contents = nullptr;
+  other.size_ = 0;
+  other.max_size_ = 0;
+  other.last = -1;
+  other.read_only_ = false;
+}
+
+template <typename T, typename P>
+structures::ArrayList<T, P>& structures::ArrayList<T, P>::operator=(
+                                                ArrayList&& other) {
+  if (this != &other) {
+    clear();
+    if (!mapping_.is_open()) {
+      std::allocator<T>().deallocate(contents, max_size_);
+    }
+    contents = other.contents;
+    size_ = other.size_;
+    max_size_ = other.max_size_;
+    last = other.last;
+    mapping_ = std::move(other.mapping_);
+    read_only_ = other.read_only_;
+    other.contents = nullptr;
+    other.size_ = 0;
+    other.max_size_ = 0;
+    other.last = -1;
+    other.read_only_ = false;
+  }
+  return *this;
+}
+
+template <typename T, typename P>
+void structures::ArrayList<T, P>::construct(std::size_t index, const T& data) {
+  new (contents + index) T(data);
+}
+
+template <typename T, typename P>
+void structures::ArrayList<T, P>::destroy(std::size_t index) {
+  if (!std::is_trivially_destructible<T>::value) {
+    contents[index].~T();
+  }
+}
+
+template <typename T, typename P>
+void structures::ArrayList<T, P>::shift_right(std::size_t index) {
+  // a posicao size_ ainda nao foi construida: move o ultimo para la
+  new (contents + size_) T(std::move(contents[size_ - 1]));
+  for (std::size_t atual = size_ - 1; atual > index; atual--) {
+    contents[atual] = std::move(contents[atual - 1]);
+  }
+}
+
+template <typename T, typename P>
+void structures::ArrayList<T, P>::shift_left(std::size_t index) {
+  for (std::size_t atual = index; atual + 1 < size_; atual++) {
+    contents[atual] = std::move(contents[atual + 1]);
+  }
+  destroy(size_ - 1);
 }
 
-template <typename T>
-void structures::ArrayList<T>::clear() {
+template <typename T, typename P>
+void structures::ArrayList<T, P>::clear() {
+  if (!std::is_trivially_destructible<T>::value) {
+    for (std::size_t i = 0; i < size_; i++) {
+      contents[i].~T();
+    }
+  }
   size_ = 0;
   last = -1;
 }
 
-template <typename T>
-bool structures::ArrayList<T>::full() {
+template <typename T, typename P>
+bool structures::ArrayList<T, P>::full() {
   return size_ == max_size_;
 }
 
-template <typename T>
-bool structures::ArrayList<T>::empty() {
+template <typename T, typename P>
+bool structures::ArrayList<T, P>::empty() {
   return size_ == 0;
 }
 
-template <typename T>
-void structures::ArrayList<T>:: push_back(const T& data) {
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::push_back(const T& data)
+    noexcept(nothrow_copy<P, T>) {
+  if (read_only_) {
+    return P::template fail<void>(Status::READ_ONLY, "lista somente leitura");
+  }
+  if (P::checked && full()) {
+    return P::template fail<void>(Status::FULL, "Lista cheia");
+  }
+  construct(size_, data);
+  last++;
+  size_++;
+  return typename P::template result<void>();
+}
+
+template <typename T, typename P>
+structures::Status structures::ArrayList<T, P>::try_push_back(const T& data)
+    noexcept(std::is_nothrow_copy_constructible<T>::value) {
+  if (read_only_) {
+    return Status::READ_ONLY;
+  }
   if (full()) {
-    throw std::out_of_range("Lista cheia");
-  } else {
-    last++;
-    contents[last] = data;
-    size_++;
+    return Status::FULL;
   }
+  construct(size_, data);
+  last++;
+  size_++;
+  return Status::OK;
 }
 
-template <typename T>
-void structures::ArrayList<T>::remove(const T& data) {
-  if (empty()) {
-    throw std::out_of_range("Lista vazia");
-  } else {
-      if (contains(data)) {
-          pop(find(data));
-      } else {
-          throw std::out_of_range("erro posicao");
-      }
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::remove(const T& data) {
+  if (P::checked && empty()) {
+    return P::template fail<void>(Status::EMPTY, "Lista vazia");
+  }
+  std::size_t index = find(data);
+  if (index == size_) {
+    if (P::checked) {
+      return P::template fail<void>(Status::NOT_FOUND, "erro posicao");
+    }
+    return typename P::template result<void>();
   }
+  return erase_at(index);
 }
 
-template <typename T>
-void structures::ArrayList<T>::push_front(const T& data) {
-  int position;
-  if (full()) {
-    throw std::out_of_range("lista cheia");
-  } else {
-    last++;
-    size_++;
-    position = last;
-    while (position > 0) {
-      contents[position] = contents[position - 1];
-      position--;
-    }
-    contents[0] = data;
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::push_front(const T& data)
+    noexcept(nothrow_copy<P, T>) {
+  return insert(data, 0);
+}
+
+template <typename T, typename P>
+typename P::template result<T> structures::ArrayList<T, P>::pop_front()
+    noexcept(nothrow_move<P, T>) {
+  if (P::checked && empty()) {
+    return P::template fail<T>(Status::EMPTY, "lista vazia");
   }
+  return pop(0);
 }
 
-template <typename T>
-T structures::ArrayList<T>::pop_front() {
-  T value;
-  int position;
-  if (empty()) {
-    throw std::out_of_range("lista vazia");
-  } else {
+template <typename T, typename P>
+typename P::template result<T>
+structures::ArrayList<T, P>::pop(std::size_t index)
+    noexcept(nothrow_move<P, T>) {
+    if (read_only_) {
+        return P::template fail<T>(Status::READ_ONLY,
+                                   "lista somente leitura");
+    }
+    if (P::checked && index >= size_) {
+        return P::template fail<T>(Status::INVALID_INDEX, "erro posicao");
+    }
+    T value = std::move(contents[index]);
+    shift_left(index);
     last--;
     size_--;
-    value = contents[0];
-    position = 0;
-    while (position <= last) {
-      contents[position] = contents[position + 1];
-      position++;
-    }
     return value;
+}
+
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::erase_at(std::size_t index) {
+    if (read_only_) {
+        return P::template fail<void>(Status::READ_ONLY,
+                                      "lista somente leitura");
+    }
+    shift_left(index);
+    last--;
+    size_--;
+    return typename P::template result<void>();
+}
+
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::insert(const T& data, std::size_t index)
+    noexcept(nothrow_copy<P, T>) {
+  if (read_only_) {
+    return P::template fail<void>(Status::READ_ONLY, "lista somente leitura");
+  }
+  if (P::checked && full()) {
+    return P::template fail<void>(Status::FULL, "lista cheia");
+  }
+  if (P::checked && index > size_) {
+    return P::template fail<void>(Status::INVALID_INDEX,
+                                  "index com valor invalido");
   }
+  if (index == size_) {
+    construct(index, data);
+  } else {
+    shift_right(index);
+    contents[index] = data;
+  }
+  last++;
+  size_++;
+  return typename P::template result<void>();
 }
 
-template <typename T>
-T structures::ArrayList<T>::pop(std::size_t index) {
-    int atual;
-    T value;
-    if (index < 0 || index > last) {
-        throw std::out_of_range("erro posicao");
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::insert_sorted(const T& data) {
+    if (P::checked && full()) {
+        return P::template fail<void>(Status::FULL, "lista cheia");
+    }
+    int atual = 0;
+    while (atual <= last && data > contents[atual]) {
+        atual++;
+    }
+    return insert(data, atual);
+}
+
+template <typename T, typename P>
+typename P::template result<T> structures::ArrayList<T, P>::pop_back()
+    noexcept(nothrow_move<P, T>) {
+    if (read_only_) {
+        return P::template fail<T>(Status::READ_ONLY,
+                                   "lista somente leitura");
+    }
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY, "lista vazia");
+    }
+    T popContent = std::move(contents[last]);
+    destroy(last);
+    last--;
+    size_--;
+    return popContent;
+}
+
+template <typename T, typename P>
+structures::Status structures::ArrayList<T, P>::try_pop_back(T* data)
+    noexcept(std::is_nothrow_move_assignable<T>::value) {
+    if (read_only_) {
+        return Status::READ_ONLY;
+    }
+    if (empty()) {
+        return Status::EMPTY;
+    }
+    *data = std::move(contents[last]);
+    destroy(last);
+    last--;
+    size_--;
+    return Status::OK;
+}
+
+template <typename T, typename P>
+template <typename U>
+void structures::ArrayList<T, P>::place(std::size_t index, U&& data) {
+    if (index >= size_) {
+        new (contents + index) T(std::forward<U>(data));
     } else {
-        if (empty()) {
-            throw std::out_of_range("lista vazia");
+        contents[index] = std::forward<U>(data);
+    }
+}
+
+template <typename T, typename P>
+void structures::ArrayList<T, P>::truncate(std::size_t size) {
+    if (!std::is_trivially_destructible<T>::value) {
+        for (std::size_t i = size; i < size_; i++) {
+            contents[i].~T();
+        }
+    }
+    size_ = size;
+    last = static_cast<int>(size) - 1;
+}
+
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::merge(const ArrayList& other) {
+    if (read_only_) {
+        return P::template fail<void>(Status::READ_ONLY,
+                                      "lista somente leitura");
+    }
+    if (P::checked && size_ + other.size_ > max_size_) {
+        return P::template fail<void>(Status::FULL, "lista cheia");
+    }
+    // de tras para frente: o destino k nunca alcanca um dado nao lido
+    std::size_t i = size_;
+    std::size_t j = other.size_;
+    std::size_t k = size_ + other.size_;
+    while (k > i) {
+        if (i > 0 && other.contents[j - 1] < contents[i - 1]) {
+            place(--k, std::move(contents[--i]));
         } else {
-            last--;
-            size_--;
-            value = contents[index];
-            atual = index;
-            while (atual <= last) {
-                contents[atual] = contents[atual + 1];
-                atual++;
-            }
-            return value;
+            place(--k, other.contents[--j]);
         }
     }
+    size_ += other.size_;
+    last = static_cast<int>(size_) - 1;
+    return typename P::template result<void>();
 }
 
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::set_union(const ArrayList& other) {
+    if (read_only_) {
+        return P::template fail<void>(Status::READ_ONLY,
+                                      "lista somente leitura");
+    }
+    if (this == &other) {
+        return typename P::template result<void>();
+    }
+    // conta os dados de other que nao tem par aqui
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t extra = 0;
+    while (j < other.size_) {
+        if (i == size_ || other.contents[j] < contents[i]) {
+            extra++;
+            j++;
+        } else if (contents[i] < other.contents[j]) {
+            i++;
+        } else {
+            i++;
+            j++;
+        }
+    }
+    if (P::checked && size_ + extra > max_size_) {
+        return P::template fail<void>(Status::FULL, "lista cheia");
+    }
+    i = size_;
+    j = other.size_;
+    std::size_t k = size_ + extra;
+    while (k > i) {
+        if (i > 0 && other.contents[j - 1] < contents[i - 1]) {
+            place(--k, std::move(contents[--i]));
+        } else if (i > 0 && !(contents[i - 1] < other.contents[j - 1])) {
+            place(--k, std::move(contents[--i]));
+            j--;
+        } else {
+            place(--k, other.contents[--j]);
+        }
+    }
+    size_ += extra;
+    last = static_cast<int>(size_) - 1;
+    return typename P::template result<void>();
+}
 
-template <typename T>
-void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
-  int atual;
-  if (full()) {
-    throw std::out_of_range("lista cheia");
-  } else {
-    if (index < 0 || index > (last + 1)) {
-      throw std::out_of_range("index com valor invalido");
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::set_intersection(const ArrayList& other) {
+    if (read_only_) {
+        return P::template fail<void>(Status::READ_ONLY,
+                                      "lista somente leitura");
+    }
+    if (this == &other) {
+        return typename P::template result<void>();
+    }
+    std::size_t small = size_ < other.size_ ? size_ : other.size_;
+    std::size_t large = size_ < other.size_ ? other.size_ : size_;
+    if (large / GALLOP_RATIO >= small) {
+        intersect_galloping(other);
     } else {
-      last++;
-      size_++;
-      atual = last;
-      while (atual > index) {
-        contents[atual] = contents[atual - 1];
-        atual--;
-      }
-    contents[index] = data;
+        intersect_linear(other);
     }
-  }
+    return typename P::template result<void>();
 }
 
-template <typename T>
-void structures::ArrayList<T>::insert_sorted(const T& data) {
-    int atual;
-    if (full()) {
-        throw std::out_of_range("lista cheia");
-    } else {
-        atual = 0;
-        while (atual <= last && data > contents[atual]) {
-            atual++;
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayList<T, P>::set_difference(const ArrayList& other) {
+    if (read_only_) {
+        return P::template fail<void>(Status::READ_ONLY,
+                                      "lista somente leitura");
+    }
+    if (this == &other) {
+        clear();
+        return typename P::template result<void>();
+    }
+    std::size_t j = 0;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < size_; i++) {
+        while (j < other.size_ && other.contents[j] < contents[i]) {
+            j++;
+        }
+        if (j < other.size_ && !(contents[i] < other.contents[j])) {
+            j++;
+        } else {
+            if (k != i) {
+                contents[k] = std::move(contents[i]);
+            }
+            k++;
         }
-        insert(data, atual);
     }
+    truncate(k);
+    return typename P::template result<void>();
 }
 
-template <typename T>
-T structures::ArrayList<T>:: pop_back() {
-    if (empty()) {
-        throw std::out_of_range("lista vazia");
+template <typename T, typename P>
+std::size_t structures::ArrayList<T, P>::gallop(const T* contents,
+                                                std::size_t begin,
+                                                std::size_t end,
+                                                const T& data) {
+    if (begin == end || !(contents[begin] < data)) {
+        return begin;
+    }
+    // dobra o passo ate passar de data, depois busca binaria no intervalo
+    std::size_t step = 1;
+    while (begin + step < end && contents[begin + step] < data) {
+        step *= 2;
+    }
+    std::size_t low = begin + step / 2 + 1;
+    std::size_t high = begin + step < end ? begin + step : end;
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        if (contents[middle] < data) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+template <typename T, typename P>
+void structures::ArrayList<T, P>::intersect_galloping(
+                                                const ArrayList& other) {
+    std::size_t k = 0;
+    if (size_ <= other.size_) {
+        // cada dado daqui procura seu par em other
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < size_; i++) {
+            j = gallop(other.contents, j, other.size_, contents[i]);
+            if (j == other.size_) {
+                break;
+            }
+            if (!(contents[i] < other.contents[j])) {
+                if (k != i) {
+                    contents[k] = std::move(contents[i]);
+                }
+                k++;
+                j++;
+            }
+        }
     } else {
-        T popContent = contents[last];
-        last--;
-        size_--;
-        return popContent;
+        // cada dado de other procura seu par aqui
+        std::size_t i = 0;
+        for (std::size_t j = 0; j < other.size_; j++) {
+            i = gallop(contents, i, size_, other.contents[j]);
+            if (i == size_) {
+                break;
+            }
+            if (!(other.contents[j] < contents[i])) {
+                if (k != i) {
+                    contents[k] = std::move(contents[i]);
+                }
+                k++;
+                i++;
+            }
+        }
+    }
+    truncate(k);
+}
+
+template <typename T, typename P>
+void structures::ArrayList<T, P>::intersect_linear(const ArrayList& other) {
+    const T* data = other.contents;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+#if defined(__SSE2__)
+    if constexpr (std::is_integral<T>::value && sizeof(T) == 4) {
+        // compara com sinal; para sem sinal inverte o bit mais alto
+        const __m128i bias = _mm_set1_epi32(
+            std::is_signed<T>::value ? 0 : std::numeric_limits<int>::min());
+        while (i < size_ && j + 4 <= other.size_) {
+            const T value = contents[i];
+            if (data[j + 3] < value) {
+                j += 4;
+                continue;
+            }
+            // data[j + 3] >= value: o lower bound esta no bloco, e os
+            // menores que value formam um prefixo dele
+            __m128i block = _mm_xor_si128(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(data + j)), bias);
+            __m128i key = _mm_xor_si128(
+                _mm_set1_epi32(static_cast<int>(value)), bias);
+            int less = _mm_movemask_ps(
+                _mm_castsi128_ps(_mm_cmplt_epi32(block, key)));
+            j += (less & 1) + ((less >> 1) & 1) + ((less >> 2) & 1);
+            if (data[j] == value) {
+                contents[k++] = value;
+                j++;
+            }
+            i++;
+        }
     }
+#endif
+    while (i < size_ && j < other.size_) {
+        if (contents[i] < data[j]) {
+            i++;
+        } else if (data[j] < contents[i]) {
+            j++;
+        } else {
+            if (k != i) {
+                contents[k] = std::move(contents[i]);
+            }
+            k++;
+            i++;
+            j++;
+        }
+    }
+    truncate(k);
 }
 
-template <typename T>
-bool structures::ArrayList<T>:: contains(const T& data) const {
+template <typename T, typename P>
+bool structures::ArrayList<T, P>:: contains(const T& data) const {
     for (int i = 0; i <= last; i++) {
         if (contents[i] == data) {
             return 1;
@@ -247,8 +736,8 @@ bool structures::ArrayList<T>:: contains(const T& data) const {
     return 0;
 }
 
-template <typename T>
-std::size_t structures::ArrayList<T>::find(const T& data) const {
+template <typename T, typename P>
+std::size_t structures::ArrayList<T, P>::find(const T& data) const {
     int atual = 0;
     while (atual <= last && contents[atual] != data) {
         atual++;
@@ -256,26 +745,111 @@ std::size_t structures::ArrayList<T>::find(const T& data) const {
     return atual;
 }
 
-template <typename T>
-std::size_t structures::ArrayList<T>::size() const {
+template <typename T, typename P>
+std::size_t structures::ArrayList<T, P>::size() const {
     return size_;
 }
 
-template <typename T>
-std::size_t structures::ArrayList<T>::max_size() const {
+template <typename T, typename P>
+std::size_t structures::ArrayList<T, P>::max_size() const {
     return max_size_;
 }
 
-template <typename T>
-T& structures::ArrayList<T>::at(std::size_t index) {
-    if (index > last || index < 0) {
-        throw std::out_of_range("index invalido");
-    } else {
-        return contents[index];
+template <typename T, typename P>
+typename P::template result<T&>
+structures::ArrayList<T, P>::at(std::size_t index) noexcept(P::nothrow) {
+    if (P::checked && index >= size_) {
+        return P::template fail<T&>(Status::INVALID_INDEX, "index invalido");
     }
+    return contents[index];
 }
 
-template <typename T>
-T& structures::ArrayList<T>::operator[](std::size_t index) {
+template <typename T, typename P>
+T& structures::ArrayList<T, P>::operator[](std::size_t index) noexcept {
     return contents[index];
 }
+
+template <typename T, typename P>
+typename P::template result<const T&>
+structures::ArrayList<T, P>::at(std::size_t index) const
+    noexcept(P::nothrow) {
+    if (P::checked && index >= size_) {
+        return P::template fail<const T&>(Status::INVALID_INDEX,
+                                          "index invalido");
+    }
+    return contents[index];
+}
+
+template <typename T, typename P>
+const T& structures::ArrayList<T, P>::operator[](std::size_t index) const
+    noexcept {
+    return contents[index];
+}
+
+template <typename T, typename P>
+void structures::ArrayList<T, P>::save(const char* path) const {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "save exige T trivialmente copiavel");
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "EDARRAY", 8);
+    header.version = FILE_VERSION;
+    header.endianness = ENDIAN_MARK;
+    header.element_size = sizeof(T);
+    header.count = size_;
+    header.checksum = checksum(contents, size_ * sizeof(T));
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        raise_runtime_error(std::string("erro ao criar ") + path);
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && size_ > 0) {
+        ok = std::fwrite(contents, sizeof(T), size_, file) == size_;
+    }
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        raise_runtime_error(std::string("erro ao gravar ") + path);
+    }
+}
+
+template <typename T, typename P>
+structures::ArrayList<T, P> structures::ArrayList<T, P>::open_mapped(
+                                                const char* path,
+                                                bool copy_on_write,
+                                                bool verify) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "open_mapped exige T trivialmente copiavel");
+    static_assert(alignof(T) <= sizeof(FileHeader),
+                  "alinhamento de T maior que o cabecalho");
+    MappedFile mapping;
+    mapping.open(path, copy_on_write);
+    if (mapping.size() < sizeof(FileHeader)) {
+        raise_runtime_error(std::string("arquivo truncado ") + path);
+    }
+    FileHeader header;
+    std::memcpy(&header, mapping.data(), sizeof(header));
+    if (std::memcmp(header.magic, "EDARRAY", 8) != 0 ||
+        header.version != FILE_VERSION) {
+        raise_runtime_error(std::string("formato invalido ") + path);
+    }
+    if (header.endianness != ENDIAN_MARK) {
+        raise_runtime_error(std::string("endianness diferente ") + path);
+    }
+    // count vem do arquivo: compara por divisao para nao estourar, e
+    // last e' int
+    std::size_t capacity = (mapping.size() - sizeof(FileHeader)) / sizeof(T);
+    if (header.element_size != sizeof(T) || header.count > capacity ||
+        header.count > static_cast<std::uint64_t>(
+                           std::numeric_limits<int>::max()) ||
+        mapping.size() != sizeof(FileHeader) + header.count * sizeof(T)) {
+        raise_runtime_error(std::string("tamanho invalido ") + path);
+    }
+    if (verify && checksum(mapping.data() + sizeof(FileHeader),
+                           header.count * sizeof(T)) != header.checksum) {
+        raise_runtime_error(std::string("checksum invalido ") + path);
+    }
+    return ArrayList(std::move(mapping), header.count, !copy_on_write);
+}
+
+#endif
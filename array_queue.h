@@ -2,27 +2,65 @@
 #ifndef STRUCTURES_ARRAY_QUEUE_H
 #define STRUCTURES_ARRAY_QUEUE_H
 
+#include <sys/types.h>
+#include <sys/uio.h>  // readv, writev
+
 #include <cstdint>  // std::size_t
+#include <memory>  // std::allocator
+#include <new>  // placement new
 #include <stdexcept>  // C++ Exceptions
+#include <type_traits>
+#include <utility>
+
+#include "./error_policy.h"
+#include "./mirrored_buffer.h"
 
 namespace structures {
 
-template<typename T>
+template<typename T, typename Policy = ThrowPolicy>
 //! classe ArrayQueue
+/*!
+ *  Policy decide o que acontece com fila cheia/vazia (veja
+ *  error_policy.h); try_enqueue e try_dequeue nunca lancam.
+ */
 class ArrayQueue {
  public:
+    //! retorno de uma operacao que devolveria R, conforme Policy
+    template<typename R>
+    using Result = typename Policy::template result<R>;
+
+    //! trecho contiguo do buffer
+    struct Span {
+        T* data;
+        std::size_t size;
+    };
+
     //! construtor padrao
     ArrayQueue();
     //! construtor com parametro
     explicit ArrayQueue(std::size_t max);
+    //! construtor com buffer espelhado (T trivial)
+    /*!
+     *  Com mirrored, a capacidade e' arredondada para paginas inteiras e
+     *  o buffer e' mapeado duas vezes em sequencia: readable_spans e
+     *  writable_spans devolvem sempre um unico trecho. Se o espelhamento
+     *  nao for possivel a fila usa um buffer comum (veja mirrored()).
+     */
+    ArrayQueue(std::size_t max, bool mirrored);
     //! destrutor padrao
     ~ArrayQueue();
     //! metodo enfileirar
-    void enqueue(const T& data);
+    Result<void> enqueue(const T& data) noexcept(nothrow_copy<Policy, T>);
     //! metodo desenfileirar
-    T dequeue();
+    Result<T> dequeue() noexcept(nothrow_move<Policy, T>);
     //! metodo retorna o ultimo
-    T& back();
+    Result<T&> back() noexcept(Policy::nothrow);
+    //! enfileira sem lancar; Status::FULL se cheia
+    Status try_enqueue(const T& data)
+        noexcept(std::is_nothrow_copy_constructible<T>::value);
+    //! desenfileira em *data sem lancar; Status::EMPTY se vazia
+    Status try_dequeue(T* data)
+        noexcept(std::is_nothrow_move_assignable<T>::value);
     //! metodo limpa a fila
     void clear();
     //! metodo retorna tamanho atual
@@ -33,99 +71,296 @@ class ArrayQueue {
     bool empty();
     //! metodo verifica se esta cheio
     bool full();
+    //! verifica se o buffer e' espelhado
+    bool mirrored() const;
+    //! ate dois trechos contiguos com os dados, na ordem da fila
+    std::pair<Span, Span> readable_spans();
+    //! ate dois trechos contiguos livres apos o fim (T trivial)
+    std::pair<Span, Span> writable_spans();
+    //! anexa n elementos ja escritos em writable_spans()
+    Result<void> commit_write(std::size_t n) noexcept(Policy::nothrow);
+    //! descarta n elementos do inicio
+    Result<void> consume(std::size_t n) noexcept(Policy::nothrow);
+    //! le do descritor direto no espaco livre (readv, sem copia extra)
+    /*!
+     *  Devolve o retorno de readv: bytes lidos, 0 no fim do arquivo ou -1
+     *  com errno (EAGAIN em descritor nao bloqueante). Falha com
+     *  Status::FULL se a fila estiver cheia.
+     */
+    Result<ssize_t> read_from_fd(int fd) noexcept(Policy::nothrow);
+    //! escreve os dados no descritor (writev) e consome o que foi escrito
+    /*!
+     *  Devolve o retorno de writev (bytes escritos ou -1 com errno). Falha
+     *  com Status::EMPTY se a fila estiver vazia, como read_from_fd.
+     */
+    Result<ssize_t> write_to_fd(int fd) noexcept(Policy::nothrow);
 
  private:
+    //! converte os trechos em iovec; devolve quantos nao sao vazios
+    static int to_iovec(const std::pair<Span, Span>& spans, iovec* vector);
+
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
     int start_;
     int end_;
+    MirroredBuffer mirror_;
 
     static const auto DEFAULT_SIZE = 10u;
 };
 
 }  // namespace structures
 
-#endif
+template <typename T, typename P>
+structures::ArrayQueue<T, P>::ArrayQueue() {
+    max_size_ = DEFAULT_SIZE;
+    contents = std::allocator<T>().allocate(max_size_);
+    size_ = 0;
+    start_ = 0;
+    end_ = -1;
+}
 
-template <typename T>
-structures::ArrayQueue<T>::ArrayQueue() {
-    contents = new T[max_size_];
+template <typename T, typename P>
+structures::ArrayQueue<T, P>::ArrayQueue(std::size_t max) {
+    max_size_ = max;
+    contents = std::allocator<T>().allocate(max_size_);
     size_ = 0;
     start_ = 0;
     end_ = -1;
 }
 
-template <typename T>
-structures::ArrayQueue<T>::ArrayQueue(std::size_t max) {
+template <typename T, typename P>
+structures::ArrayQueue<T, P>::ArrayQueue(std::size_t max, bool mirrored) {
     max_size_ = max;
-    contents = new T[max];
+    if (mirrored && std::is_trivially_copyable<T>::value &&
+        MirroredBuffer::page_size() % sizeof(T) == 0 &&
+        mirror_.allocate(max * sizeof(T))) {
+        max_size_ = mirror_.size() / sizeof(T);
+        contents = reinterpret_cast<T*>(mirror_.data());
+    } else {
+        contents = std::allocator<T>().allocate(max_size_);
+    }
     size_ = 0;
     start_ = 0;
     end_ = -1;
 }
 
-template <typename T>
-structures::ArrayQueue<T>::~ArrayQueue() {
-    delete [] contents;
+template <typename T, typename P>
+structures::ArrayQueue<T, P>::~ArrayQueue() {
+    clear();
+    if (!mirror_.is_open()) {
+        std::allocator<T>().deallocate(contents, max_size_);
+    }
 }
 
-template <typename T>
-void structures::ArrayQueue<T>:: enqueue(const T& data) {
-    if (full()) {
-        throw std::out_of_range("Fila cheia");
-    } else {
-        end_ = (end_+1) % max_size_;
-        contents[end_] = data;
-        size_++;
+template <typename T, typename P>
+typename P::template result<void>
+structures::ArrayQueue<T, P>::enqueue(const T& data)
+    noexcept(nothrow_copy<P, T>) {
+    if (P::checked && full()) {
+        return P::template fail<void>(Status::FULL, "Fila cheia");
     }
+    end_ = (end_+1) % max_size_;
+    new (contents + end_) T(data);
+    size_++;
+    return typename P::template result<void>();
 }
 
-template <typename T>
-T structures::ArrayQueue<T>:: dequeue() {
-    if (empty()) {
-        throw std::out_of_range("Fila vazia");
-    } else {
-        int data = contents[start_];
-        start_ = (start_+1) % max_size_;
-        size_--;
-        return data;
+template <typename T, typename P>
+typename P::template result<T> structures::ArrayQueue<T, P>::dequeue()
+    noexcept(nothrow_move<P, T>) {
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY, "Fila vazia");
+    }
+    T data = std::move(contents[start_]);
+    if (!std::is_trivially_destructible<T>::value) {
+        contents[start_].~T();
     }
+    start_ = (start_+1) % max_size_;
+    size_--;
+    return data;
 }
 
-template <typename T>
-T& structures::ArrayQueue<T>:: back() {
+template <typename T, typename P>
+typename P::template result<T&> structures::ArrayQueue<T, P>::back()
+    noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<T&>(Status::EMPTY, "fila vazia");
+    }
+    return contents[end_];
+}
+
+template <typename T, typename P>
+structures::Status structures::ArrayQueue<T, P>::try_enqueue(const T& data)
+    noexcept(std::is_nothrow_copy_constructible<T>::value) {
+    if (full()) {
+        return Status::FULL;
+    }
+    end_ = (end_+1) % max_size_;
+    new (contents + end_) T(data);
+    size_++;
+    return Status::OK;
+}
+
+template <typename T, typename P>
+structures::Status structures::ArrayQueue<T, P>::try_dequeue(T* data)
+    noexcept(std::is_nothrow_move_assignable<T>::value) {
     if (empty()) {
-        throw std::out_of_range("fila vazia");
-    } else {
-        return contents[end_];
+        return Status::EMPTY;
     }
+    *data = std::move(contents[start_]);
+    if (!std::is_trivially_destructible<T>::value) {
+        contents[start_].~T();
+    }
+    start_ = (start_+1) % max_size_;
+    size_--;
+    return Status::OK;
 }
 
-template <typename T>
-void structures::ArrayQueue<T>:: clear() {
+template <typename T, typename P>
+void structures::ArrayQueue<T, P>:: clear() {
+    if (!std::is_trivially_destructible<T>::value) {
+        for (std::size_t i = 0; i < size_; i++) {
+            contents[(start_ + i) % max_size_].~T();
+        }
+    }
     end_ = -1;
     size_ = 0;
     start_ = 0;
 }
 
-template <typename T>
-std::size_t structures::ArrayQueue<T>::size() {
+template <typename T, typename P>
+std::size_t structures::ArrayQueue<T, P>::size() {
     return size_;
 }
 
-template <typename T>
-std::size_t structures::ArrayQueue<T>::max_size() {
+template <typename T, typename P>
+std::size_t structures::ArrayQueue<T, P>::max_size() {
     return max_size_;
 }
 
 
-template<typename T>
-bool structures::ArrayQueue<T>::empty() {
+template<typename T, typename P>
+bool structures::ArrayQueue<T, P>::empty() {
     return size_ == 0;
 }
 
-template<typename T>
-bool structures::ArrayQueue<T>::full() {
+template<typename T, typename P>
+bool structures::ArrayQueue<T, P>::full() {
         return (size_ == max_size_);
 }
+
+template<typename T, typename P>
+bool structures::ArrayQueue<T, P>::mirrored() const {
+    return mirror_.is_open();
+}
+
+template<typename T, typename P>
+std::pair<typename structures::ArrayQueue<T, P>::Span,
+          typename structures::ArrayQueue<T, P>::Span>
+structures::ArrayQueue<T, P>::readable_spans() {
+    std::size_t first = max_size_ - start_;
+    if (first > size_ || mirrored()) {
+        first = size_;
+    }
+    return std::make_pair(Span{contents + start_, first},
+                          Span{contents, size_ - first});
+}
+
+template<typename T, typename P>
+std::pair<typename structures::ArrayQueue<T, P>::Span,
+          typename structures::ArrayQueue<T, P>::Span>
+structures::ArrayQueue<T, P>::writable_spans() {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "escrita direta exige T trivial");
+    std::size_t free = max_size_ - size_;
+    std::size_t write = (start_ + size_) % max_size_;
+    std::size_t first = max_size_ - write;
+    if (first > free || mirrored()) {
+        first = free;
+    }
+    return std::make_pair(Span{contents + write, first},
+                          Span{contents, free - first});
+}
+
+template<typename T, typename P>
+typename P::template result<void>
+structures::ArrayQueue<T, P>::commit_write(std::size_t n) noexcept(P::nothrow) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "escrita direta exige T trivial");
+    if (P::checked && n > max_size_ - size_) {
+        return P::template fail<void>(Status::FULL, "Fila cheia");
+    }
+    size_ += n;
+    if (size_ > 0) {
+        end_ = static_cast<int>((start_ + size_ - 1) % max_size_);
+    }
+    return typename P::template result<void>();
+}
+
+template<typename T, typename P>
+typename P::template result<void>
+structures::ArrayQueue<T, P>::consume(std::size_t n) noexcept(P::nothrow) {
+    if (P::checked && n > size_) {
+        return P::template fail<void>(Status::EMPTY, "Fila vazia");
+    }
+    if (!std::is_trivially_destructible<T>::value) {
+        for (std::size_t i = 0; i < n; i++) {
+            contents[(start_ + i) % max_size_].~T();
+        }
+    }
+    start_ = static_cast<int>((start_ + n) % max_size_);
+    size_ -= n;
+    return typename P::template result<void>();
+}
+
+template<typename T, typename P>
+int structures::ArrayQueue<T, P>::to_iovec(const std::pair<Span, Span>& spans,
+                                        iovec* vector) {
+    int count = 0;
+    if (spans.first.size > 0) {
+        vector[count].iov_base = spans.first.data;
+        vector[count].iov_len = spans.first.size * sizeof(T);
+        count++;
+    }
+    if (spans.second.size > 0) {
+        vector[count].iov_base = spans.second.data;
+        vector[count].iov_len = spans.second.size * sizeof(T);
+        count++;
+    }
+    return count;
+}
+
+template<typename T, typename P>
+typename P::template result<ssize_t>
+structures::ArrayQueue<T, P>::read_from_fd(int fd) noexcept(P::nothrow) {
+    static_assert(sizeof(T) == 1, "E/S direta exige ArrayQueue de bytes");
+    if (P::checked && full()) {
+        return P::template fail<ssize_t>(Status::FULL, "Fila cheia");
+    }
+    iovec vector[2];
+    int count = to_iovec(writable_spans(), vector);
+    ssize_t result = ::readv(fd, vector, count);
+    if (result > 0) {
+        commit_write(static_cast<std::size_t>(result));
+    }
+    return result;
+}
+
+template<typename T, typename P>
+typename P::template result<ssize_t>
+structures::ArrayQueue<T, P>::write_to_fd(int fd) noexcept(P::nothrow) {
+    static_assert(sizeof(T) == 1, "E/S direta exige ArrayQueue de bytes");
+    if (P::checked && empty()) {
+        return P::template fail<ssize_t>(Status::EMPTY, "Fila vazia");
+    }
+    iovec vector[2];
+    int count = to_iovec(readable_spans(), vector);
+    ssize_t result = ::writev(fd, vector, count);
+    if (result > 0) {
+        consume(static_cast<std::size_t>(result));
+    }
+    return result;
+}
+
+#endif
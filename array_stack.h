@@ -3,14 +3,28 @@
 #define STRUCTURES_ARRAY_STACK_H
 
 #include <cstdint>  // std::size_t
+#include <memory>  // std::allocator
+#include <new>  // placement new
 #include <stdexcept>  // C++ exceptions
+#include <type_traits>
+#include <utility>
+
+#include "./error_policy.h"
 
 namespace structures {
 
-template<typename T>
+template<typename T, typename Policy = ThrowPolicy>
 //! CLASSE PILHA
+/*!
+ *  Policy decide o que acontece com pilha cheia/vazia (veja
+ *  error_policy.h); try_push e try_pop nunca lancam.
+ */
 class ArrayStack {
  public:
+    //! retorno de uma operacao que devolveria R, conforme Policy
+    template<typename R>
+    using Result = typename Policy::template result<R>;
+
     //! construtor simples
     ArrayStack();
     //! construtor com parametro tamanho
@@ -18,11 +32,17 @@ class ArrayStack {
     //! destrutor
     ~ArrayStack();
     //! metodo empilha
-    void push(const T& data);
+    Result<void> push(const T& data) noexcept(nothrow_copy<Policy, T>);
     //! metodo desempilha
-    T pop();
+    Result<T> pop() noexcept(nothrow_move<Policy, T>);
     //! metodo retorna o topo
-    T& top();
+    Result<T&> top() noexcept(Policy::nothrow);
+    //! empilha sem lancar; Status::FULL se cheia
+    Status try_push(const T& data)
+        noexcept(std::is_nothrow_copy_constructible<T>::value);
+    //! desempilha em *data sem lancar; Status::EMPTY se vazia
+    Status try_pop(T* data)
+        noexcept(std::is_nothrow_move_assignable<T>::value);
     //! metodo limpa pilha
     void clear();
     //! metodo retorna tamanho
@@ -44,87 +64,120 @@ class ArrayStack {
 
 }  // namespace structures
 
-#endif
 
-
-template<typename T>
-structures::ArrayStack<T>::ArrayStack() {
+template<typename T, typename P>
+structures::ArrayStack<T, P>::ArrayStack() {
     max_size_ = DEFAULT_SIZE;
-    contents = new T[max_size_];
+    contents = std::allocator<T>().allocate(max_size_);
     top_ = -1;
 }
 
-template<typename T>
-structures::ArrayStack<T>::ArrayStack(std::size_t max) {
+template<typename T, typename P>
+structures::ArrayStack<T, P>::ArrayStack(std::size_t max) {
     // COLOQUE SEU CODIGO AQUI...
     max_size_ = max;
-    contents = new T[max_size_];
+    contents = std::allocator<T>().allocate(max_size_);
     top_ = -1;
 }
 
-template<typename T>
-structures::ArrayStack<T>::~ArrayStack() {
-    delete [] contents;
+template<typename T, typename P>
+structures::ArrayStack<T, P>::~ArrayStack() {
+    clear();
+    std::allocator<T>().deallocate(contents, max_size_);
 }
 
-template<typename T>
-void structures::ArrayStack<T>::push(const T& data) {
-    if (full()) {
-        throw std::out_of_range("pilha cheia");
-    } else {
-        // COLOQUE SEU CODIGO AQUI...
-        top_ += 1;
-        contents[top_] = data;
+template<typename T, typename P>
+typename P::template result<void>
+structures::ArrayStack<T, P>::push(const T& data) noexcept(nothrow_copy<P, T>) {
+    if (P::checked && full()) {
+        return P::template fail<void>(Status::FULL, "pilha cheia");
     }
+    new (contents + top_ + 1) T(data);
+    top_ += 1;
+    return typename P::template result<void>();
 }
 
-template<typename T>
-T structures::ArrayStack<T>::pop() {
-    // COLOQUE SEU CODIGO AQUI...
-    if (empty()) {
-        throw std::out_of_range("pilha vazia");
-    } else {
-        top_ -= 1;
-        return contents[(top_+1)];
+template<typename T, typename P>
+typename P::template result<T> structures::ArrayStack<T, P>::pop()
+    noexcept(nothrow_move<P, T>) {
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY, "pilha vazia");
+    }
+    T data = std::move(contents[top_]);
+    if (!std::is_trivially_destructible<T>::value) {
+        contents[top_].~T();
     }
+    top_ -= 1;
+    return data;
 }
 
-template<typename T>
-T& structures::ArrayStack<T>::top() {
-    // COLOQUE SEU CODIGO AQUI...
+template<typename T, typename P>
+typename P::template result<T&> structures::ArrayStack<T, P>::top()
+    noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<T&>(Status::EMPTY, "pilha vazia");
+    }
+    return contents[top_];
+}
+
+template<typename T, typename P>
+structures::Status structures::ArrayStack<T, P>::try_push(const T& data)
+    noexcept(std::is_nothrow_copy_constructible<T>::value) {
+    if (full()) {
+        return Status::FULL;
+    }
+    new (contents + top_ + 1) T(data);
+    top_ += 1;
+    return Status::OK;
+}
+
+template<typename T, typename P>
+structures::Status structures::ArrayStack<T, P>::try_pop(T* data)
+    noexcept(std::is_nothrow_move_assignable<T>::value) {
     if (empty()) {
-        throw std::out_of_range("pilha vazia");
-    } else {
-        return contents[top_];
+        return Status::EMPTY;
+    }
+    *data = std::move(contents[top_]);
+    if (!std::is_trivially_destructible<T>::value) {
+        contents[top_].~T();
     }
+    top_ -= 1;
+    return Status::OK;
 }
 
-template<typename T>
-void structures::ArrayStack<T>::clear() {
+template<typename T, typename P>
+void structures::ArrayStack<T, P>::clear() {
     // COLOQUE SEU CODIGO AQUI...
+    if (!std::is_trivially_destructible<T>::value) {
+        for (int i = 0; i <= top_; i++) {
+            contents[i].~T();
+        }
+    }
     top_ = -1;
 }
 
-template<typename T>
-std::size_t structures::ArrayStack<T>::size() {
+template<typename T, typename P>
+std::size_t structures::ArrayStack<T, P>::size() {
     // COLOQUE SEU CODIGO AQUI...
     return (top_+1);
 }
 
-template<typename T>
-std::size_t structures::ArrayStack<T>::max_size() {
+template<typename T, typename P>
+std::size_t structures::ArrayStack<T, P>::max_size() {
     // COLOQUE SEU CODIGO AQUI...
     return max_size_;
 }
 
-template<typename T>
-bool structures::ArrayStack<T>::empty() {
+template<typename T, typename P>
+bool structures::ArrayStack<T, P>::empty() {
     // COLOQUE SEU CODIGO AQUI...
     return top_== -1;
 }
 
-template<typename T>
-bool structures::ArrayStack<T>::full() {
+template<typename T, typename P>
+bool structures::ArrayStack<T, P>::full() {
     // COLOQUE SEU CODIGO AQUI...
     return (top_ + 1)== max_size_;
 }
+
+#endif
@@ -0,0 +1,406 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_ASYNC_QUEUE_H
+#define STRUCTURES_ASYNC_QUEUE_H
+
+#include <coroutine>  // C++20
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "./intrusive_doubly_linked_list.h"
+#include "./linked_queue.h"
+
+namespace structures {
+
+//! Cancelamento de uma espera em AsyncQueue
+/*!
+ *  Passado para dequeue/enqueue; cancel() retoma a corrotina que estiver
+ *  esperando com ele (dequeue devolve vazio, enqueue devolve false). Uma
+ *  espera iniciada com token ja cancelado nem chega a suspender.
+ */
+class CancelToken {
+ public:
+    //! construtor padrão
+    CancelToken() {}
+    //! cancela a espera atual e as futuras
+    void cancel() {
+        cancelled_ = true;
+        if (callback_ != nullptr) {
+            void (*callback)(void*) = callback_;
+            callback_ = nullptr;
+            callback(context_);
+        }
+    }
+    //! verifica se foi cancelado
+    bool cancelled() const {
+        return cancelled_;
+    }
+
+ private:
+    template<typename T> friend class AsyncQueue;
+    CancelToken(const CancelToken&) = delete;
+    CancelToken& operator=(const CancelToken&) = delete;
+
+    void (*callback_)(void*){nullptr};
+    void* context_{nullptr};
+    bool cancelled_{false};
+};
+
+template<typename T>
+//! Classe fila assincrona para corrotinas (C++20)
+/*!
+ *  co_await dequeue() suspende a corrotina enquanto a fila estiver vazia,
+ *  sem bloquear a thread; com max_size > 0, co_await enqueue(x) suspende
+ *  enquanto a fila estiver cheia. Um dado enfileirado com consumidor
+ *  esperando vai direto para ele. As corrotinas acordadas por uma operacao
+ *  sao retomadas juntas no fim dela, pelo executor (ou na hora, se nao
+ *  houver executor). Nao e' sincronizado: use de uma thread so, p.ex. com
+ *  EventLoop.
+ */
+class AsyncQueue {
+ public:
+    //! quem retoma corrotinas acordadas
+    using Executor = std::function<void(std::coroutine_handle<>)>;
+
+    //! espera de um consumidor ou produtor (vive no frame da corrotina)
+    struct Waiter {
+        ListHook hook;
+        AsyncQueue* queue;
+        CancelToken* token;
+        std::coroutine_handle<> handle;
+        std::optional<T> value;  // dado recebido / a entregar
+        bool done{false};  // operacao concluida por outra corrotina
+    };
+
+    //! awaiter de dequeue: resulta no dado, ou vazio se fechada/cancelada
+    class DequeueAwaiter : private Waiter {
+     public:
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> handle);
+        std::optional<T> await_resume();
+
+     private:
+        friend class AsyncQueue;
+        DequeueAwaiter(AsyncQueue* queue, CancelToken* token);
+    };
+
+    //! awaiter de enqueue: resulta em false se fechada/cancelada
+    class EnqueueAwaiter : private Waiter {
+     public:
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> handle);
+        bool await_resume();
+
+     private:
+        friend class AsyncQueue;
+        EnqueueAwaiter(AsyncQueue* queue, T data, CancelToken* token);
+    };
+
+    //! construtor (max_size 0 = sem limite)
+    explicit AsyncQueue(std::size_t max_size = 0, Executor executor = {});
+    //! destrutor (nao pode haver corrotinas esperando)
+    ~AsyncQueue();
+    //! espera um dado
+    DequeueAwaiter dequeue(CancelToken* token = nullptr);
+    //! enfileira, esperando espaco se a fila for limitada
+    EnqueueAwaiter enqueue(T data, CancelToken* token = nullptr);
+    //! enfileira sem esperar; false se cheia ou fechada
+    bool try_enqueue(T data);
+    //! enfileira [first, last) sem esperar, acordando os consumidores de
+    //! uma vez; devolve quantos couberam
+    template<typename Iterator>
+    std::size_t try_enqueue_all(Iterator first, Iterator last);
+    //! desenfileira sem esperar
+    std::optional<T> try_dequeue();
+    //! fecha: acorda todos; dados restantes ainda podem ser lidos
+    void close();
+    //! verifica se esta fechada
+    bool closed() const;
+    //! dados na fila
+    std::size_t size() const;
+    //! fila vazia
+    bool empty() const;
+    //! limite (0 = sem limite)
+    std::size_t max_size() const;
+    //! consumidores esperando
+    std::size_t waiting_consumers() const;
+    //! produtores esperando
+    std::size_t waiting_producers() const;
+
+ private:
+    using Waiters = IntrusiveDoublyLinkedList<Waiter, &Waiter::hook>;
+
+    AsyncQueue(const AsyncQueue&) = delete;
+    AsyncQueue& operator=(const AsyncQueue&) = delete;
+    //! entrega data a um consumidor esperando ou a fila; false se cheia
+    bool give(T* data);
+    //! tira um dado (repondo com um produtor esperando); vazio se nao ha
+    std::optional<T> take();
+    //! suspende waiter na lista, ligando o token
+    void park(Waiter* waiter, Waiters* list, std::coroutine_handle<> handle);
+    //! marca waiter como pronto para ser retomado no proximo flush
+    void wake(Waiter* waiter);
+    //! retoma (ou entrega ao executor) todas as corrotinas acordadas
+    void flush();
+    //! callback do CancelToken
+    static void cancel(void* context);
+
+    LinkedQueue<T> items_;
+    Waiters consumers_;
+    Waiters producers_;
+    std::vector<std::coroutine_handle<>> woken_;
+    Executor executor_;
+    std::size_t max_size_;
+    bool closed_{false};
+    bool flushing_{false};
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::AsyncQueue<T>::DequeueAwaiter::DequeueAwaiter(
+                                    AsyncQueue* queue, CancelToken* token) {
+    this->queue = queue;
+    this->token = token;
+}
+
+template<typename T>
+bool structures::AsyncQueue<T>::DequeueAwaiter::await_ready() {
+    if (this->token != nullptr && this->token->cancelled()) {
+        return true;
+    }
+    this->value = this->queue->take();
+    this->done = this->value.has_value() || this->queue->closed_;
+    this->queue->flush();
+    return this->done;
+}
+
+template<typename T>
+void structures::AsyncQueue<T>::DequeueAwaiter::await_suspend(
+                                        std::coroutine_handle<> handle) {
+    this->queue->park(this, &this->queue->consumers_, handle);
+}
+
+template<typename T>
+std::optional<T> structures::AsyncQueue<T>::DequeueAwaiter::await_resume() {
+    return std::move(this->value);
+}
+
+template<typename T>
+structures::AsyncQueue<T>::EnqueueAwaiter::EnqueueAwaiter(
+                            AsyncQueue* queue, T data, CancelToken* token) {
+    this->queue = queue;
+    this->token = token;
+    this->value.emplace(std::move(data));
+}
+
+template<typename T>
+bool structures::AsyncQueue<T>::EnqueueAwaiter::await_ready() {
+    if (this->token != nullptr && this->token->cancelled()) {
+        return true;
+    }
+    if (this->queue->closed_) {
+        return true;
+    }
+    this->done = this->queue->give(&*this->value);
+    this->queue->flush();
+    return this->done;
+}
+
+template<typename T>
+void structures::AsyncQueue<T>::EnqueueAwaiter::await_suspend(
+                                        std::coroutine_handle<> handle) {
+    this->queue->park(this, &this->queue->producers_, handle);
+}
+
+template<typename T>
+bool structures::AsyncQueue<T>::EnqueueAwaiter::await_resume() {
+    return this->done;
+}
+
+template<typename T>
+structures::AsyncQueue<T>::AsyncQueue(std::size_t max_size,
+                                      Executor executor):
+    executor_{std::move(executor)},
+    max_size_{max_size}
+{}
+
+template<typename T>
+structures::AsyncQueue<T>::~AsyncQueue() {}
+
+template<typename T>
+typename structures::AsyncQueue<T>::DequeueAwaiter
+structures::AsyncQueue<T>::dequeue(CancelToken* token) {
+    return DequeueAwaiter(this, token);
+}
+
+template<typename T>
+typename structures::AsyncQueue<T>::EnqueueAwaiter
+structures::AsyncQueue<T>::enqueue(T data, CancelToken* token) {
+    return EnqueueAwaiter(this, std::move(data), token);
+}
+
+template<typename T>
+bool structures::AsyncQueue<T>::give(T* data) {
+    if (!consumers_.empty()) {
+        // consumidor esperando implica fila vazia: entrega direto
+        Waiter& consumer = consumers_.pop_front();
+        consumer.value.emplace(std::move(*data));
+        wake(&consumer);
+        return true;
+    }
+    if (max_size_ != 0 && items_.size() >= max_size_) {
+        return false;
+    }
+    items_.enqueue(std::move(*data));
+    return true;
+}
+
+template<typename T>
+std::optional<T> structures::AsyncQueue<T>::take() {
+    if (items_.empty()) {
+        return std::nullopt;
+    }
+    std::optional<T> data(items_.dequeue());
+    if (!producers_.empty()) {
+        Waiter& producer = producers_.pop_front();
+        items_.enqueue(std::move(*producer.value));
+        wake(&producer);
+    }
+    return data;
+}
+
+template<typename T>
+void structures::AsyncQueue<T>::park(Waiter* waiter, Waiters* list,
+                                     std::coroutine_handle<> handle) {
+    waiter->handle = handle;
+    list->push_back(*waiter);
+    if (waiter->token != nullptr) {
+        waiter->token->callback_ = &AsyncQueue::cancel;
+        waiter->token->context_ = waiter;
+    }
+}
+
+template<typename T>
+void structures::AsyncQueue<T>::wake(Waiter* waiter) {
+    waiter->done = true;
+    if (waiter->token != nullptr) {
+        waiter->token->callback_ = nullptr;
+    }
+    woken_.push_back(waiter->handle);
+}
+
+template<typename T>
+void structures::AsyncQueue<T>::flush() {
+    // uma retomada na hora pode voltar aqui: so o primeiro flush drena
+    if (flushing_) {
+        return;
+    }
+    flushing_ = true;
+    for (std::size_t i = 0; i < woken_.size(); i++) {
+        std::coroutine_handle<> handle = woken_[i];
+        if (executor_) {
+            executor_(handle);
+        } else {
+            handle.resume();
+        }
+    }
+    woken_.clear();
+    flushing_ = false;
+}
+
+template<typename T>
+void structures::AsyncQueue<T>::cancel(void* context) {
+    Waiter* waiter = static_cast<Waiter*>(context);
+    AsyncQueue* queue = waiter->queue;
+    // so produtores esperam segurando um dado
+    if (waiter->value.has_value()) {
+        queue->producers_.erase(*waiter);
+    } else {
+        queue->consumers_.erase(*waiter);
+    }
+    waiter->token = nullptr;
+    waiter->done = false;
+    queue->woken_.push_back(waiter->handle);
+    queue->flush();
+}
+
+template<typename T>
+bool structures::AsyncQueue<T>::try_enqueue(T data) {
+    if (closed_ || !give(&data)) {
+        return false;
+    }
+    flush();
+    return true;
+}
+
+template<typename T>
+template<typename Iterator>
+std::size_t structures::AsyncQueue<T>::try_enqueue_all(Iterator first,
+                                                       Iterator last) {
+    std::size_t count = 0;
+    for (; !closed_ && first != last; ++first) {
+        T data(*first);
+        if (!give(&data)) {
+            break;
+        }
+        count++;
+    }
+    flush();
+    return count;
+}
+
+template<typename T>
+std::optional<T> structures::AsyncQueue<T>::try_dequeue() {
+    std::optional<T> data = take();
+    flush();
+    return data;
+}
+
+template<typename T>
+void structures::AsyncQueue<T>::close() {
+    closed_ = true;
+    while (!consumers_.empty()) {
+        wake(&consumers_.pop_front());
+    }
+    while (!producers_.empty()) {
+        Waiter& producer = producers_.pop_front();
+        wake(&producer);
+        producer.done = false;
+    }
+    flush();
+}
+
+template<typename T>
+bool structures::AsyncQueue<T>::closed() const {
+    return closed_;
+}
+
+template<typename T>
+std::size_t structures::AsyncQueue<T>::size() const {
+    return items_.size();
+}
+
+template<typename T>
+bool structures::AsyncQueue<T>::empty() const {
+    return items_.empty();
+}
+
+template<typename T>
+std::size_t structures::AsyncQueue<T>::max_size() const {
+    return max_size_;
+}
+
+template<typename T>
+std::size_t structures::AsyncQueue<T>::waiting_consumers() const {
+    return consumers_.size();
+}
+
+template<typename T>
+std::size_t structures::AsyncQueue<T>::waiting_producers() const {
+    return producers_.size();
+}
+
+#endif
@@ -0,0 +1,524 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_BURST_TRIE_H
+#define STRUCTURES_BURST_TRIE_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+//! Classe de trie com estouro (burst trie) de strings ordenadas
+/*!
+ *  Alternativa a ArrayListString::insert_sorted para dicionarios grandes.
+ *  As folhas sao recipientes: um buffer contiguo com os sufixos em ordem,
+ *  cada um como [uint16 tamanho][uint32 ocorrencias][bytes]. Quando um
+ *  recipiente passa do limite ele estoura num nodo de 256 filhos,
+ *  distribuindo os sufixos pelo primeiro byte. Busca e insercao custam a
+ *  descida pelos nodos mais uma varredura sequencial de um recipiente
+ *  pequeno; cada nodo guarda o total da subarvore, o que da find (posicao
+ *  na ordem) e at sem percorrer tudo. Repeticoes sao contadas, como na
+ *  lista.
+ */
+class BurstTrie {
+ public:
+    //! construtor padrão
+    BurstTrie();
+    //! destrutor
+    ~BurstTrie();
+    //! limpa a trie
+    void clear();
+    //! insere em ordem (repeticoes permitidas)
+    void insert_sorted(const char *data);
+    //! insere em ordem (repeticoes permitidas)
+    void insert_sorted(std::string_view data);
+    //! verifica se ha dado x
+    bool contains(std::string_view data) const;
+    //! posicao da primeira ocorrencia na ordem, ou size()
+    std::size_t find(std::string_view data) const;
+    //! remove uma ocorrencia; false se nao havia
+    bool remove(std::string_view data);
+    //! string na posicao index da ordem
+    std::string at(std::size_t index) const;
+    //! chama f(string_view) para cada string, em ordem
+    template<typename F>
+    void for_each(F&& f) const;
+    //! chama f(string_view) para cada string que comeca com prefix
+    template<typename F>
+    void for_each_prefix(std::string_view prefix, F&& f) const;
+    //! numero de strings (com repeticoes)
+    std::size_t size() const;
+    //! trie vazia
+    bool empty() const;
+    //! bytes ocupados por nodos e recipientes
+    std::size_t memory_usage() const;
+
+ private:
+    //! base de nodo e recipiente
+    struct Block {
+        bool trie;
+        std::size_t size;  // strings na subarvore (com repeticoes)
+    };
+    //! nodo interno: um filho por byte
+    struct Node : Block {
+        Block *children[256];
+        std::size_t here;  // ocorrencias da string que termina aqui
+    };
+    //! folha: sufixos ordenados num buffer contiguo
+    struct Bucket : Block {
+        std::vector<char> data;
+        std::size_t keys;  // sufixos distintos
+    };
+
+    BurstTrie(const BurstTrie&) = delete;
+    BurstTrie& operator=(const BurstTrie&) = delete;
+
+    static Node *new_node();
+    static Bucket *new_bucket();
+    static void destroy(Block *block);
+    static std::size_t memory_usage(const Block *block);
+    //! cabecalho da entrada em offset: tamanho e ocorrencias
+    static std::size_t entry_length(const Bucket *bucket, std::size_t offset);
+    static std::uint32_t entry_count(const Bucket *bucket, std::size_t offset);
+    static void entry_count(Bucket *bucket, std::size_t offset,
+                            std::uint32_t count);
+    static std::string_view entry_key(const Bucket *bucket,
+                                      std::size_t offset);
+    //! primeira entrada >= key; rank recebe as ocorrencias anteriores
+    static std::size_t bucket_seek(const Bucket *bucket,
+                                   std::string_view key, bool *equal,
+                                   std::size_t *rank);
+    //! insere key no recipiente
+    static void bucket_insert(Bucket *bucket, std::string_view key);
+    //! transforma o recipiente num nodo
+    static Node *burst(Bucket *bucket);
+    //! percorre a subarvore em ordem, com prefix acumulado
+    template<typename F>
+    static void walk(const Block *block, std::string *prefix, F& f);
+
+    Block *root_;
+
+    static const std::size_t HEADER = sizeof(std::uint16_t) +
+                                      sizeof(std::uint32_t);
+    static const std::size_t BURST_KEYS = 256u;
+    static const std::size_t BURST_BYTES = 16384u;
+    static const std::size_t MAX_LENGTH = 10000u;
+};
+
+}  // namespace structures
+
+inline structures::BurstTrie::BurstTrie() {
+    root_ = new_bucket();
+}
+
+inline structures::BurstTrie::~BurstTrie() {
+    destroy(root_);
+}
+
+inline void structures::BurstTrie::clear() {
+    destroy(root_);
+    root_ = new_bucket();
+}
+
+inline structures::BurstTrie::Node *
+structures::BurstTrie::new_node() {
+    Node *node = new Node();
+    node->trie = true;
+    node->size = 0;
+    node->here = 0;
+    return node;
+}
+
+inline structures::BurstTrie::Bucket *
+structures::BurstTrie::new_bucket() {
+    Bucket *bucket = new Bucket();
+    bucket->trie = false;
+    bucket->size = 0;
+    bucket->keys = 0;
+    return bucket;
+}
+
+inline void structures::BurstTrie::destroy(Block *block) {
+    if (block == nullptr) {
+        return;
+    }
+    if (block->trie) {
+        Node *node = static_cast<Node *>(block);
+        for (Block *child : node->children) {
+            destroy(child);
+        }
+        delete node;
+    } else {
+        delete static_cast<Bucket *>(block);
+    }
+}
+
+inline std::size_t structures::BurstTrie::entry_length(const Bucket *bucket,
+                                                std::size_t offset) {
+    std::uint16_t length;
+    memcpy(&length, bucket->data.data() + offset, sizeof(length));
+    return length;
+}
+
+inline std::uint32_t structures::BurstTrie::entry_count(const Bucket *bucket,
+                                                 std::size_t offset) {
+    std::uint32_t count;
+    memcpy(&count, bucket->data.data() + offset + sizeof(std::uint16_t),
+           sizeof(count));
+    return count;
+}
+
+inline void structures::BurstTrie::entry_count(Bucket *bucket,
+                                               std::size_t offset,
+                                               std::uint32_t count) {
+    memcpy(bucket->data.data() + offset + sizeof(std::uint16_t), &count,
+           sizeof(count));
+}
+
+inline std::string_view structures::BurstTrie::entry_key(const Bucket *bucket,
+                                                  std::size_t offset) {
+    return std::string_view(bucket->data.data() + offset + HEADER,
+                            entry_length(bucket, offset));
+}
+
+inline std::size_t structures::BurstTrie::bucket_seek(const Bucket *bucket,
+                                               std::string_view key,
+                                               bool *equal,
+                                               std::size_t *rank) {
+    std::size_t offset = 0;
+    *equal = false;
+    while (offset < bucket->data.size()) {
+        int comparison = entry_key(bucket, offset).compare(key);
+        if (comparison >= 0) {
+            *equal = comparison == 0;
+            break;
+        }
+        *rank += entry_count(bucket, offset);
+        offset += HEADER + entry_length(bucket, offset);
+    }
+    return offset;
+}
+
+inline void structures::BurstTrie::bucket_insert(Bucket *bucket,
+                                          std::string_view key) {
+    bool equal;
+    std::size_t rank = 0;
+    std::size_t offset = bucket_seek(bucket, key, &equal, &rank);
+    bucket->size++;
+    if (equal) {
+        entry_count(bucket, offset, entry_count(bucket, offset) + 1);
+        return;
+    }
+    char header[HEADER];
+    std::uint16_t length = static_cast<std::uint16_t>(key.size());
+    std::uint32_t count = 1;
+    memcpy(header, &length, sizeof(length));
+    memcpy(header + sizeof(length), &count, sizeof(count));
+    auto position = bucket->data.begin() + offset;
+    position = bucket->data.insert(position, header, header + HEADER);
+    bucket->data.insert(position + HEADER, key.begin(), key.end());
+    bucket->keys++;
+}
+
+inline structures::BurstTrie::Node *
+structures::BurstTrie::burst(Bucket *bucket) {
+    Node *node = new_node();
+    node->size = bucket->size;
+    std::size_t offset = 0;
+    // os sufixos ja estao em ordem, entao cada filho recebe os seus em ordem
+    while (offset < bucket->data.size()) {
+        std::string_view key = entry_key(bucket, offset);
+        std::uint32_t count = entry_count(bucket, offset);
+        if (key.empty()) {
+            node->here = count;
+        } else {
+            unsigned char first = static_cast<unsigned char>(key[0]);
+            if (node->children[first] == nullptr) {
+                node->children[first] = new_bucket();
+            }
+            Bucket *child = static_cast<Bucket *>(node->children[first]);
+            std::uint16_t length = static_cast<std::uint16_t>(key.size() - 1);
+            char header[HEADER];
+            memcpy(header, &length, sizeof(length));
+            memcpy(header + sizeof(length), &count, sizeof(count));
+            child->data.insert(child->data.end(), header, header + HEADER);
+            child->data.insert(child->data.end(), key.begin() + 1, key.end());
+            child->keys++;
+            child->size += count;
+        }
+        offset += HEADER + key.size();
+    }
+    delete bucket;
+    return node;
+}
+
+inline void structures::BurstTrie::insert_sorted(const char *data) {
+    insert_sorted(std::string_view(data));
+}
+
+inline void structures::BurstTrie::insert_sorted(std::string_view data) {
+    if (data.size() >= MAX_LENGTH) {
+        raise_out_of_range("string maior que 10.000");
+    }
+    Block **slot = &root_;
+    std::size_t position = 0;
+    while (true) {
+        if (*slot == nullptr) {
+            *slot = new_bucket();
+        }
+        if (!(*slot)->trie) {
+            Bucket *bucket = static_cast<Bucket *>(*slot);
+            bucket_insert(bucket, data.substr(position));
+            if (bucket->keys > BURST_KEYS ||
+                bucket->data.size() > BURST_BYTES) {
+                *slot = burst(bucket);
+            }
+            return;
+        }
+        Node *node = static_cast<Node *>(*slot);
+        node->size++;
+        if (position == data.size()) {
+            node->here++;
+            return;
+        }
+        slot = &node->children[static_cast<unsigned char>(data[position])];
+        position++;
+    }
+}
+
+inline bool structures::BurstTrie::contains(std::string_view data) const {
+    const Block *block = root_;
+    std::size_t position = 0;
+    while (block != nullptr && block->trie) {
+        const Node *node = static_cast<const Node *>(block);
+        if (position == data.size()) {
+            return node->here > 0;
+        }
+        block = node->children[static_cast<unsigned char>(data[position])];
+        position++;
+    }
+    if (block == nullptr) {
+        return false;
+    }
+    bool equal;
+    std::size_t rank = 0;
+    bucket_seek(static_cast<const Bucket *>(block), data.substr(position),
+                &equal, &rank);
+    return equal;
+}
+
+inline std::size_t structures::BurstTrie::find(std::string_view data) const {
+    std::size_t rank = 0;
+    const Block *block = root_;
+    std::size_t position = 0;
+    while (block != nullptr && block->trie) {
+        const Node *node = static_cast<const Node *>(block);
+        if (position == data.size()) {
+            return node->here > 0 ? rank : size();
+        }
+        // strings que terminam aqui e filhos menores vem antes
+        rank += node->here;
+        unsigned char next = static_cast<unsigned char>(data[position]);
+        for (std::size_t c = 0; c < next; c++) {
+            if (node->children[c] != nullptr) {
+                rank += node->children[c]->size;
+            }
+        }
+        block = node->children[next];
+        position++;
+    }
+    if (block == nullptr) {
+        return size();
+    }
+    bool equal;
+    bucket_seek(static_cast<const Bucket *>(block), data.substr(position),
+                &equal, &rank);
+    return equal ? rank : size();
+}
+
+inline bool structures::BurstTrie::remove(std::string_view data) {
+    if (!contains(data)) {
+        return false;
+    }
+    Block **slot = &root_;
+    std::size_t position = 0;
+    while ((*slot)->trie) {
+        Node *node = static_cast<Node *>(*slot);
+        node->size--;
+        if (position == data.size()) {
+            node->here--;
+            return true;
+        }
+        slot = &node->children[static_cast<unsigned char>(data[position])];
+        position++;
+    }
+    Bucket *bucket = static_cast<Bucket *>(*slot);
+    bool equal;
+    std::size_t rank = 0;
+    std::size_t offset = bucket_seek(bucket, data.substr(position), &equal,
+                                     &rank);
+    bucket->size--;
+    std::uint32_t count = entry_count(bucket, offset);
+    if (count > 1) {
+        entry_count(bucket, offset, count - 1);
+    } else {
+        auto begin = bucket->data.begin() + offset;
+        bucket->data.erase(begin, begin + HEADER +
+                                  entry_length(bucket, offset));
+        bucket->keys--;
+    }
+    if (bucket->size == 0 && bucket != root_) {
+        delete bucket;
+        *slot = nullptr;
+    }
+    return true;
+}
+
+inline std::string structures::BurstTrie::at(std::size_t index) const {
+    if (index >= size()) {
+        raise_out_of_range("index invalido");
+    }
+    std::string result;
+    const Block *block = root_;
+    while (block->trie) {
+        const Node *node = static_cast<const Node *>(block);
+        if (index < node->here) {
+            return result;
+        }
+        index -= node->here;
+        for (std::size_t c = 0; c < 256; c++) {
+            const Block *child = node->children[c];
+            if (child == nullptr) {
+                continue;
+            }
+            if (index < child->size) {
+                result.push_back(static_cast<char>(c));
+                block = child;
+                break;
+            }
+            index -= child->size;
+        }
+    }
+    const Bucket *bucket = static_cast<const Bucket *>(block);
+    std::size_t offset = 0;
+    while (index >= entry_count(bucket, offset)) {
+        index -= entry_count(bucket, offset);
+        offset += HEADER + entry_length(bucket, offset);
+    }
+    result.append(entry_key(bucket, offset));
+    return result;
+}
+
+template<typename F>
+void structures::BurstTrie::walk(const Block *block, std::string *prefix,
+                                 F& f) {
+    if (block == nullptr) {
+        return;
+    }
+    if (block->trie) {
+        const Node *node = static_cast<const Node *>(block);
+        for (std::size_t i = 0; i < node->here; i++) {
+            f(std::string_view(*prefix));
+        }
+        for (std::size_t c = 0; c < 256; c++) {
+            if (node->children[c] != nullptr) {
+                prefix->push_back(static_cast<char>(c));
+                walk(node->children[c], prefix, f);
+                prefix->pop_back();
+            }
+        }
+        return;
+    }
+    const Bucket *bucket = static_cast<const Bucket *>(block);
+    std::size_t base = prefix->size();
+    for (std::size_t offset = 0; offset < bucket->data.size();
+         offset += HEADER + entry_length(bucket, offset)) {
+        prefix->append(entry_key(bucket, offset));
+        for (std::uint32_t i = entry_count(bucket, offset); i > 0; i--) {
+            f(std::string_view(*prefix));
+        }
+        prefix->resize(base);
+    }
+}
+
+template<typename F>
+void structures::BurstTrie::for_each(F&& f) const {
+    std::string prefix;
+    walk(root_, &prefix, f);
+}
+
+template<typename F>
+void structures::BurstTrie::for_each_prefix(std::string_view prefix,
+                                            F&& f) const {
+    std::string path;
+    const Block *block = root_;
+    std::size_t position = 0;
+    // desce pelos nodos consumindo o prefixo
+    while (block != nullptr && block->trie && position < prefix.size()) {
+        const Node *node = static_cast<const Node *>(block);
+        block = node->children[static_cast<unsigned char>(prefix[position])];
+        path.push_back(prefix[position]);
+        position++;
+    }
+    if (block == nullptr) {
+        return;
+    }
+    if (block->trie) {
+        walk(block, &path, f);
+        return;
+    }
+    // dentro do recipiente os sufixos com o resto do prefixo sao contiguos
+    const Bucket *bucket = static_cast<const Bucket *>(block);
+    std::string_view rest = prefix.substr(position);
+    bool equal;
+    std::size_t rank = 0;
+    std::size_t offset = bucket_seek(bucket, rest, &equal, &rank);
+    std::size_t base = path.size();
+    for (; offset < bucket->data.size();
+         offset += HEADER + entry_length(bucket, offset)) {
+        std::string_view key = entry_key(bucket, offset);
+        if (key.substr(0, rest.size()) != rest) {
+            break;
+        }
+        path.append(key);
+        for (std::uint32_t i = entry_count(bucket, offset); i > 0; i--) {
+            f(std::string_view(path));
+        }
+        path.resize(base);
+    }
+}
+
+inline std::size_t structures::BurstTrie::size() const {
+    return root_->size;
+}
+
+inline bool structures::BurstTrie::empty() const {
+    return size() == 0;
+}
+
+inline std::size_t structures::BurstTrie::memory_usage(const Block *block) {
+    if (block == nullptr) {
+        return 0;
+    }
+    if (!block->trie) {
+        const Bucket *bucket = static_cast<const Bucket *>(block);
+        return sizeof(Bucket) + bucket->data.capacity();
+    }
+    const Node *node = static_cast<const Node *>(block);
+    std::size_t total = sizeof(Node);
+    for (const Block *child : node->children) {
+        total += memory_usage(child);
+    }
+    return total;
+}
+
+inline std::size_t structures::BurstTrie::memory_usage() const {
+    return memory_usage(root_);
+}
+
+#endif
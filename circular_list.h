@@ -4,13 +4,25 @@
 
 #include <cstdint>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "./error_policy.h"
 
 namespace structures {
 
 //! Classe de implementação de lista circular
-template<typename T>
+/*!
+ *  Policy decide o que acontece com lista vazia ou indice invalido (veja
+ *  error_policy.h).
+ */
+template<typename T, typename Policy = ThrowPolicy>
 class CircularList {
  public:
+    //! retorno de uma operacao que devolveria R, conforme Policy
+    template<typename R>
+    using Result = typename Policy::template result<R>;
+
     //! construtor padrão de lista circular
     CircularList();
     //! destrutor de lista circular
@@ -18,25 +30,43 @@ class CircularList {
     //! método para limpar a lista circular
     void clear();
     //! método para inserir dados no fim
-    void push_back(const T& data);
+    Result<void> push_back(const T& data);
     //! método para inserir dados no início
-    void push_front(const T& data);
+    Result<void> push_front(const T& data);
     //! método para inserir dado em determinada posição
-    void insert(const T& data, std::size_t index);
+    Result<void> insert(const T& data, std::size_t index);
     //! método para inserir dados em ordem
-    void insert_sorted(const T& data);
+    Result<void> insert_sorted(const T& data);
     //! acessar em um indice (com checagem de limites)
-    T& at(std::size_t index);
+    Result<T&> at(std::size_t index) noexcept(Policy::nothrow);
     //! versão const do acesso ao indice
-    const T& at(std::size_t index) const;
+    Result<const T&> at(std::size_t index) const
+        noexcept(Policy::nothrow);
     //! retirar da posição
-    T pop(std::size_t index);
+    Result<T> pop(std::size_t index) noexcept(nothrow_move<Policy, T>);
     //! retirar do fim
-    T pop_back();
+    Result<T> pop_back() noexcept(nothrow_move<Policy, T>);
     //! retirar do início
-    T pop_front();
+    Result<T> pop_front() noexcept(nothrow_move<Policy, T>);
     //! remover dado específico
-    void remove(const T& data);
+    Result<void> remove(const T& data);
+    //! retirar do início em *data sem lancar; Status::EMPTY se vazia
+    Status try_pop_front(T* data)
+        noexcept(std::is_nothrow_move_assignable<T>::value);
+    //! intercala os nodos de other nesta lista, esvaziando other
+    /*!
+     *  As operacoes de conjunto supoem as duas listas em ordem crescente
+     *  e fazem uma passada so, religando nodos sem alocar. Repetidos
+     *  contam como em std::set_union e afins. Com a propria lista, merge
+     *  e set_union nao mudam nada.
+     */
+    void merge(CircularList& other);
+    //! uniao: move de other os nodos sem par aqui, esvaziando other
+    void set_union(CircularList& other);
+    //! mantem so os dados que tambem estao em other
+    void set_intersection(const CircularList& other);
+    //! tira desta lista os dados que estao em other
+    void set_difference(const CircularList& other);
     //! lista vazia
     bool empty() const;
     //! lista contém determinado dado?
@@ -102,6 +132,12 @@ class CircularList {
         Node* next_{nullptr};
         bool sentinela_;
     };
+    //! religa os nodos das duas listas em ordem nesta; com unique, o
+    //! nodo de other igual a um desta e' liberado
+    void splice_sorted(CircularList* other, bool unique);
+    //! libera os nodos com (ou sem, se keep) par em other
+    void filter_sorted(const CircularList& other, bool keep);
+
     //! nodo-topo
     Node* head;
     //! tamanho
@@ -110,65 +146,63 @@ class CircularList {
 
 }  // namespace structures
 
-template<typename T>
-structures::CircularList<T>::CircularList() {
+template<typename T, typename P>
+structures::CircularList<T, P>::CircularList() {
     size_ = 0;
     Node *sent = new Node(0, nullptr, true);
     sent -> next(sent);
     head = sent;
 }
 
-template<typename T>
-structures::CircularList<T>::~CircularList() {
+template<typename T, typename P>
+structures::CircularList<T, P>::~CircularList() {
     clear();
     delete(head);
 }
 
-template<typename T>
-void structures::CircularList<T>::clear() {
+template<typename T, typename P>
+void structures::CircularList<T, P>::clear() {
     while (!empty()) {
         pop_front();
     }
 }
 
-template<typename T>
-void structures::CircularList<T>::push_back(const T& data) {
+template<typename T, typename P>
+typename P::template result<void>
+structures::CircularList<T, P>::push_back(const T& data) {
     Node *new_element = new Node(data, head, false);
-    if (new_element == nullptr) {
-        throw std::out_of_range("Circular list full");
+    if (empty() == true) {
+        head -> next(new_element);
     } else {
-        if (empty() == true) {
-            head -> next(new_element);
-        } else {
-            Node *temp = head -> next();
-            for (size_t i = 0; i < size_ - 1; i++) {
-                temp = temp -> next();
-            }
-            temp -> next(new_element);
+        Node *temp = head -> next();
+        for (size_t i = 0; i < size_ - 1; i++) {
+            temp = temp -> next();
         }
-        size_++;
+        temp -> next(new_element);
     }
+    size_++;
+    return typename P::template result<void>();
 }
 
-template<typename T>
-void structures::CircularList<T>::push_front(const T& data) {
+template<typename T, typename P>
+typename P::template result<void>
+structures::CircularList<T, P>::push_front(const T& data) {
     Node *new_element = new Node(data, nullptr, false);
-    if (new_element == nullptr) {
-        throw std::out_of_range("Circular list full");
+    if (empty() == true) {
+        new_element -> next(head);
     } else {
-        if (empty() == true) {
-            new_element -> next(head);
-        } else {
-            new_element -> next(head -> next());
-        }
-        head -> next(new_element);
-        size_++;
+        new_element -> next(head -> next());
     }
+    head -> next(new_element);
+    size_++;
+    return typename P::template result<void>();
 }
-template<typename T>
-void structures::CircularList<T>::insert(const T& data, std::size_t index) {
-    if (index > size_) {
-        throw std::out_of_range("Circular List full");
+template<typename T, typename P>
+typename P::template result<void>
+structures::CircularList<T, P>::insert(const T& data, std::size_t index) {
+    if (P::checked && index > size_) {
+        return P::template fail<void>(Status::INVALID_INDEX,
+                                      "Circular List full");
     }
     if (index == 0) {
         return push_front(data);
@@ -180,9 +214,6 @@ void structures::CircularList<T>::insert(const T& data, std::size_t index) {
                 return push_front(data);
             } else {
                 Node* new_element = new Node(data, nullptr, false);
-                if (new_element == nullptr) {
-                    throw std::out_of_range("Full List");
-                }
                 Node* temp = head->next();
                 Node* previous = nullptr;
                 for (size_t i = 0; i < index; i++) {
@@ -194,29 +225,32 @@ void structures::CircularList<T>::insert(const T& data, std::size_t index) {
                 new_element->next(temp);
                 previous->next(new_element);
                 size_++;
+                return typename P::template result<void>();
             }
         }
     }
 }
 
-template<typename T>
-void structures::CircularList<T>::insert_sorted(const T& data) {
+template<typename T, typename P>
+typename P::template result<void>
+structures::CircularList<T, P>::insert_sorted(const T& data) {
     size_t index = 0;
     Node *temp = head -> next();
     while (index < size_ && temp != nullptr && data > temp -> data()) {
         index++;
         temp = temp -> next();
     }
-    insert(data, index);
+    return insert(data, index);
 }
 
-template<typename T>
-T& structures::CircularList<T>::at(std::size_t index) {
-    if (empty()) {
-        throw std::out_of_range("Circular list empty");
+template<typename T, typename P>
+typename P::template result<T&>
+structures::CircularList<T, P>::at(std::size_t index) noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<T&>(Status::EMPTY, "Circular list empty");
     }
-    if (index > size_) {
-        throw std::out_of_range("Out of bound");
+    if (P::checked && index >= size_) {
+        return P::template fail<T&>(Status::INVALID_INDEX, "Out of bound");
     }
     Node* temp = head -> next();
     for (size_t i = 0; i < index; i++) {
@@ -225,13 +259,16 @@ T& structures::CircularList<T>::at(std::size_t index) {
     return temp -> data();
 }
 
-template<typename T>
-const T& structures::CircularList<T>::at(std::size_t index) const {
-    if (empty()) {
-        throw std::out_of_range("Circular list empty");
+template<typename T, typename P>
+typename P::template result<const T&>
+structures::CircularList<T, P>::at(std::size_t index) const
+    noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<const T&>(Status::EMPTY, "Circular list empty");
     }
-    if (index > size_) {
-        throw std::out_of_range("Out of bound");
+    if (P::checked && index >= size_) {
+        return P::template fail<const T&>(Status::INVALID_INDEX,
+                                          "Out of bound");
     }
     Node* temp = head -> next();
     for (size_t i = 0; i < index; i++) {
@@ -240,13 +277,15 @@ const T& structures::CircularList<T>::at(std::size_t index) const {
     return temp -> data();
 }
 
-template<typename T>
-T structures::CircularList<T>::pop(std::size_t index) {
-    if (empty()) {
-        throw std::out_of_range("Circular List empty");
+template<typename T, typename P>
+typename P::template result<T>
+structures::CircularList<T, P>::pop(std::size_t index)
+    noexcept(nothrow_move<P, T>) {
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY, "Circular List empty");
     }
-    if (index >= size_) {
-        throw std::out_of_range("Invalid index");
+    if (P::checked && index >= size_) {
+        return P::template fail<T>(Status::INVALID_INDEX, "Invalid index");
     }
     if (index == 0) {
         return pop_front();
@@ -259,12 +298,11 @@ T structures::CircularList<T>::pop(std::size_t index) {
             } else {
                 Node *e_retirar = head -> next();
                 Node *previous = nullptr;
-                T return_data;
                 for (size_t i = 0; i < index; i++) {
                     previous = e_retirar;
                     e_retirar = e_retirar -> next();
                 }
-                return_data = e_retirar -> data();
+                T return_data = std::move(e_retirar -> data());
                 previous -> next(e_retirar -> next());
                 size_--;
                 delete(e_retirar);
@@ -274,13 +312,13 @@ T structures::CircularList<T>::pop(std::size_t index) {
     }
 }
 
-template<typename T>
-T structures::CircularList<T>::pop_back() {
-    if (empty()) {
-        throw std::out_of_range("Circular List empty");
+template<typename T, typename P>
+typename P::template result<T> structures::CircularList<T, P>::pop_back()
+    noexcept(nothrow_move<P, T>) {
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY, "Circular List empty");
     }
     Node *e_retirar = head -> next();
-    T return_data;
     if (size_ > 1) {
         Node* previous = nullptr;
         for (size_t i = 0; i < size_ -1; i++) {
@@ -288,25 +326,25 @@ T structures::CircularList<T>::pop_back() {
             previous = e_retirar;
             e_retirar = e_retirar -> next();
           }
-        return_data = e_retirar -> data();
         }
     previous -> next(head);
     } else {
-    return_data = e_retirar -> data();
     head -> next(head);
     }
+    T return_data = std::move(e_retirar -> data());
     delete(e_retirar);
     size_--;
     return return_data;
 }
 
-template<typename T>
-T structures::CircularList<T>::pop_front() {
-  if (empty()) {
-    throw std::out_of_range("Circular List empty");
+template<typename T, typename P>
+typename P::template result<T> structures::CircularList<T, P>::pop_front()
+    noexcept(nothrow_move<P, T>) {
+  if (P::checked && empty()) {
+    return P::template fail<T>(Status::EMPTY, "Circular List empty");
   }
   Node *e_retirar = head->next();
-  T return_data = e_retirar -> data();
+  T return_data = std::move(e_retirar -> data());
   if (size_ > 1) {
     head -> next(e_retirar -> next());
   } else {
@@ -317,24 +355,147 @@ T structures::CircularList<T>::pop_front() {
   return return_data;
 }
 
-template<typename T>
-void structures::CircularList<T>::remove(const T& data) {
-    if (empty()) {
-        throw std::out_of_range("Circular List Empty");
+template<typename T, typename P>
+typename P::template result<void>
+structures::CircularList<T, P>::remove(const T& data) {
+    if (P::checked && empty()) {
+        return P::template fail<void>(Status::EMPTY, "Circular List Empty");
     }
     size_t index = find(data);
+    if (index == size_) {
+        if (P::checked) {
+            return P::template fail<void>(Status::NOT_FOUND, "Invalid index");
+        }
+        return typename P::template result<void>();
+    }
     pop(index);
+    return typename P::template result<void>();
+}
+
+template<typename T, typename P>
+structures::Status structures::CircularList<T, P>::try_pop_front(T* data)
+    noexcept(std::is_nothrow_move_assignable<T>::value) {
+  if (empty()) {
+    return Status::EMPTY;
+  }
+  Node *e_retirar = head->next();
+  *data = std::move(e_retirar -> data());
+  head -> next(e_retirar -> next());
+  delete(e_retirar);
+  size_--;
+  return Status::OK;
+}
+
+template<typename T, typename P>
+void structures::CircularList<T, P>::merge(CircularList& other) {
+    splice_sorted(&other, false);
+}
+
+template<typename T, typename P>
+void structures::CircularList<T, P>::set_union(CircularList& other) {
+    splice_sorted(&other, true);
+}
+
+template<typename T, typename P>
+void structures::CircularList<T, P>::set_intersection(
+                                            const CircularList& other) {
+    filter_sorted(other, true);
+}
+
+template<typename T, typename P>
+void structures::CircularList<T, P>::set_difference(
+                                            const CircularList& other) {
+    filter_sorted(other, false);
+}
+
+template<typename T, typename P>
+void structures::CircularList<T, P>::splice_sorted(CircularList* other,
+                                                   bool unique) {
+    if (other == this) {
+        return;
+    }
+    Node* a = head->next();
+    Node* b = other->head->next();
+    std::size_t count_a = size_;
+    std::size_t count_b = other->size_;
+    other->head->next(other->head);
+    other->size_ = 0;
+    // tail cresce a partir da sentinela
+    Node* tail = head;
+    while (count_b > 0) {
+        if (count_a == 0 || b->data() < a->data()) {
+            tail->next(b);
+            tail = b;
+            b = b->next();
+            count_b--;
+            size_++;
+        } else {
+            if (unique && !(a->data() < b->data())) {
+                Node* repetido = b;
+                b = b->next();
+                count_b--;
+                delete(repetido);
+            }
+            tail->next(a);
+            tail = a;
+            a = a->next();
+            count_a--;
+        }
+    }
+    // o resto desta lista ja termina na sentinela
+    if (count_a > 0) {
+        tail->next(a);
+    } else {
+        tail->next(head);
+    }
+}
+
+template<typename T, typename P>
+void structures::CircularList<T, P>::filter_sorted(
+                                const CircularList& other, bool keep) {
+    if (&other == this) {
+        if (!keep) {
+            clear();
+        }
+        return;
+    }
+    const Node* b = other.head->next();
+    std::size_t count_b = other.size_;
+    Node* previous = head;
+    Node* atual = head->next();
+    std::size_t count = size_;
+    for (std::size_t i = 0; i < count; i++) {
+        Node* next = atual->next();
+        while (count_b > 0 && b->data() < atual->data()) {
+            b = b->next();
+            count_b--;
+        }
+        bool par = count_b > 0 && !(atual->data() < b->data());
+        if (par) {
+            b = b->next();
+            count_b--;
+        }
+        if (par == keep) {
+            previous = atual;
+        } else {
+            previous->next(next);
+            delete(atual);
+            size_--;
+        }
+        atual = next;
+    }
 }
 
-template<typename T>
-bool structures::CircularList<T>::empty() const {
+template<typename T, typename P>
+bool structures::CircularList<T, P>::empty() const {
     return (size_ == 0);
 }
 
-template <typename T>
-bool structures::CircularList<T>::contains(const T& data) const {
+template<typename T, typename P>
+bool structures::CircularList<T, P>::contains(const T& data) const {
   if (empty()) {
-    throw std::out_of_range("Circular List empty");
+    P::report(Status::EMPTY, "Circular List empty");
+    return false;
   }
   Node *temp = head->next();
   for (size_t i = 0; i < size_; i++) {
@@ -346,8 +507,8 @@ bool structures::CircularList<T>::contains(const T& data) const {
   return false;
 }
 
-template <typename T>
-std::size_t structures::CircularList<T>::find(const T& data) const {
+template<typename T, typename P>
+std::size_t structures::CircularList<T, P>::find(const T& data) const {
   Node *temp = head->next();
   for (size_t i = 0; i < size_; i++) {
     if (temp->data() == data && !temp->sentinela()) {
@@ -358,8 +519,8 @@ std::size_t structures::CircularList<T>::find(const T& data) const {
   return size_;
 }
 
-template <typename T>
-std::size_t structures::CircularList<T>::size() const {
+template<typename T, typename P>
+std::size_t structures::CircularList<T, P>::size() const {
   return size_;
 }
 
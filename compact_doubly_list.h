@@ -0,0 +1,338 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_COMPACT_DOUBLY_LIST_H
+#define STRUCTURES_COMPACT_DOUBLY_LIST_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+//! Classe de lista dupla compacta (nodos em vetor, ligacoes de 32 bits)
+/*!
+ *  Mesma interface de DoublyCircularList, mas os nodos ficam num unico
+ *  vetor e se ligam por indices de 32 bits: para T de 4 a 8 bytes cada
+ *  nodo ocupa 12 a 16 bytes, contra dois ponteiros mais o cabecalho do
+ *  heap por nodo. O indice 0 e' o sentinela; posicoes liberadas vao para
+ *  uma lista de livres. compact() renumera os nodos na ordem da lista;
+ *  enquanto so houver push_back/pop_back depois disso, at() e' O(1).
+ */
+template<typename T>
+class CompactDoublyList {
+ public:
+    //! construtor padrão
+    CompactDoublyList();
+    //! destrutor
+    ~CompactDoublyList();
+    //! método para limpar a lista
+    void clear();
+    //! reserva espaco para capacity elementos
+    void reserve(std::size_t capacity);
+    //! método para inserir dados no fim
+    void push_back(const T& data);
+    //! metodo insere no inicio
+    void push_front(const T& data);
+    //! metodo insere na posicao
+    void insert(const T& data, std::size_t index);
+    //! metodo insere em ordem
+    void insert_sorted(const T& data);
+    //! metodo retira da posicao
+    T pop(std::size_t index);
+    //! metodo retira do fim
+    T pop_back();
+    //! metodo retira do inicio
+    T pop_front();
+    //! retira especifico
+    void remove(const T& data);
+    //! lista vazia
+    bool empty() const;
+    //! contem
+    bool contains(const T& data) const;
+    //! acesso a um elemento (checando limites)
+    T& at(std::size_t index);
+    //! getter constante a um elemento
+    const T& at(std::size_t index) const;
+    //! posição de um dado
+    std::size_t find(const T& data) const;
+    //! tamanho
+    std::size_t size() const;
+    //! renumera os nodos na ordem da lista e devolve a memoria livre
+    void compact();
+    //! bytes ocupados pelos nodos (inclusive livres e sentinela)
+    std::size_t memory_usage() const;
+
+ private:
+    struct Node {
+        T data;
+        std::uint32_t prev;
+        std::uint32_t next;
+    };
+
+    //! indice de um nodo livre (reaproveitado ou novo no fim do vetor)
+    std::uint32_t allocate(const T& data);
+    //! liga o nodo index antes de next
+    void link(std::uint32_t index, std::uint32_t next);
+    //! desliga o nodo index, libera-o e devolve o dado
+    T unlink(std::uint32_t index);
+    //! indice do nodo na posicao (posicao valida)
+    std::uint32_t node_at(std::size_t index) const;
+
+    std::vector<Node> nodes_;
+    std::uint32_t free_;  // cabeca da lista de livres (0 = vazia)
+    std::size_t size_;
+    bool ordered_;  // nodo da posicao i e' nodes_[i + 1]
+
+    static const std::uint32_t SENTINEL = 0u;
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::CompactDoublyList<T>::CompactDoublyList() {
+    nodes_.push_back(Node{T(), SENTINEL, SENTINEL});
+    free_ = SENTINEL;
+    size_ = 0;
+    ordered_ = true;
+}
+
+template<typename T>
+structures::CompactDoublyList<T>::~CompactDoublyList() {}
+
+template<typename T>
+void structures::CompactDoublyList<T>::clear() {
+    nodes_.resize(1);
+    nodes_[SENTINEL].prev = SENTINEL;
+    nodes_[SENTINEL].next = SENTINEL;
+    free_ = SENTINEL;
+    size_ = 0;
+    ordered_ = true;
+}
+
+template<typename T>
+void structures::CompactDoublyList<T>::reserve(std::size_t capacity) {
+    nodes_.reserve(capacity + 1);
+}
+
+template<typename T>
+std::uint32_t structures::CompactDoublyList<T>::allocate(const T& data) {
+    if (free_ != SENTINEL) {
+        std::uint32_t index = free_;
+        free_ = nodes_[index].next;
+        nodes_[index].data = data;
+        return index;
+    }
+    if (nodes_.size() > UINT32_MAX) {
+        raise_out_of_range("lista cheia");
+    }
+    nodes_.push_back(Node{data, SENTINEL, SENTINEL});
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
+
+template<typename T>
+void structures::CompactDoublyList<T>::link(std::uint32_t index,
+                                            std::uint32_t next) {
+    std::uint32_t prev = nodes_[next].prev;
+    nodes_[index].prev = prev;
+    nodes_[index].next = next;
+    nodes_[prev].next = index;
+    nodes_[next].prev = index;
+    size_++;
+}
+
+template<typename T>
+T structures::CompactDoublyList<T>::unlink(std::uint32_t index) {
+    Node& node = nodes_[index];
+    nodes_[node.prev].next = node.next;
+    nodes_[node.next].prev = node.prev;
+    T return_data = std::move(node.data);
+    size_--;
+    if (index == nodes_.size() - 1) {
+        // o ultimo nodo do vetor sai direto, sem ir para os livres
+        nodes_.pop_back();
+    } else {
+        node.next = free_;
+        free_ = index;
+        ordered_ = false;
+    }
+    return return_data;
+}
+
+template<typename T>
+std::uint32_t structures::CompactDoublyList<T>::node_at(
+                                            std::size_t index) const {
+    if (ordered_) {
+        return static_cast<std::uint32_t>(index + 1);
+    }
+    std::uint32_t node;
+    if (index <= size_ / 2) {
+        node = nodes_[SENTINEL].next;
+        for (std::size_t i = 0; i < index; i++) {
+            node = nodes_[node].next;
+        }
+    } else {
+        node = nodes_[SENTINEL].prev;
+        for (std::size_t i = 0; i < size_ - index - 1; i++) {
+            node = nodes_[node].prev;
+        }
+    }
+    return node;
+}
+
+template<typename T>
+void structures::CompactDoublyList<T>::push_back(const T& data) {
+    bool append = free_ == SENTINEL;
+    link(allocate(data), SENTINEL);
+    // anexar no fim do vetor mantem a numeracao em ordem
+    ordered_ = ordered_ && append;
+}
+
+template<typename T>
+void structures::CompactDoublyList<T>::push_front(const T& data) {
+    link(allocate(data), nodes_[SENTINEL].next);
+    ordered_ = false;
+}
+
+template<typename T>
+void structures::CompactDoublyList<T>::insert(const T& data,
+                                              std::size_t index) {
+    if (index > size_) {
+        raise_out_of_range("Index invalido");
+    }
+    if (index == size_) {
+        push_back(data);
+        return;
+    }
+    std::uint32_t next = node_at(index);
+    link(allocate(data), next);
+    ordered_ = false;
+}
+
+template<typename T>
+void structures::CompactDoublyList<T>::insert_sorted(const T& data) {
+    std::uint32_t node = nodes_[SENTINEL].next;
+    while (node != SENTINEL && data > nodes_[node].data) {
+        node = nodes_[node].next;
+    }
+    if (node == SENTINEL) {
+        push_back(data);
+        return;
+    }
+    link(allocate(data), node);
+    ordered_ = false;
+}
+
+template<typename T>
+T structures::CompactDoublyList<T>::pop(std::size_t index) {
+    if (empty()) {
+        raise_out_of_range("CompactDoublyList is empty");
+    }
+    if (index >= size_) {
+        raise_out_of_range("Index invalido");
+    }
+    return unlink(node_at(index));
+}
+
+template<typename T>
+T structures::CompactDoublyList<T>::pop_back() {
+    if (empty()) {
+        raise_out_of_range("CompactDoublyList is empty");
+    }
+    return unlink(nodes_[SENTINEL].prev);
+}
+
+template<typename T>
+T structures::CompactDoublyList<T>::pop_front() {
+    if (empty()) {
+        raise_out_of_range("CompactDoublyList is empty");
+    }
+    return unlink(nodes_[SENTINEL].next);
+}
+
+template<typename T>
+void structures::CompactDoublyList<T>::remove(const T& data) {
+    if (empty()) {
+        raise_out_of_range("CompactDoublyList is empty");
+    }
+    std::uint32_t node = nodes_[SENTINEL].next;
+    while (node != SENTINEL) {
+        if (nodes_[node].data == data) {
+            unlink(node);
+            return;
+        }
+        node = nodes_[node].next;
+    }
+}
+
+template<typename T>
+bool structures::CompactDoublyList<T>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T>
+bool structures::CompactDoublyList<T>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+template<typename T>
+T& structures::CompactDoublyList<T>::at(std::size_t index) {
+    if (index >= size_) {
+        raise_out_of_range("Invalid Index");
+    }
+    return nodes_[node_at(index)].data;
+}
+
+template<typename T>
+const T& structures::CompactDoublyList<T>::at(std::size_t index) const {
+    if (index >= size_) {
+        raise_out_of_range("Invalid Index");
+    }
+    return nodes_[node_at(index)].data;
+}
+
+template<typename T>
+std::size_t structures::CompactDoublyList<T>::find(const T& data) const {
+    std::uint32_t node = nodes_[SENTINEL].next;
+    for (std::size_t i = 0; i < size_; i++) {
+        if (nodes_[node].data == data) {
+            return i;
+        }
+        node = nodes_[node].next;
+    }
+    return size_;
+}
+
+template<typename T>
+std::size_t structures::CompactDoublyList<T>::size() const {
+    return size_;
+}
+
+template<typename T>
+void structures::CompactDoublyList<T>::compact() {
+    std::vector<Node> nodes;
+    nodes.reserve(size_ + 1);
+    nodes.push_back(Node{std::move(nodes_[SENTINEL].data), SENTINEL,
+                         SENTINEL});
+    std::uint32_t node = nodes_[SENTINEL].next;
+    for (std::uint32_t i = 1; i <= size_; i++) {
+        nodes.push_back(Node{std::move(nodes_[node].data), i - 1, i + 1});
+        node = nodes_[node].next;
+    }
+    if (size_ > 0) {
+        nodes[SENTINEL].next = 1;
+        nodes[SENTINEL].prev = static_cast<std::uint32_t>(size_);
+        nodes.back().next = SENTINEL;
+    }
+    nodes_.swap(nodes);
+    free_ = SENTINEL;
+    ordered_ = true;
+}
+
+template<typename T>
+std::size_t structures::CompactDoublyList<T>::memory_usage() const {
+    return nodes_.capacity() * sizeof(Node);
+}
+
+#endif
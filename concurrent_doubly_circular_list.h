@@ -0,0 +1,441 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_CONCURRENT_DOUBLY_CIRCULAR_LIST_H
+#define STRUCTURES_CONCURRENT_DOUBLY_CIRCULAR_LIST_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+//! Classe de lista circular dupla concorrente (hand-over-hand)
+/*!
+ *  Cada nodo tem seu proprio mutex e as operacoes percorrem a lista
+ *  travando o proximo nodo antes de soltar o atual, entao operacoes em
+ *  trechos diferentes correm em paralelo.
+ *
+ *  Ordem global dos locks: head (protege sentinela->next), nodos na ordem
+ *  da lista, tail (protege sentinela->prev). Quem anda para frente trava
+ *  bloqueando; quem anda para tras (push_back, pop_back,
+ *  for_each_reverse) usa try_lock e, se falhar, solta o que tem e tenta
+ *  de novo, o que evita deadlock na volta do circulo.
+ */
+template<typename T>
+class ConcurrentDoublyCircularList {
+ public:
+    //! construtor padrão
+    ConcurrentDoublyCircularList();
+    //! destrutor (nao pode haver operacoes em andamento)
+    ~ConcurrentDoublyCircularList();
+    //! método para limpar a lista
+    void clear();
+    //! método para inserir dados no fim
+    void push_back(const T& data);
+    //! metodo insere no inicio
+    void push_front(const T& data);
+    //! metodo insere na posicao
+    void insert(const T& data, std::size_t index);
+    //! metodo insere em ordem
+    void insert_sorted(const T& data);
+    //! metodo retira do fim
+    T pop_back();
+    //! metood retira do inicio
+    T pop_front();
+    //! retira especifico; false se nao encontrou
+    bool remove(const T& data);
+    //! contem
+    bool contains(const T& data) const;
+    //! visita os dados do inicio para o fim
+    template<typename F>
+    void for_each(F&& visit) const;
+    //! visita os dados do fim para o inicio
+    template<typename F>
+    void for_each_reverse(F&& visit) const;
+    //! lista vazia
+    bool empty() const;
+    //! tamanho
+    std::size_t size() const;
+
+ private:
+    //! ligacoes e lock de um nodo (a sentinela so tem esta parte)
+    class Link {
+     public:
+        //! lock deste nodo (na sentinela: protege next)
+        std::mutex& lock() const {
+            return lock_;
+        }
+        //! getter: previous
+        Link* prev() const {
+            return prev_;
+        }
+        //! setter: previous
+        void prev(Link* node) {
+            prev_ = node;
+        }
+        //! getter: next
+        Link* next() const {
+            return next_;
+        }
+        //! setter: next
+        void next(Link* node) {
+            next_ = node;
+        }
+        //! getter: nodo ja retirado da lista
+        bool removed() const {
+            return removed_;
+        }
+        //! marca nodo como retirado
+        void removed(bool removed) {
+            removed_ = removed;
+        }
+
+     private:
+        mutable std::mutex lock_;
+        Link* prev_{nullptr};
+        Link* next_{nullptr};
+        bool removed_{false};
+    };
+
+    class Node : public Link {
+     public:
+        //! construtor padrao
+        explicit Node(const T& data):
+            data_{data}
+        {}
+        //! getter: dado
+        T& data() {
+            return data_;
+        }
+        //! getter const: dado
+        const T& data() const {
+            return data_;
+        }
+
+     private:
+        T data_;
+    };
+
+    //! lock que protege node->prev
+    std::mutex& prev_lock(const Link* node) const;
+    //! liga node entre prev e next (locks de ambos ja travados)
+    void link(Node* node, Link* prev, Link* next);
+    //! desliga node (locks de prev, node e next ja travados)
+    void unlink(Link* node);
+    //! libera um nodo desligado (adiado se ha travessia reversa)
+    void retire(Node* node) const;
+    //! desliga o primeiro nodo; nullptr se a lista esta vazia
+    Node* take_front();
+    //! pausa curta antes de tentar de novo
+    static void backoff();
+
+    Link sentinel_;
+    mutable std::mutex tail_;
+    std::atomic<std::size_t> size_;
+    mutable std::atomic<std::size_t> reverse_readers_;
+    mutable std::mutex retired_lock_;
+    mutable std::vector<Node*> retired_;
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::ConcurrentDoublyCircularList<T>::ConcurrentDoublyCircularList():
+    size_{0},
+    reverse_readers_{0}
+{
+    sentinel_.next(&sentinel_);
+    sentinel_.prev(&sentinel_);
+}
+
+template<typename T>
+structures::ConcurrentDoublyCircularList<T>::~ConcurrentDoublyCircularList() {
+    clear();
+    for (Node* node : retired_) {
+        delete node;
+    }
+}
+
+template<typename T>
+std::mutex& structures::ConcurrentDoublyCircularList<T>::prev_lock(
+                                                const Link* node) const {
+    return node == &sentinel_ ? tail_ : node->lock();
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::link(Node* node,
+                                                       Link* prev,
+                                                       Link* next) {
+    node->prev(prev);
+    node->next(next);
+    prev->next(node);
+    next->prev(node);
+    size_++;
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::unlink(Link* node) {
+    node->prev()->next(node->next());
+    node->next()->prev(node->prev());
+    node->removed(true);
+    size_--;
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::retire(Node* node) const {
+    {
+        std::lock_guard<std::mutex> guard(retired_lock_);
+        if (reverse_readers_.load() != 0) {
+            retired_.push_back(node);
+            return;
+        }
+    }
+    delete node;
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::backoff() {
+    std::this_thread::yield();
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::clear() {
+    // take_front devolve nullptr se outra thread esvaziou a lista antes
+    while (Node* node = take_front()) {
+        retire(node);
+    }
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::push_front(const T& data) {
+    Node* new_element = new Node(data);
+    std::lock_guard<std::mutex> head(sentinel_.lock());
+    Link* first = sentinel_.next();
+    std::lock_guard<std::mutex> next(prev_lock(first));
+    link(new_element, &sentinel_, first);
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::push_back(const T& data) {
+    Node* new_element = new Node(data);
+    while (true) {
+        std::unique_lock<std::mutex> tail(tail_);
+        // o ultimo nao pode ser retirado enquanto seguramos tail_
+        Link* last = sentinel_.prev();
+        std::unique_lock<std::mutex> prev(last->lock(), std::try_to_lock);
+        if (prev.owns_lock()) {
+            link(new_element, last, &sentinel_);
+            return;
+        }
+        tail.unlock();
+        backoff();
+    }
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::insert(const T& data,
+                                                         std::size_t index) {
+    Node* new_element = new Node(data);
+    std::unique_lock<std::mutex> current(sentinel_.lock());
+    Link* prev = &sentinel_;
+    for (std::size_t i = 0; i < index; i++) {
+        Link* next = prev->next();
+        if (next == &sentinel_) {
+            current.unlock();
+            delete new_element;
+            raise_out_of_range("Index invalido");
+        }
+        std::unique_lock<std::mutex> following(next->lock());
+        current.swap(following);
+        prev = next;
+    }
+    Link* next = prev->next();
+    std::lock_guard<std::mutex> following(prev_lock(next));
+    link(new_element, prev, next);
+}
+
+template<typename T>
+void structures::ConcurrentDoublyCircularList<T>::insert_sorted(
+                                                        const T& data) {
+    Node* new_element = new Node(data);
+    std::unique_lock<std::mutex> current(sentinel_.lock());
+    Link* prev = &sentinel_;
+    while (true) {
+        Link* next = prev->next();
+        std::unique_lock<std::mutex> following(prev_lock(next));
+        if (next == &sentinel_ || !(data > static_cast<Node*>(next)->data())) {
+            link(new_element, prev, next);
+            return;
+        }
+        current.swap(following);
+        prev = next;
+    }
+}
+
+template<typename T>
+T structures::ConcurrentDoublyCircularList<T>::pop_front() {
+    Node* retira_elemento = take_front();
+    if (retira_elemento == nullptr) {
+        raise_out_of_range("DoublyCircularList is empty");
+    }
+    T return_data = retira_elemento->data();
+    retire(retira_elemento);
+    return return_data;
+}
+
+template<typename T>
+typename structures::ConcurrentDoublyCircularList<T>::Node*
+structures::ConcurrentDoublyCircularList<T>::take_front() {
+    std::unique_lock<std::mutex> head(sentinel_.lock());
+    Link* first = sentinel_.next();
+    if (first == &sentinel_) {
+        return nullptr;
+    }
+    std::unique_lock<std::mutex> node(first->lock());
+    std::unique_lock<std::mutex> next(prev_lock(first->next()));
+    unlink(first);
+    return static_cast<Node*>(first);
+}
+
+template<typename T>
+T structures::ConcurrentDoublyCircularList<T>::pop_back() {
+    while (true) {
+        std::unique_lock<std::mutex> tail(tail_);
+        Link* last = sentinel_.prev();
+        if (last == &sentinel_) {
+            raise_out_of_range("DoublyCircularList is empty");
+        }
+        std::unique_lock<std::mutex> node(last->lock(), std::try_to_lock);
+        if (node.owns_lock()) {
+            // last travado: seu prev nao muda nem pode ser retirado
+            std::unique_lock<std::mutex> prev(last->prev()->lock(),
+                                              std::try_to_lock);
+            if (prev.owns_lock()) {
+                unlink(last);
+                Node* retira_elemento = static_cast<Node*>(last);
+                T return_data = retira_elemento->data();
+                prev.unlock();
+                node.unlock();
+                tail.unlock();
+                retire(retira_elemento);
+                return return_data;
+            }
+        }
+        node = std::unique_lock<std::mutex>();
+        tail.unlock();
+        backoff();
+    }
+}
+
+template<typename T>
+bool structures::ConcurrentDoublyCircularList<T>::remove(const T& data) {
+    std::unique_lock<std::mutex> current(sentinel_.lock());
+    Link* prev = &sentinel_;
+    while (true) {
+        Link* candidate = prev->next();
+        if (candidate == &sentinel_) {
+            return false;
+        }
+        std::unique_lock<std::mutex> following(candidate->lock());
+        if (static_cast<Node*>(candidate)->data() == data) {
+            std::unique_lock<std::mutex> next(prev_lock(candidate->next()));
+            unlink(candidate);
+            next.unlock();
+            following.unlock();
+            current.unlock();
+            retire(static_cast<Node*>(candidate));
+            return true;
+        }
+        current.swap(following);
+        prev = candidate;
+    }
+}
+
+template<typename T>
+bool structures::ConcurrentDoublyCircularList<T>::contains(
+                                                const T& data) const {
+    std::unique_lock<std::mutex> current(sentinel_.lock());
+    const Link* node = sentinel_.next();
+    while (node != &sentinel_) {
+        std::unique_lock<std::mutex> following(node->lock());
+        current.swap(following);
+        following.unlock();
+        if (static_cast<const Node*>(node)->data() == data) {
+            return true;
+        }
+        node = node->next();
+    }
+    return false;
+}
+
+template<typename T>
+template<typename F>
+void structures::ConcurrentDoublyCircularList<T>::for_each(
+                                                    F&& visit) const {
+    std::unique_lock<std::mutex> current(sentinel_.lock());
+    const Link* node = sentinel_.next();
+    while (node != &sentinel_) {
+        std::unique_lock<std::mutex> following(node->lock());
+        current.swap(following);
+        following.unlock();
+        visit(static_cast<const Node*>(node)->data());
+        node = node->next();
+    }
+}
+
+template<typename T>
+template<typename F>
+void structures::ConcurrentDoublyCircularList<T>::for_each_reverse(
+                                                    F&& visit) const {
+    // enquanto houver leitor reverso, nodos retirados nao sao liberados:
+    // assim e' seguro travar um nodo depois de soltar o seu sucessor
+    reverse_readers_++;
+    std::unique_lock<std::mutex> current(tail_);
+    Link* node = sentinel_.prev();
+    while (node != &sentinel_) {
+        std::unique_lock<std::mutex> following(node->lock(),
+                                               std::try_to_lock);
+        if (!following.owns_lock()) {
+            current.unlock();
+            following.lock();
+        } else {
+            current.unlock();
+        }
+        current.swap(following);
+        if (node->removed()) {
+            // retirado no meio do caminho: segue pelo prev congelado
+            node = node->prev();
+            continue;
+        }
+        visit(static_cast<const Node*>(node)->data());
+        node = node->prev();
+    }
+    current.unlock();
+
+    std::vector<Node*> garbage;
+    {
+        std::lock_guard<std::mutex> guard(retired_lock_);
+        if (--reverse_readers_ == 0) {
+            garbage.swap(retired_);
+        }
+    }
+    for (Node* retired : garbage) {
+        delete retired;
+    }
+}
+
+template<typename T>
+bool structures::ConcurrentDoublyCircularList<T>::empty() const {
+    return size_.load() == 0;
+}
+
+template<typename T>
+std::size_t structures::ConcurrentDoublyCircularList<T>::size() const {
+    return size_.load();
+}
+
+#endif
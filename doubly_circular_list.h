@@ -4,13 +4,29 @@
 
 #include <cstdint>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "./error_policy.h"
 
 namespace structures {
 
 //! Classe de implementação de lista circular dupla
-template<typename T>
+/*!
+ *  Policy decide o que acontece com lista vazia ou indice invalido (veja
+ *  error_policy.h).
+ */
+template<typename T, typename Policy = ThrowPolicy>
 class DoublyCircularList {
+    class Node;
+
  public:
+    //! retorno de uma operacao que devolveria R, conforme Policy
+    template<typename R>
+    using Result = typename Policy::template result<R>;
+    //! referencia a um nodo; valida ate o nodo ser retirado
+    using Handle = Node*;
+
     //! construtor padrão de lista circular dupla
     DoublyCircularList();
     //! destrutor de lista circular
@@ -18,33 +34,69 @@ class DoublyCircularList {
     //! método para limpar a lista circular
     void clear();
     //! método para inserir dados no fim
-    void push_back(const T& data);
+    Handle push_back(const T& data);
     //! metodo insere no inicio
-    void push_front(const T& data);
+    Handle push_front(const T& data);
     //! metodo insere na posicao
-    void insert(const T& data, std::size_t index);
+    Result<void> insert(const T& data, std::size_t index);
     //! metodo insere em ordem
-    void insert_sorted(const T& data);
+    Result<void> insert_sorted(const T& data);
     //! metodo retira da posicao
-    T pop(std::size_t index);
+    Result<T> pop(std::size_t index) noexcept(nothrow_move<Policy, T>);
     //! metodo retira do fim
-    T pop_back();
+    Result<T> pop_back() noexcept(nothrow_move<Policy, T>);
     //! metood retira do inicio
-    T pop_front();
+    Result<T> pop_front() noexcept(nothrow_move<Policy, T>);
     //! retira especifico
-    void remove(const T& data);
+    Result<void> remove(const T& data);
+    //! retira do inicio em *data sem lancar; Status::EMPTY se vazia
+    Status try_pop_front(T* data)
+        noexcept(std::is_nothrow_move_constructible<T>::value &&
+                 std::is_nothrow_move_assignable<T>::value);
+    //! retira do fim em *data sem lancar; Status::EMPTY se vazia
+    Status try_pop_back(T* data)
+        noexcept(std::is_nothrow_move_constructible<T>::value &&
+                 std::is_nothrow_move_assignable<T>::value);
     //! lista vazia
     bool empty() const;
     //! contem
     bool contains(const T& data) const;
     //! acesso a um elemento (checando limites)
-    T& at(std::size_t index);
+    Result<T&> at(std::size_t index) noexcept(Policy::nothrow);
     //! getter constante a um elemento
-    const T& at(std::size_t index) const;
+    Result<const T&> at(std::size_t index) const
+        noexcept(Policy::nothrow);
     //! posição de um dado
     std::size_t find(const T& data) const;
     //! tamanho
     std::size_t size() const;
+    //! nodo do inicio
+    Result<Handle> front_handle() const noexcept(Policy::nothrow);
+    //! nodo do fim
+    Result<Handle> back_handle() const noexcept(Policy::nothrow);
+    //! dado de um nodo em O(1)
+    T& data(Handle node);
+    //! move o nodo para o inicio em O(1)
+    void move_to_front(Handle node);
+    //! retira o nodo em O(1)
+    T erase(Handle node)
+        noexcept(std::is_nothrow_move_constructible<T>::value);
+    //! move o nodo de other para o inicio desta lista, sem realocar
+    void splice_front(DoublyCircularList& other, Handle node);
+    //! intercala os nodos de other nesta lista, esvaziando other
+    /*!
+     *  As operacoes de conjunto supoem as duas listas em ordem crescente
+     *  e fazem uma passada so, religando nodos sem alocar. Repetidos
+     *  contam como em std::set_union e afins. Com a propria lista, merge
+     *  e set_union nao mudam nada.
+     */
+    void merge(DoublyCircularList& other);
+    //! uniao: move de other os nodos sem par aqui, esvaziando other
+    void set_union(DoublyCircularList& other);
+    //! mantem so os dados que tambem estao em other
+    void set_intersection(const DoublyCircularList& other);
+    //! tira desta lista os dados que estao em other
+    void set_difference(const DoublyCircularList& other);
 
  private:
     class Node {
@@ -102,6 +154,16 @@ class DoublyCircularList {
         Node* prev_;
         Node* next_;
     };
+    //! liga o nodo no inicio (ou no fim, se front e' false)
+    void link(Node* node, bool front);
+    //! desliga o nodo sem libera-lo
+    void unlink(Node* node);
+    //! religa os nodos das duas listas em ordem nesta; com unique, o
+    //! nodo de other igual a um desta e' liberado
+    void splice_sorted(DoublyCircularList* other, bool unique);
+    //! libera os nodos com (ou sem, se keep) par em other
+    void filter_sorted(const DoublyCircularList& other, bool keep);
+
     //! nodo-topo
     Node* head;
     //! tamanho
@@ -110,73 +172,80 @@ class DoublyCircularList {
 
 }  // namespace structures
 
-template<typename T>
-structures::DoublyCircularList<T>::DoublyCircularList() {
+template<typename T, typename P>
+structures::DoublyCircularList<T, P>::DoublyCircularList() {
     size_ = 0;
     head = nullptr;
 }
 
-template<typename T>
-structures::DoublyCircularList<T>::~DoublyCircularList() {
+template<typename T, typename P>
+structures::DoublyCircularList<T, P>::~DoublyCircularList() {
     clear();
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::clear() {
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::clear() {
     while (!empty()) {
         pop_front();
     }
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::push_back(const T& data) {
-    Node *new_element = new Node(data, nullptr, nullptr);
-    if (new_element == nullptr) {
-        throw std::out_of_range("DoublyCircularList Full");
-    }
-    if (!empty()) {
-        Node *temp = head->prev();
-        new_element->next(head);
-        new_element->prev(temp);
-        temp->next(new_element);
-        head->prev(new_element);
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::link(Node* node, bool front) {
+    if (empty()) {
+        node->next(node);
+        node->prev(node);
+        head = node;
     } else {
-        new_element->next(new_element);
-        new_element->prev(new_element);
-        head = new_element;
+        node->next(head);
+        node->prev(head->prev());
+        head->prev()->next(node);
+        head->prev(node);
+        if (front) {
+            head = node;
+        }
     }
     size_++;
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::push_front(const T& data) {
-    Node *new_element = new Node(data, nullptr, nullptr);
-    if (new_element == nullptr) {
-        throw std::out_of_range("DoublyCircularList Full");
-    }
-    if (size_ == 0) {
-        new_element->next(new_element);
-        new_element->prev(new_element);
-        head = new_element;
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::unlink(Node* node) {
+    if (size_ == 1) {
+        head = nullptr;
     } else {
-        new_element->next(head);
-        if (size_ == 1) {
-            new_element->prev(head);
-            head->next(new_element);
-        } else {
-            new_element->prev(head->prev());
-            head->prev()->next(new_element);
+        node->prev()->next(node->next());
+        node->next()->prev(node->prev());
+        if (node == head) {
+            head = node->next();
         }
-        head->prev(new_element);
-        head = new_element;
     }
-    size_++;
+    size_--;
+}
+
+template<typename T, typename P>
+typename structures::DoublyCircularList<T, P>::Handle
+structures::DoublyCircularList<T, P>::push_back(const T& data) {
+    Node *new_element = new Node(data, nullptr, nullptr);
+    link(new_element, false);
+    return new_element;
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::insert(const T& data,
-                                        std::size_t index) {
-    if (index > size_) throw std::out_of_range("Index invalido");
+template<typename T, typename P>
+typename structures::DoublyCircularList<T, P>::Handle
+structures::DoublyCircularList<T, P>::push_front(const T& data) {
+    Node *new_element = new Node(data, nullptr, nullptr);
+    link(new_element, true);
+    return new_element;
+}
+
+template<typename T, typename P>
+typename P::template result<void>
+structures::DoublyCircularList<T, P>::insert(const T& data,
+                                             std::size_t index) {
+    if (P::checked && index > size_) {
+        return P::template fail<void>(Status::INVALID_INDEX,
+                                      "Index invalido");
+    }
     if (index == 0) {
         push_front(data);
     } else {
@@ -187,9 +256,6 @@ void structures::DoublyCircularList<T>::insert(const T& data,
                 push_front(data);
             } else {
                Node *new_element = new Node(data, nullptr, nullptr);
-               if (new_element == nullptr) {
-                throw std::out_of_range("DoublyCircularList full");
-               }
                Node *temp = nullptr;
                size_t interval = size_/2;
                if (index <= interval) {
@@ -211,10 +277,12 @@ void structures::DoublyCircularList<T>::insert(const T& data,
             }
         }
     }
+    return typename P::template result<void>();
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::insert_sorted(const T& data) {
+template<typename T, typename P>
+typename P::template result<void>
+structures::DoublyCircularList<T, P>::insert_sorted(const T& data) {
     if (empty()) {
         push_front(data);
     } else {
@@ -224,17 +292,22 @@ void structures::DoublyCircularList<T>::insert_sorted(const T& data) {
             index++;
             temp = temp->next();
         }
-        insert(data, index);
+        return insert(data, index);
     }
+    return typename P::template result<void>();
 }
 
-template<typename T>
-T& structures::DoublyCircularList<T>::at(std::size_t index) {
-    if (empty()) {
-        throw std::out_of_range("Empty Doubly Linked List");
+template<typename T, typename P>
+typename P::template result<T&>
+structures::DoublyCircularList<T, P>::at(std::size_t index)
+    noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<T&>(Status::EMPTY,
+                                      "Empty Doubly Linked List");
     }
-    if (index >= size_) {
-        throw std::out_of_range("Invalid Index");
+    if (P::checked && index >= size_) {
+        return P::template fail<T&>(Status::INVALID_INDEX,
+                                      "Invalid Index");
     }
     Node *temp = nullptr;
     size_t interval = (size_)/ 2;
@@ -252,13 +325,17 @@ T& structures::DoublyCircularList<T>::at(std::size_t index) {
     return temp->data();
 }
 
-template<typename T>
-const T& structures::DoublyCircularList<T>::at(std::size_t index) const {
-    if (empty()) {
-        throw std::out_of_range("Empty Doubly Linked List");
+template<typename T, typename P>
+typename P::template result<const T&>
+structures::DoublyCircularList<T, P>::at(std::size_t index) const
+    noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<const T&>(Status::EMPTY,
+                                      "Empty Doubly Linked List");
     }
-    if (index >= size_) {
-        throw std::out_of_range("Invalid Index");
+    if (P::checked && index >= size_) {
+        return P::template fail<const T&>(Status::INVALID_INDEX,
+                                      "Invalid Index");
     }
     Node *temp = nullptr;
     size_t interval = (size_)/ 2;
@@ -276,13 +353,16 @@ const T& structures::DoublyCircularList<T>::at(std::size_t index) const {
     return temp->data();
 }
 
-template<typename T>
-T structures::DoublyCircularList<T>::pop(std::size_t index) {
-    if (empty()) {
-        throw std::out_of_range("DoublyCircularList is empty");
+template<typename T, typename P>
+typename P::template result<T>
+structures::DoublyCircularList<T, P>::pop(std::size_t index)
+    noexcept(nothrow_move<P, T>) {
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY,
+                                   "DoublyCircularList is empty");
     }
-    if (index >= size_) {
-        throw std::out_of_range("Index invalido");
+    if (P::checked && index >= size_) {
+        return P::template fail<T>(Status::INVALID_INDEX, "Index invalido");
     }
     if (index == 0) {
         return pop_front();
@@ -291,7 +371,6 @@ T structures::DoublyCircularList<T>::pop(std::size_t index) {
             return pop_back();
         } else {
             Node *retira_elemento = nullptr;
-            T return_data;
             size_t interval = size_/2;
             if (index <= interval) {
                 retira_elemento = head;
@@ -304,7 +383,7 @@ T structures::DoublyCircularList<T>::pop(std::size_t index) {
                     retira_elemento = retira_elemento->prev();
                 }
             }
-            return_data = retira_elemento->data();
+            T return_data = std::move(retira_elemento->data());
             retira_elemento->prev()->next(retira_elemento->next());
             retira_elemento->next()->prev(retira_elemento->prev());
             size_--;
@@ -314,21 +393,20 @@ T structures::DoublyCircularList<T>::pop(std::size_t index) {
     }
 }
 
-template<typename T>
-T structures::DoublyCircularList<T>::pop_back() {
-    if (empty()) {
-        throw std::out_of_range("DoublyCircularList is empty");
+template<typename T, typename P>
+typename P::template result<T>
+structures::DoublyCircularList<T, P>::pop_back()
+    noexcept(nothrow_move<P, T>) {
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY,
+                                   "DoublyCircularList is empty");
     }
-    Node *retira_elemento = nullptr;
-    T return_data;
+    Node *retira_elemento = head->prev();
+    T return_data = std::move(retira_elemento->data());
     if (size_ > 1) {
-        retira_elemento = head->prev();
-        return_data = retira_elemento->data();
         retira_elemento->prev()->next(head);
         head->prev(retira_elemento->prev());
     } else {
-        retira_elemento = head;
-        return_data = retira_elemento->data();
         head = nullptr;
     }
     size_--;
@@ -336,13 +414,16 @@ T structures::DoublyCircularList<T>::pop_back() {
     return return_data;
 }
 
-template<typename T>
-T structures::DoublyCircularList<T>::pop_front() {
-    if (empty()) {
-        throw std::out_of_range("DoublyCircularList is empty");
+template<typename T, typename P>
+typename P::template result<T>
+structures::DoublyCircularList<T, P>::pop_front()
+    noexcept(nothrow_move<P, T>) {
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY,
+                                   "DoublyCircularList is empty");
     }
     Node *retira_elemento = head;
-    T return_data = retira_elemento->data();
+    T return_data = std::move(retira_elemento->data());
     if (size_ > 1) {
         retira_elemento->prev()->next(retira_elemento->next());
         retira_elemento->next()->prev(retira_elemento->prev());
@@ -355,24 +436,171 @@ T structures::DoublyCircularList<T>::pop_front() {
     return return_data;
 }
 
-template<typename T>
-void structures::DoublyCircularList<T>::remove(const T& data) {
-    if (empty()) {
-        throw std::out_of_range("Circular List Empty");
+template<typename T, typename P>
+typename P::template result<void>
+structures::DoublyCircularList<T, P>::remove(const T& data) {
+    if (P::checked && empty()) {
+        return P::template fail<void>(Status::EMPTY, "Circular List Empty");
     }
     size_t index = find(data);
+    if (index == size_) {
+        if (P::checked) {
+            return P::template fail<void>(Status::NOT_FOUND,
+                                          "Index invalido");
+        }
+        return typename P::template result<void>();
+    }
     pop(index);
+    return typename P::template result<void>();
 }
 
-template<typename T>
-bool structures::DoublyCircularList<T>::empty() const {
+template<typename T, typename P>
+structures::Status
+structures::DoublyCircularList<T, P>::try_pop_front(T* data)
+    noexcept(std::is_nothrow_move_constructible<T>::value &&
+             std::is_nothrow_move_assignable<T>::value) {
+    if (empty()) {
+        return Status::EMPTY;
+    }
+    *data = erase(head);
+    return Status::OK;
+}
+
+template<typename T, typename P>
+structures::Status
+structures::DoublyCircularList<T, P>::try_pop_back(T* data)
+    noexcept(std::is_nothrow_move_constructible<T>::value &&
+             std::is_nothrow_move_assignable<T>::value) {
+    if (empty()) {
+        return Status::EMPTY;
+    }
+    *data = erase(head->prev());
+    return Status::OK;
+}
+
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::merge(DoublyCircularList& other) {
+    splice_sorted(&other, false);
+}
+
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::set_union(
+                                            DoublyCircularList& other) {
+    splice_sorted(&other, true);
+}
+
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::set_intersection(
+                                        const DoublyCircularList& other) {
+    filter_sorted(other, true);
+}
+
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::set_difference(
+                                        const DoublyCircularList& other) {
+    filter_sorted(other, false);
+}
+
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::splice_sorted(
+                                    DoublyCircularList* other, bool unique) {
+    if (other == this || other->empty()) {
+        return;
+    }
+    Node* a = head;
+    Node* b = other->head;
+    Node* last_a = empty() ? nullptr : head->prev();
+    Node* last_b = b->prev();
+    std::size_t count_a = size_;
+    std::size_t count_b = other->size_;
+    other->head = nullptr;
+    other->size_ = 0;
+    head = nullptr;
+    Node* tail = nullptr;
+    while (count_a > 0 && count_b > 0) {
+        Node* node;
+        if (b->data() < a->data()) {
+            node = b;
+            b = b->next();
+            count_b--;
+            size_++;
+        } else {
+            if (unique && !(a->data() < b->data())) {
+                Node* repetido = b;
+                b = b->next();
+                count_b--;
+                delete(repetido);
+            }
+            node = a;
+            a = a->next();
+            count_a--;
+        }
+        if (tail == nullptr) {
+            head = node;
+        } else {
+            tail->next(node);
+            node->prev(tail);
+        }
+        tail = node;
+    }
+    // a sobra de uma das listas ja esta encadeada: liga de uma vez
+    if (count_a > 0 || count_b > 0) {
+        Node* first = count_a > 0 ? a : b;
+        if (tail == nullptr) {
+            head = first;
+        } else {
+            tail->next(first);
+            first->prev(tail);
+        }
+        tail = count_a > 0 ? last_a : last_b;
+        size_ += count_b;
+    }
+    tail->next(head);
+    head->prev(tail);
+}
+
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::filter_sorted(
+                                const DoublyCircularList& other, bool keep) {
+    if (&other == this) {
+        if (!keep) {
+            clear();
+        }
+        return;
+    }
+    const Node* b = other.head;
+    std::size_t count_b = other.size_;
+    Node* atual = head;
+    std::size_t count = size_;
+    for (std::size_t i = 0; i < count; i++) {
+        Node* next = atual->next();
+        while (count_b > 0 && b->data() < atual->data()) {
+            b = b->next();
+            count_b--;
+        }
+        bool par = count_b > 0 && !(atual->data() < b->data());
+        if (par) {
+            b = b->next();
+            count_b--;
+        }
+        if (par != keep) {
+            unlink(atual);
+            delete(atual);
+        }
+        atual = next;
+    }
+}
+
+template<typename T, typename P>
+bool structures::DoublyCircularList<T, P>::empty() const {
     return (size_ == 0);
 }
 
-template <typename T>
-bool structures::DoublyCircularList<T>::contains(const T& data) const {
+template<typename T, typename P>
+bool structures::DoublyCircularList<T, P>::contains(const T& data) const {
     if (empty()) {
-        throw std::out_of_range("Empty DoublyCircularList");
+        P::report(Status::EMPTY, "Empty DoublyCircularList");
+        return false;
     }
     Node *temp = head;
     for (size_t i = 0; i < size_; i++) {
@@ -385,8 +613,8 @@ bool structures::DoublyCircularList<T>::contains(const T& data) const {
     return false;
 }
 
-template <typename T>
-std::size_t structures::DoublyCircularList<T>::find(const T& data) const {
+template<typename T, typename P>
+std::size_t structures::DoublyCircularList<T, P>::find(const T& data) const {
     Node* temp = head;
     for (size_t i = 0; i < size_; i++) {
         if (temp->data() == data) {
@@ -397,9 +625,68 @@ std::size_t structures::DoublyCircularList<T>::find(const T& data) const {
     return size_;
 }
 
-template <typename T>
-std::size_t structures::DoublyCircularList<T>::size() const {
+template<typename T, typename P>
+std::size_t structures::DoublyCircularList<T, P>::size() const {
   return size_;
 }
 
+template<typename T, typename P>
+typename P::template result<
+    typename structures::DoublyCircularList<T, P>::Handle>
+structures::DoublyCircularList<T, P>::front_handle() const
+    noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<Handle>(Status::EMPTY,
+                                        "DoublyCircularList is empty");
+    }
+    return head;
+}
+
+template<typename T, typename P>
+typename P::template result<
+    typename structures::DoublyCircularList<T, P>::Handle>
+structures::DoublyCircularList<T, P>::back_handle() const
+    noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<Handle>(Status::EMPTY,
+                                        "DoublyCircularList is empty");
+    }
+    return head->prev();
+}
+
+template<typename T, typename P>
+T& structures::DoublyCircularList<T, P>::data(Handle node) {
+    return node->data();
+}
+
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::move_to_front(Handle node) {
+    if (node == head) {
+        return;
+    }
+    if (node == head->prev()) {
+        // o ultimo vira o primeiro so girando a lista
+        head = node;
+        return;
+    }
+    unlink(node);
+    link(node, true);
+}
+
+template<typename T, typename P>
+T structures::DoublyCircularList<T, P>::erase(Handle node)
+    noexcept(std::is_nothrow_move_constructible<T>::value) {
+    T return_data = std::move(node->data());
+    unlink(node);
+    delete node;
+    return return_data;
+}
+
+template<typename T, typename P>
+void structures::DoublyCircularList<T, P>::splice_front(
+                                DoublyCircularList& other, Handle node) {
+    other.unlink(node);
+    link(node, true);
+}
+
 #endif
@@ -0,0 +1,301 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_ERROR_POLICY_H
+#define STRUCTURES_ERROR_POLICY_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>  // std::abort
+#include <optional>
+#include <stdexcept>  // C++ Exceptions
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//! 1 se o codigo e' compilado com excecoes (sem -fno-exceptions)
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define STRUCTURES_EXCEPTIONS 1
+#else
+#define STRUCTURES_EXCEPTIONS 0
+#endif
+
+namespace structures {
+
+//! resultado de uma operacao (try_* e Expected)
+enum class Status {
+    OK,
+    EMPTY,
+    FULL,
+    INVALID_INDEX,
+    NOT_FOUND,
+    READ_ONLY,
+    TOO_LONG,
+    IO_ERROR
+};
+
+//! encerra o programa com a mensagem (erro sem excecoes)
+[[noreturn]] inline void fatal_error(const char* message) {
+    std::fprintf(stderr, "structures: %s\n", message);
+    std::abort();
+}
+
+//! erro de ambiente (E/S, formato): lanca std::runtime_error ou encerra
+[[noreturn]] inline void raise_runtime_error(const std::string& message) {
+#if STRUCTURES_EXCEPTIONS
+    throw std::runtime_error(message);
+#else
+    fatal_error(message.c_str());
+#endif
+}
+
+//! pre-condicao violada (vazio, cheio, indice): lanca std::out_of_range
+//! ou encerra; usado pelos containers sem Policy
+[[noreturn]] inline void raise_out_of_range(const char* message) {
+#if STRUCTURES_EXCEPTIONS
+    throw std::out_of_range(message);
+#else
+    fatal_error(message);
+#endif
+}
+
+//! argumento invalido: lanca std::invalid_argument ou encerra
+[[noreturn]] inline void raise_invalid_argument(const char* message) {
+#if STRUCTURES_EXCEPTIONS
+    throw std::invalid_argument(message);
+#else
+    fatal_error(message);
+#endif
+}
+
+//! Valor ou codigo de erro, no estilo de std::expected
+/*!
+ *  Converte implicitamente de T (sucesso) e de Status (falha). value()
+ *  numa falha encerra o programa; teste has_value() antes.
+ */
+template<typename T>
+class Expected {
+ public:
+    //! sucesso
+    Expected(const T& value):  // NOLINT(runtime/explicit)
+        value_{value},
+        status_{Status::OK}
+    {}
+    //! sucesso (movendo)
+    Expected(T&& value):  // NOLINT(runtime/explicit)
+        value_{std::move(value)},
+        status_{Status::OK}
+    {}
+    //! falha
+    Expected(Status status):  // NOLINT(runtime/explicit)
+        status_{status}
+    {}
+    //! verifica se ha valor
+    bool has_value() const {
+        return status_ == Status::OK;
+    }
+    //! verifica se ha valor
+    explicit operator bool() const {
+        return has_value();
+    }
+    //! codigo (Status::OK no sucesso)
+    Status error() const {
+        return status_;
+    }
+    //! valor
+    T& value() {
+        if (!has_value()) {
+            fatal_error("Expected sem valor");
+        }
+        return *value_;
+    }
+    //! valor
+    const T& value() const {
+        if (!has_value()) {
+            fatal_error("Expected sem valor");
+        }
+        return *value_;
+    }
+    //! valor (sem verificar)
+    T& operator*() {
+        return *value_;
+    }
+    //! valor (sem verificar)
+    T* operator->() {
+        return &*value_;
+    }
+
+ private:
+    std::optional<T> value_;
+    Status status_;
+};
+
+//! referencia ou codigo de erro
+template<typename T>
+class Expected<T&> {
+ public:
+    //! sucesso
+    Expected(T& value):  // NOLINT(runtime/explicit)
+        value_{&value},
+        status_{Status::OK}
+    {}
+    //! falha
+    Expected(Status status):  // NOLINT(runtime/explicit)
+        value_{nullptr},
+        status_{status}
+    {}
+    //! verifica se ha valor
+    bool has_value() const {
+        return status_ == Status::OK;
+    }
+    //! verifica se ha valor
+    explicit operator bool() const {
+        return has_value();
+    }
+    //! codigo (Status::OK no sucesso)
+    Status error() const {
+        return status_;
+    }
+    //! referencia
+    T& value() const {
+        if (!has_value()) {
+            fatal_error("Expected sem valor");
+        }
+        return *value_;
+    }
+    //! referencia (sem verificar)
+    T& operator*() const {
+        return *value_;
+    }
+    //! referencia (sem verificar)
+    T* operator->() const {
+        return value_;
+    }
+
+ private:
+    T* value_;
+    Status status_;
+};
+
+//! so o codigo de erro
+template<>
+class Expected<void> {
+ public:
+    //! sucesso
+    Expected():
+        status_{Status::OK}
+    {}
+    //! falha
+    Expected(Status status):  // NOLINT(runtime/explicit)
+        status_{status}
+    {}
+    //! verifica se deu certo
+    bool has_value() const {
+        return status_ == Status::OK;
+    }
+    //! verifica se deu certo
+    explicit operator bool() const {
+        return has_value();
+    }
+    //! codigo (Status::OK no sucesso)
+    Status error() const {
+        return status_;
+    }
+
+ private:
+    Status status_;
+};
+
+//! Politica padrao: erros lancam std::out_of_range
+/*!
+ *  Status::IO_ERROR lanca std::runtime_error, como os demais erros de
+ *  ambiente. Compilado com -fno-exceptions, encerra o programa com a
+ *  mensagem (como a biblioteca padrao faz nesse modo).
+ */
+struct ThrowPolicy {
+    //! tipo de retorno de uma operacao que devolveria R
+    template<typename R>
+    using result = R;
+    //! verifica pre-condicoes
+    static const bool checked = true;
+    //! falhas nunca lancam (so sem excecoes)
+    static const bool nothrow = !STRUCTURES_EXCEPTIONS;
+    //! falha de uma operacao que devolveria R
+    template<typename R>
+    [[noreturn]] static R fail(Status status, const char* message) {
+        if (status == Status::IO_ERROR) {
+            raise_runtime_error(message);
+        }
+        raise_out_of_range(message);
+    }
+    //! falha de uma operacao sem valor de erro (p.ex. contains)
+    [[noreturn]] static void report(Status status, const char* message) {
+        fail<void>(status, message);
+    }
+};
+
+//! Politica sem excecoes: operacoes devolvem Expected<R>
+struct ExpectedPolicy {
+    //! tipo de retorno de uma operacao que devolveria R
+    template<typename R>
+    using result = Expected<R>;
+    //! verifica pre-condicoes
+    static const bool checked = true;
+    //! falhas nunca lancam
+    static const bool nothrow = true;
+    //! falha de uma operacao que devolveria R
+    template<typename R>
+    static Expected<R> fail(Status status, const char*) {
+        return Expected<R>(status);
+    }
+    //! falha de uma operacao sem valor de erro: segue com o padrao
+    static void report(Status, const char*) {}
+};
+
+//! Politica sem verificacao: pre-condicoes so checadas em debug
+/*!
+ *  Com NDEBUG os testes de vazio/cheio/indice somem do caminho quente;
+ *  sem NDEBUG uma violacao encerra o programa com a mensagem, como assert.
+ */
+struct UncheckedPolicy {
+    //! tipo de retorno de uma operacao que devolveria R
+    template<typename R>
+    using result = R;
+#ifdef NDEBUG
+    static const bool checked = false;
+#else
+    static const bool checked = true;
+#endif
+    //! falhas nunca lancam (encerram o programa)
+    static const bool nothrow = true;
+    //! violacao de pre-condicao (so alcancavel em debug)
+    template<typename R>
+    [[noreturn]] static R fail(Status, const char* message) {
+        fatal_error(message);
+    }
+    //! violacao de pre-condicao (so alcancavel em debug)
+    static void report(Status, const char* message) {
+        if (checked) {
+            fatal_error(message);
+        }
+    }
+};
+
+//! operacao que so move T e so falha pela Policy nao lanca
+/*!
+ *  Usado nas especificacoes noexcept dos conteineres: com ExpectedPolicy,
+ *  UncheckedPolicy ou -fno-exceptions, pop/dequeue de um T com movimento
+ *  noexcept nao lancam.
+ */
+template<typename Policy, typename T>
+constexpr bool nothrow_move = Policy::nothrow &&
+    std::is_nothrow_move_constructible<T>::value &&
+    std::is_nothrow_move_assignable<T>::value;
+
+//! operacao que copia (e move) T e so falha pela Policy nao lanca
+template<typename Policy, typename T>
+constexpr bool nothrow_copy = nothrow_move<Policy, T> &&
+    std::is_nothrow_copy_constructible<T>::value &&
+    std::is_nothrow_copy_assignable<T>::value;
+
+}  // namespace structures
+
+#endif
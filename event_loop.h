@@ -0,0 +1,154 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_EVENT_LOOP_H
+#define STRUCTURES_EVENT_LOOP_H
+
+#include <coroutine>  // C++20
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <utility>
+
+#include "./linked_queue.h"
+
+namespace structures {
+
+//! Classe laco de eventos de uma unica thread para corrotinas
+/*!
+ *  Guarda corrotinas prontas numa LinkedQueue e as retoma em ordem FIFO
+ *  quando run() e' chamado. executor() entrega uma funcao que so posta,
+ *  para AsyncQueue acordar esperas sem recursao. Nao e' sincronizado.
+ */
+class EventLoop {
+ public:
+    //! corrotina disparada no laco; se destroi ao terminar
+    class Task {
+     public:
+        struct promise_type {
+            Task get_return_object() {
+                return Task(
+                    std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+            void return_void() {}
+            void unhandled_exception() {
+                std::terminate();
+            }
+        };
+
+        //! construtor de movimento
+        Task(Task&& other);
+        //! destrutor (destroi a corrotina se nunca foi disparada)
+        ~Task();
+
+     private:
+        friend class EventLoop;
+        explicit Task(std::coroutine_handle<promise_type> handle);
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    //! construtor padrão
+    EventLoop();
+    //! destrutor (destroi corrotinas que nunca rodaram)
+    ~EventLoop();
+    //! agenda a retomada de handle
+    void post(std::coroutine_handle<> handle);
+    //! agenda uma Task para comecar a rodar
+    void spawn(Task task);
+    //! retoma uma corrotina; false se nao havia nenhuma pronta
+    bool run_one();
+    //! roda ate nao haver corrotinas prontas; devolve quantas retomou
+    std::size_t run();
+    //! numero de corrotinas prontas
+    std::size_t pending() const;
+    //! funcao que posta neste laco (valida enquanto o laco existir)
+    std::function<void(std::coroutine_handle<>)> executor();
+
+ private:
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    LinkedQueue<std::coroutine_handle<>> ready_;
+    LinkedQueue<std::coroutine_handle<>> spawned_;  // ainda nao iniciadas
+};
+
+}  // namespace structures
+
+inline structures::EventLoop::Task::Task(
+                        std::coroutine_handle<promise_type> handle):
+    handle_{handle}
+{}
+
+inline structures::EventLoop::Task::Task(Task&& other):
+    handle_{other.handle_}
+{
+    other.handle_ = nullptr;
+}
+
+inline structures::EventLoop::Task::~Task() {
+    if (handle_) {
+        handle_.destroy();
+    }
+}
+
+inline structures::EventLoop::EventLoop() {}
+
+inline structures::EventLoop::~EventLoop() {
+    // so corrotinas que nunca comecaram sao do laco; as demais estao
+    // suspensas em algum awaiter, que e' dono delas
+    while (!spawned_.empty()) {
+        std::coroutine_handle<> handle = spawned_.dequeue();
+        if (handle) {
+            handle.destroy();
+        }
+    }
+}
+
+inline void structures::EventLoop::post(std::coroutine_handle<> handle) {
+    ready_.enqueue(handle);
+}
+
+inline void structures::EventLoop::spawn(Task task) {
+    std::coroutine_handle<> handle = task.handle_;
+    task.handle_ = nullptr;
+    spawned_.enqueue(handle);
+    ready_.enqueue(std::coroutine_handle<>());  // marca: iniciar uma Task
+}
+
+inline bool structures::EventLoop::run_one() {
+    if (ready_.empty()) {
+        return false;
+    }
+    std::coroutine_handle<> handle = ready_.dequeue();
+    if (!handle) {
+        handle = spawned_.dequeue();
+    }
+    handle.resume();
+    return true;
+}
+
+inline std::size_t structures::EventLoop::run() {
+    std::size_t count = 0;
+    while (run_one()) {
+        count++;
+    }
+    return count;
+}
+
+inline std::size_t structures::EventLoop::pending() const {
+    return ready_.size();
+}
+
+inline std::function<void(std::coroutine_handle<>)>
+structures::EventLoop::executor() {
+    return [this](std::coroutine_handle<> handle) { post(handle); };
+}
+
+#endif
@@ -0,0 +1,229 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_FRONT_CODED_STRING_LIST_H
+#define STRUCTURES_FRONT_CODED_STRING_LIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "./error_policy.h"
+#include "./string_list.h"
+
+namespace structures {
+
+//! Classe de lista de strings ordenada e congelada, com front coding
+/*!
+ *  As strings sao agrupadas em blocos de block_size. A primeira de cada
+ *  bloco (cabeca) fica inteira; as demais guardam so o tamanho do prefixo
+ *  comum com a anterior e o sufixo restante, todos os numeros em varint.
+ *  find faz busca binaria nas cabecas e percorre um unico bloco; at(i)
+ *  decodifica so o bloco de i. Somente leitura.
+ */
+class FrontCodedStringList {
+ public:
+    //! congela uma lista ordenada (std::invalid_argument se nao estiver)
+    explicit FrontCodedStringList(const ArrayListString& sorted,
+                                  std::size_t block_size = 16);
+    //! string na posicao index
+    std::string at(std::size_t index) const;
+    //! posicao da primeira ocorrencia, ou size()
+    std::size_t find(std::string_view data) const;
+    //! verifica se ha dado x
+    bool contains(std::string_view data) const;
+    //! chama f(string_view) para cada string, em ordem
+    template<typename F>
+    void for_each(F&& f) const;
+    //! numero de strings
+    std::size_t size() const;
+    //! lista vazia
+    bool empty() const;
+    //! strings por bloco
+    std::size_t block_size() const;
+    //! bytes ocupados (dados codificados e cabecas)
+    std::size_t memory_usage() const;
+
+ private:
+    //! grava value em varint
+    static void put_varint(std::vector<char> *out, std::size_t value);
+    //! le varint em *position, avancando
+    std::size_t get_varint(std::size_t *position) const;
+    //! cabeca do bloco (sem copia)
+    std::string_view head(std::size_t block) const;
+
+    std::vector<char> data_;
+    std::vector<std::size_t> heads_;  // inicio de cada bloco em data_
+    std::size_t size_;
+    std::size_t block_size_;
+};
+
+}  // namespace structures
+
+inline structures::FrontCodedStringList::FrontCodedStringList(
+                                            const ArrayListString& sorted,
+                                            std::size_t block_size) {
+    if (block_size == 0) {
+        raise_invalid_argument("bloco vazio");
+    }
+    size_ = sorted.size();
+    block_size_ = block_size;
+    heads_.reserve((size_ + block_size - 1) / block_size);
+    std::string_view previous;
+    for (std::size_t i = 0; i < size_; i++) {
+        std::string_view current(sorted[i]);
+        if (i > 0 && previous.compare(current) > 0) {
+            raise_invalid_argument("lista nao ordenada");
+        }
+        if (i % block_size == 0) {
+            heads_.push_back(data_.size());
+            put_varint(&data_, current.size());
+            data_.insert(data_.end(), current.begin(), current.end());
+        } else {
+            std::size_t common = 0;
+            std::size_t limit = std::min(previous.size(), current.size());
+            while (common < limit && previous[common] == current[common]) {
+                common++;
+            }
+            put_varint(&data_, common);
+            put_varint(&data_, current.size() - common);
+            data_.insert(data_.end(), current.begin() + common,
+                         current.end());
+        }
+        previous = current;
+    }
+    data_.shrink_to_fit();
+}
+
+inline void structures::FrontCodedStringList::put_varint(std::vector<char> *out,
+                                                  std::size_t value) {
+    while (value >= 0x80) {
+        out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out->push_back(static_cast<char>(value));
+}
+
+inline std::size_t structures::FrontCodedStringList::get_varint(
+                                        std::size_t *position) const {
+    std::size_t value = 0;
+    for (std::size_t shift = 0;; shift += 7) {
+        unsigned char byte = static_cast<unsigned char>(data_[(*position)++]);
+        value |= static_cast<std::size_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+}
+
+inline std::string_view structures::FrontCodedStringList::head(
+                                        std::size_t block) const {
+    std::size_t position = heads_[block];
+    std::size_t length = get_varint(&position);
+    return std::string_view(data_.data() + position, length);
+}
+
+inline std::string
+structures::FrontCodedStringList::at(std::size_t index) const {
+    if (index >= size_) {
+        raise_out_of_range("index invalido");
+    }
+    std::size_t block = index / block_size_;
+    std::size_t position = heads_[block];
+    std::size_t length = get_varint(&position);
+    std::string current(data_.data() + position, length);
+    position += length;
+    for (std::size_t i = block * block_size_; i < index; i++) {
+        std::size_t common = get_varint(&position);
+        std::size_t suffix = get_varint(&position);
+        current.resize(common);
+        current.append(data_.data() + position, suffix);
+        position += suffix;
+    }
+    return current;
+}
+
+inline std::size_t structures::FrontCodedStringList::find(
+                                        std::string_view data) const {
+    // primeiro bloco cuja cabeca nao e' menor que data
+    std::size_t low = 0;
+    std::size_t high = heads_.size();
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        if (head(middle).compare(data) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    // a primeira ocorrencia esta no bloco anterior (depois da cabeca) ou
+    // e' a propria cabeca do bloco low
+    if (low > 0) {
+        std::size_t block = low - 1;
+        std::size_t position = heads_[block];
+        std::size_t length = get_varint(&position);
+        std::string current(data_.data() + position, length);
+        position += length;
+        std::size_t end = std::min(size_, (block + 1) * block_size_);
+        for (std::size_t i = block * block_size_ + 1; i < end; i++) {
+            std::size_t common = get_varint(&position);
+            std::size_t suffix = get_varint(&position);
+            current.resize(common);
+            current.append(data_.data() + position, suffix);
+            position += suffix;
+            int comparison = std::string_view(current).compare(data);
+            if (comparison == 0) {
+                return i;
+            }
+            if (comparison > 0) {
+                return size_;
+            }
+        }
+    }
+    if (low < heads_.size() && head(low) == data) {
+        return low * block_size_;
+    }
+    return size_;
+}
+
+inline bool
+structures::FrontCodedStringList::contains(std::string_view data) const {
+    return find(data) != size_;
+}
+
+template<typename F>
+void structures::FrontCodedStringList::for_each(F&& f) const {
+    std::string current;
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < size_; i++) {
+        std::size_t common = 0;
+        if (i % block_size_ != 0) {
+            common = get_varint(&position);
+        }
+        std::size_t suffix = get_varint(&position);
+        current.resize(common);
+        current.append(data_.data() + position, suffix);
+        position += suffix;
+        f(std::string_view(current));
+    }
+}
+
+inline std::size_t structures::FrontCodedStringList::size() const {
+    return size_;
+}
+
+inline bool structures::FrontCodedStringList::empty() const {
+    return size_ == 0;
+}
+
+inline std::size_t structures::FrontCodedStringList::block_size() const {
+    return block_size_;
+}
+
+inline std::size_t structures::FrontCodedStringList::memory_usage() const {
+    return data_.capacity() + heads_.capacity() * sizeof(std::size_t);
+}
+
+#endif
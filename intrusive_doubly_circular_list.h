@@ -0,0 +1,228 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_INTRUSIVE_DOUBLY_CIRCULAR_LIST_H
+#define STRUCTURES_INTRUSIVE_DOUBLY_CIRCULAR_LIST_H
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "./error_policy.h"
+#include "./intrusive_hooks.h"
+
+namespace structures {
+
+//! Classe de lista circular dupla intrusiva
+/*!
+ *  Encadeia objetos pelo gancho Hook em volta de um gancho sentinela, sem
+ *  alocar nada e sem casos especiais nas pontas. A lista nao e' dona dos
+ *  objetos; erase e move_to_front sao O(1). Um gancho desligado tem
+ *  next() nulo, entao linked(objeto) diz se ele esta em alguma lista.
+ */
+template<typename T, ListHook T::*Hook>
+class IntrusiveDoublyCircularList {
+ public:
+    //! construtor padrão
+    IntrusiveDoublyCircularList();
+    //! destrutor (desliga os objetos)
+    ~IntrusiveDoublyCircularList();
+    //! desliga todos os objetos
+    void clear();
+    //! insere no fim
+    void push_back(T& item);
+    //! insere no inicio
+    void push_front(T& item);
+    //! insere item logo antes de position
+    void insert_before(T& position, T& item);
+    //! retira do inicio
+    T& pop_front();
+    //! retira do fim
+    T& pop_back();
+    //! retira o objeto em O(1) (precisa estar nesta lista)
+    void erase(T& item);
+    //! move o objeto para o inicio em O(1)
+    void move_to_front(T& item);
+    //! primeiro objeto
+    T& front() const;
+    //! ultimo objeto
+    T& back() const;
+    //! verifica se o objeto (por endereco) esta na lista
+    bool contains(const T& item) const;
+    //! verifica se o gancho do objeto esta ligado a alguma lista
+    static bool linked(const T& item);
+    //! chama f(objeto) do inicio ao fim
+    template<typename F>
+    void for_each(F&& f) const;
+    //! lista vazia
+    bool empty() const;
+    //! tamanho
+    std::size_t size() const;
+
+ private:
+    IntrusiveDoublyCircularList(const IntrusiveDoublyCircularList&) = delete;
+    IntrusiveDoublyCircularList& operator=(
+                                const IntrusiveDoublyCircularList&) = delete;
+    //! liga node antes de next
+    void link(ListHook* node, ListHook* next);
+    //! desliga o gancho
+    void unlink(ListHook* node);
+
+    ListHook sentinel_;  // next = primeiro, prev = ultimo
+    std::size_t size_;
+};
+
+}  // namespace structures
+
+template<typename T, structures::ListHook T::*Hook>
+structures::IntrusiveDoublyCircularList<T, Hook>::
+IntrusiveDoublyCircularList() {
+    sentinel_.prev(&sentinel_);
+    sentinel_.next(&sentinel_);
+    size_ = 0;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+structures::IntrusiveDoublyCircularList<T, Hook>::
+~IntrusiveDoublyCircularList() {
+    clear();
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyCircularList<T, Hook>::clear() {
+    ListHook* it = sentinel_.next();
+    while (it != &sentinel_) {
+        ListHook* next = it->next();
+        it->prev(nullptr);
+        it->next(nullptr);
+        it = next;
+    }
+    sentinel_.prev(&sentinel_);
+    sentinel_.next(&sentinel_);
+    size_ = 0;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyCircularList<T, Hook>::link(ListHook* node,
+                                                            ListHook* next) {
+    node->prev(next->prev());
+    node->next(next);
+    next->prev()->next(node);
+    next->prev(node);
+    size_++;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyCircularList<T, Hook>::unlink(
+                                                        ListHook* node) {
+    node->prev()->next(node->next());
+    node->next()->prev(node->prev());
+    node->prev(nullptr);
+    node->next(nullptr);
+    size_--;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyCircularList<T, Hook>::push_back(T& item) {
+    link(&(item.*Hook), &sentinel_);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyCircularList<T, Hook>::push_front(T& item) {
+    link(&(item.*Hook), sentinel_.next());
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyCircularList<T, Hook>::insert_before(
+                                                T& position, T& item) {
+    link(&(item.*Hook), &(position.*Hook));
+}
+
+template<typename T, structures::ListHook T::*Hook>
+T& structures::IntrusiveDoublyCircularList<T, Hook>::pop_front() {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    ListHook* node = sentinel_.next();
+    unlink(node);
+    return *hook_owner(node, Hook);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+T& structures::IntrusiveDoublyCircularList<T, Hook>::pop_back() {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    ListHook* node = sentinel_.prev();
+    unlink(node);
+    return *hook_owner(node, Hook);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyCircularList<T, Hook>::erase(T& item) {
+    if (!linked(item)) {
+        raise_out_of_range("objeto fora da lista");
+    }
+    unlink(&(item.*Hook));
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyCircularList<T, Hook>::move_to_front(
+                                                                T& item) {
+    ListHook* node = &(item.*Hook);
+    if (sentinel_.next() == node) {
+        return;
+    }
+    unlink(node);
+    link(node, sentinel_.next());
+}
+
+template<typename T, structures::ListHook T::*Hook>
+T& structures::IntrusiveDoublyCircularList<T, Hook>::front() const {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    return *hook_owner(sentinel_.next(), Hook);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+T& structures::IntrusiveDoublyCircularList<T, Hook>::back() const {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    return *hook_owner(sentinel_.prev(), Hook);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+bool structures::IntrusiveDoublyCircularList<T, Hook>::contains(
+                                                    const T& item) const {
+    const ListHook* node = &(item.*Hook);
+    for (ListHook* it = sentinel_.next(); it != &sentinel_; it = it->next()) {
+        if (it == node) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+bool structures::IntrusiveDoublyCircularList<T, Hook>::linked(const T& item) {
+    return (item.*Hook).next() != nullptr;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+template<typename F>
+void structures::IntrusiveDoublyCircularList<T, Hook>::for_each(F&& f) const {
+    for (ListHook* it = sentinel_.next(); it != &sentinel_; it = it->next()) {
+        f(*hook_owner(it, Hook));
+    }
+}
+
+template<typename T, structures::ListHook T::*Hook>
+bool structures::IntrusiveDoublyCircularList<T, Hook>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+std::size_t structures::IntrusiveDoublyCircularList<T, Hook>::size() const {
+    return size_;
+}
+
+#endif
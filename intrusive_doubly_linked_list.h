@@ -0,0 +1,238 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_INTRUSIVE_DOUBLY_LINKED_LIST_H
+#define STRUCTURES_INTRUSIVE_DOUBLY_LINKED_LIST_H
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "./error_policy.h"
+#include "./intrusive_hooks.h"
+
+namespace structures {
+
+//! Classe de lista duplamente encadeada intrusiva
+/*!
+ *  Encadeia objetos que ja existem pelo gancho Hook, sem alocar nada. A
+ *  lista nao e' dona dos objetos; erase(objeto) e' O(1).
+ */
+template<typename T, ListHook T::*Hook>
+class IntrusiveDoublyLinkedList {
+ public:
+    //! construtor padrão
+    IntrusiveDoublyLinkedList();
+    //! destrutor (desliga os objetos)
+    ~IntrusiveDoublyLinkedList();
+    //! desliga todos os objetos
+    void clear();
+    //! insere no fim
+    void push_back(T& item);
+    //! insere no inicio
+    void push_front(T& item);
+    //! insere item logo antes de position
+    void insert_before(T& position, T& item);
+    //! retira do inicio
+    T& pop_front();
+    //! retira do fim
+    T& pop_back();
+    //! retira o objeto em O(1) (precisa estar nesta lista)
+    void erase(T& item);
+    //! primeiro objeto
+    T& front() const;
+    //! ultimo objeto
+    T& back() const;
+    //! verifica se o objeto (por endereco) esta na lista
+    bool contains(const T& item) const;
+    //! chama f(objeto) do inicio ao fim
+    template<typename F>
+    void for_each(F&& f) const;
+    //! chama f(objeto) do fim ao inicio
+    template<typename F>
+    void for_each_reverse(F&& f) const;
+    //! lista vazia
+    bool empty() const;
+    //! tamanho
+    std::size_t size() const;
+
+ private:
+    IntrusiveDoublyLinkedList(const IntrusiveDoublyLinkedList&) = delete;
+    IntrusiveDoublyLinkedList& operator=(
+                                const IntrusiveDoublyLinkedList&) = delete;
+    //! desliga o gancho
+    void unlink(ListHook* node);
+
+    ListHook* head;
+    ListHook* tail;
+    std::size_t size_;
+};
+
+}  // namespace structures
+
+template<typename T, structures::ListHook T::*Hook>
+structures::IntrusiveDoublyLinkedList<T, Hook>::IntrusiveDoublyLinkedList() {
+    head = nullptr;
+    tail = nullptr;
+    size_ = 0;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+structures::IntrusiveDoublyLinkedList<T, Hook>::~IntrusiveDoublyLinkedList() {
+    clear();
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyLinkedList<T, Hook>::clear() {
+    while (head != nullptr) {
+        ListHook* next = head->next();
+        head->prev(nullptr);
+        head->next(nullptr);
+        head = next;
+    }
+    tail = nullptr;
+    size_ = 0;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyLinkedList<T, Hook>::push_back(T& item) {
+    ListHook* node = &(item.*Hook);
+    node->prev(tail);
+    node->next(nullptr);
+    if (empty()) {
+        head = node;
+    } else {
+        tail->next(node);
+    }
+    tail = node;
+    size_++;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyLinkedList<T, Hook>::push_front(T& item) {
+    ListHook* node = &(item.*Hook);
+    node->prev(nullptr);
+    node->next(head);
+    if (empty()) {
+        tail = node;
+    } else {
+        head->prev(node);
+    }
+    head = node;
+    size_++;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyLinkedList<T, Hook>::insert_before(
+                                                T& position, T& item) {
+    ListHook* next = &(position.*Hook);
+    if (next == head) {
+        push_front(item);
+        return;
+    }
+    ListHook* node = &(item.*Hook);
+    node->prev(next->prev());
+    node->next(next);
+    next->prev()->next(node);
+    next->prev(node);
+    size_++;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyLinkedList<T, Hook>::unlink(ListHook* node) {
+    if (node->prev() == nullptr) {
+        head = node->next();
+    } else {
+        node->prev()->next(node->next());
+    }
+    if (node->next() == nullptr) {
+        tail = node->prev();
+    } else {
+        node->next()->prev(node->prev());
+    }
+    node->prev(nullptr);
+    node->next(nullptr);
+    size_--;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+T& structures::IntrusiveDoublyLinkedList<T, Hook>::pop_front() {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    ListHook* node = head;
+    unlink(node);
+    return *hook_owner(node, Hook);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+T& structures::IntrusiveDoublyLinkedList<T, Hook>::pop_back() {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    ListHook* node = tail;
+    unlink(node);
+    return *hook_owner(node, Hook);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+void structures::IntrusiveDoublyLinkedList<T, Hook>::erase(T& item) {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    unlink(&(item.*Hook));
+}
+
+template<typename T, structures::ListHook T::*Hook>
+T& structures::IntrusiveDoublyLinkedList<T, Hook>::front() const {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    return *hook_owner(head, Hook);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+T& structures::IntrusiveDoublyLinkedList<T, Hook>::back() const {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    return *hook_owner(tail, Hook);
+}
+
+template<typename T, structures::ListHook T::*Hook>
+bool structures::IntrusiveDoublyLinkedList<T, Hook>::contains(
+                                                    const T& item) const {
+    const ListHook* node = &(item.*Hook);
+    for (ListHook* it = head; it != nullptr; it = it->next()) {
+        if (it == node) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+template<typename F>
+void structures::IntrusiveDoublyLinkedList<T, Hook>::for_each(F&& f) const {
+    for (ListHook* it = head; it != nullptr; it = it->next()) {
+        f(*hook_owner(it, Hook));
+    }
+}
+
+template<typename T, structures::ListHook T::*Hook>
+template<typename F>
+void structures::IntrusiveDoublyLinkedList<T, Hook>::for_each_reverse(
+                                                            F&& f) const {
+    for (ListHook* it = tail; it != nullptr; it = it->prev()) {
+        f(*hook_owner(it, Hook));
+    }
+}
+
+template<typename T, structures::ListHook T::*Hook>
+bool structures::IntrusiveDoublyLinkedList<T, Hook>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, structures::ListHook T::*Hook>
+std::size_t structures::IntrusiveDoublyLinkedList<T, Hook>::size() const {
+    return size_;
+}
+
+#endif
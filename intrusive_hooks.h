@@ -0,0 +1,99 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_INTRUSIVE_HOOKS_H
+#define STRUCTURES_INTRUSIVE_HOOKS_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace structures {
+
+//! Gancho de lista simplesmente encadeada, embutido no objeto do usuario
+/*!
+ *  Um objeto pode estar em varias listas ao mesmo tempo, um gancho por
+ *  lista. Copiar o objeto nao copia os encadeamentos.
+ */
+class SListHook {
+ public:
+    //! gancho desligado
+    SListHook() {}
+    //! copia nao herda encadeamento
+    SListHook(const SListHook&) {}
+    //! atribuicao mantem o encadeamento atual
+    SListHook& operator=(const SListHook&) {
+        return *this;
+    }
+    //! proximo gancho
+    SListHook* next() const {
+        return next_;
+    }
+    //! setter: proximo
+    void next(SListHook* hook) {
+        next_ = hook;
+    }
+
+ private:
+    SListHook* next_{nullptr};
+};
+
+//! Gancho de lista duplamente encadeada, embutido no objeto do usuario
+class ListHook {
+ public:
+    //! gancho desligado
+    ListHook() {}
+    //! copia nao herda encadeamento
+    ListHook(const ListHook&) {}
+    //! atribuicao mantem o encadeamento atual
+    ListHook& operator=(const ListHook&) {
+        return *this;
+    }
+    //! gancho anterior
+    ListHook* prev() const {
+        return prev_;
+    }
+    //! setter: anterior
+    void prev(ListHook* hook) {
+        prev_ = hook;
+    }
+    //! proximo gancho
+    ListHook* next() const {
+        return next_;
+    }
+    //! setter: proximo
+    void next(ListHook* hook) {
+        next_ = hook;
+    }
+
+ private:
+    ListHook* prev_{nullptr};
+    ListHook* next_{nullptr};
+};
+
+//! deslocamento de member dentro de T, o mesmo de offsetof
+/*!
+ *  T precisa ter layout padrao, como em offsetof. No ABI Itanium (GCC,
+ *  Clang) o ponteiro para membro de dado e' o proprio deslocamento: basta
+ *  ler sua representacao, sem formar nenhum objeto T. Com member
+ *  constante o compilador reduz tudo a uma subtracao.
+ */
+template<typename T, typename H>
+std::ptrdiff_t hook_offset(H T::*member) {
+    static_assert(std::is_standard_layout<T>::value,
+                  "ganchos intrusivos exigem T com layout padrao");
+    static_assert(sizeof(member) == sizeof(std::ptrdiff_t),
+                  "ponteiro para membro fora do ABI Itanium");
+    std::ptrdiff_t offset;
+    std::memcpy(&offset, &member, sizeof(offset));
+    return offset;
+}
+
+//! objeto que contem o gancho hook no membro member
+template<typename T, typename H>
+T* hook_owner(H* hook, H T::*member) {
+    return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(hook) -
+                                hook_offset(member));
+}
+
+}  // namespace structures
+
+#endif
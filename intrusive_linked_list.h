@@ -0,0 +1,223 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_INTRUSIVE_LINKED_LIST_H
+#define STRUCTURES_INTRUSIVE_LINKED_LIST_H
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "./error_policy.h"
+#include "./intrusive_hooks.h"
+
+namespace structures {
+
+//! Classe de lista encadeada intrusiva
+/*!
+ *  Encadeia objetos que ja existem pelo gancho Hook, sem alocar nada. A
+ *  lista nao e' dona dos objetos: clear e pop apenas os desligam. Sem
+ *  ponteiro para o anterior, remove(objeto) e' O(n); use a versao dupla
+ *  para retirada O(1).
+ */
+template<typename T, SListHook T::*Hook>
+class IntrusiveLinkedList {
+ public:
+    //! construtor padrão
+    IntrusiveLinkedList();
+    //! destrutor (desliga os objetos)
+    ~IntrusiveLinkedList();
+    //! desliga todos os objetos
+    void clear();
+    //! insere no fim
+    void push_back(T& item);
+    //! insere no inicio
+    void push_front(T& item);
+    //! insere item logo depois de position
+    void insert_after(T& position, T& item);
+    //! retira do inicio
+    T& pop_front();
+    //! retira o objeto; false se nao esta na lista
+    bool remove(T& item);
+    //! primeiro objeto
+    T& front() const;
+    //! ultimo objeto
+    T& back() const;
+    //! verifica se o objeto (por endereco) esta na lista
+    bool contains(const T& item) const;
+    //! chama f(objeto) do inicio ao fim
+    template<typename F>
+    void for_each(F&& f) const;
+    //! lista vazia
+    bool empty() const;
+    //! tamanho
+    std::size_t size() const;
+
+ private:
+    IntrusiveLinkedList(const IntrusiveLinkedList&) = delete;
+    IntrusiveLinkedList& operator=(const IntrusiveLinkedList&) = delete;
+    //! gancho do objeto
+    static SListHook* hook(T& item);
+    //! objeto dono do gancho
+    static T& owner(SListHook* hook);
+
+    SListHook* head;
+    SListHook* tail;
+    std::size_t size_;
+};
+
+}  // namespace structures
+
+template<typename T, structures::SListHook T::*Hook>
+structures::IntrusiveLinkedList<T, Hook>::IntrusiveLinkedList() {
+    head = nullptr;
+    tail = nullptr;
+    size_ = 0;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+structures::IntrusiveLinkedList<T, Hook>::~IntrusiveLinkedList() {
+    clear();
+}
+
+template<typename T, structures::SListHook T::*Hook>
+structures::SListHook* structures::IntrusiveLinkedList<T, Hook>::hook(
+                                                                T& item) {
+    return &(item.*Hook);
+}
+
+template<typename T, structures::SListHook T::*Hook>
+T& structures::IntrusiveLinkedList<T, Hook>::owner(SListHook* hook) {
+    return *hook_owner(hook, Hook);
+}
+
+template<typename T, structures::SListHook T::*Hook>
+void structures::IntrusiveLinkedList<T, Hook>::clear() {
+    while (head != nullptr) {
+        SListHook* next = head->next();
+        head->next(nullptr);
+        head = next;
+    }
+    tail = nullptr;
+    size_ = 0;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+void structures::IntrusiveLinkedList<T, Hook>::push_back(T& item) {
+    SListHook* node = hook(item);
+    node->next(nullptr);
+    if (empty()) {
+        head = node;
+    } else {
+        tail->next(node);
+    }
+    tail = node;
+    size_++;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+void structures::IntrusiveLinkedList<T, Hook>::push_front(T& item) {
+    SListHook* node = hook(item);
+    node->next(head);
+    if (empty()) {
+        tail = node;
+    }
+    head = node;
+    size_++;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+void structures::IntrusiveLinkedList<T, Hook>::insert_after(T& position,
+                                                           T& item) {
+    SListHook* previous = hook(position);
+    SListHook* node = hook(item);
+    node->next(previous->next());
+    previous->next(node);
+    if (previous == tail) {
+        tail = node;
+    }
+    size_++;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+T& structures::IntrusiveLinkedList<T, Hook>::pop_front() {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    SListHook* node = head;
+    head = node->next();
+    if (head == nullptr) {
+        tail = nullptr;
+    }
+    node->next(nullptr);
+    size_--;
+    return owner(node);
+}
+
+template<typename T, structures::SListHook T::*Hook>
+bool structures::IntrusiveLinkedList<T, Hook>::remove(T& item) {
+    SListHook* node = hook(item);
+    SListHook* previous = nullptr;
+    for (SListHook* it = head; it != nullptr; it = it->next()) {
+        if (it == node) {
+            if (previous == nullptr) {
+                head = node->next();
+            } else {
+                previous->next(node->next());
+            }
+            if (node == tail) {
+                tail = previous;
+            }
+            node->next(nullptr);
+            size_--;
+            return true;
+        }
+        previous = it;
+    }
+    return false;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+T& structures::IntrusiveLinkedList<T, Hook>::front() const {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    return owner(head);
+}
+
+template<typename T, structures::SListHook T::*Hook>
+T& structures::IntrusiveLinkedList<T, Hook>::back() const {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    return owner(tail);
+}
+
+template<typename T, structures::SListHook T::*Hook>
+bool structures::IntrusiveLinkedList<T, Hook>::contains(
+                                                    const T& item) const {
+    const SListHook* node = &(item.*Hook);
+    for (SListHook* it = head; it != nullptr; it = it->next()) {
+        if (it == node) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+template<typename F>
+void structures::IntrusiveLinkedList<T, Hook>::for_each(F&& f) const {
+    for (SListHook* it = head; it != nullptr; it = it->next()) {
+        f(owner(it));
+    }
+}
+
+template<typename T, structures::SListHook T::*Hook>
+bool structures::IntrusiveLinkedList<T, Hook>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+std::size_t structures::IntrusiveLinkedList<T, Hook>::size() const {
+    return size_;
+}
+
+#endif
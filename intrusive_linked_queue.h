@@ -0,0 +1,128 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_INTRUSIVE_LINKED_QUEUE_H
+#define STRUCTURES_INTRUSIVE_LINKED_QUEUE_H
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "./error_policy.h"
+#include "./intrusive_hooks.h"
+
+namespace structures {
+
+//! Classe de fila encadeada intrusiva
+/*!
+ *  Enfileira objetos pelo gancho Hook, sem alocar nada; a fila nao e'
+ *  dona dos objetos.
+ */
+template<typename T, SListHook T::*Hook>
+class IntrusiveLinkedQueue {
+ public:
+    //! construtor padrão
+    IntrusiveLinkedQueue();
+    //! destrutor (desliga os objetos)
+    ~IntrusiveLinkedQueue();
+    //! desliga todos os objetos
+    void clear();
+    //! enfileirar
+    void enqueue(T& item);
+    //! desenfileirar
+    T& dequeue();
+    //! primeiro objeto
+    T& front() const;
+    //! ultimo objeto
+    T& back() const;
+    //! fila vazia
+    bool empty() const;
+    //! tamanho
+    std::size_t size() const;
+
+ private:
+    IntrusiveLinkedQueue(const IntrusiveLinkedQueue&) = delete;
+    IntrusiveLinkedQueue& operator=(const IntrusiveLinkedQueue&) = delete;
+
+    SListHook* head;  // nodo-cabeça
+    SListHook* tail;  // nodo-fim
+    std::size_t size_;
+};
+
+}  // namespace structures
+
+template<typename T, structures::SListHook T::*Hook>
+structures::IntrusiveLinkedQueue<T, Hook>::IntrusiveLinkedQueue() {
+    head = nullptr;
+    tail = nullptr;
+    size_ = 0;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+structures::IntrusiveLinkedQueue<T, Hook>::~IntrusiveLinkedQueue() {
+    clear();
+}
+
+template<typename T, structures::SListHook T::*Hook>
+void structures::IntrusiveLinkedQueue<T, Hook>::clear() {
+    while (head != nullptr) {
+        SListHook* next = head->next();
+        head->next(nullptr);
+        head = next;
+    }
+    tail = nullptr;
+    size_ = 0;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+void structures::IntrusiveLinkedQueue<T, Hook>::enqueue(T& item) {
+    SListHook* node = &(item.*Hook);
+    node->next(nullptr);
+    if (empty()) {
+        head = node;
+    } else {
+        tail->next(node);
+    }
+    tail = node;
+    size_++;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+T& structures::IntrusiveLinkedQueue<T, Hook>::dequeue() {
+    if (empty()) {
+        raise_out_of_range("fila vazia");
+    }
+    SListHook* node = head;
+    head = node->next();
+    if (head == nullptr) {
+        tail = nullptr;
+    }
+    node->next(nullptr);
+    size_--;
+    return *hook_owner(node, Hook);
+}
+
+template<typename T, structures::SListHook T::*Hook>
+T& structures::IntrusiveLinkedQueue<T, Hook>::front() const {
+    if (empty()) {
+        raise_out_of_range("fila vazia");
+    }
+    return *hook_owner(head, Hook);
+}
+
+template<typename T, structures::SListHook T::*Hook>
+T& structures::IntrusiveLinkedQueue<T, Hook>::back() const {
+    if (empty()) {
+        raise_out_of_range("fila vazia");
+    }
+    return *hook_owner(tail, Hook);
+}
+
+template<typename T, structures::SListHook T::*Hook>
+bool structures::IntrusiveLinkedQueue<T, Hook>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, structures::SListHook T::*Hook>
+std::size_t structures::IntrusiveLinkedQueue<T, Hook>::size() const {
+    return size_;
+}
+
+#endif
@@ -1,31 +1,199 @@
-namespace structures {
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_LINKED_QUEUE_H
+#define STRUCTURES_LINKED_QUEUE_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ Exceptions
+#include <type_traits>
+#include <utility>
 
+#include "./error_policy.h"
+
+namespace structures {
 
-template<typename T>
+//! Classe fila encadeada
+/*!
+ *  Policy decide o que acontece com fila vazia (veja error_policy.h).
+ */
+template<typename T, typename Policy = ThrowPolicy>
 class LinkedQueue {
-public:
-    LinkedQueue();
+ public:
+    //! retorno de uma operacao que devolveria R, conforme Policy
+    template<typename R>
+    using Result = typename Policy::template result<R>;
 
+    //! construtor padrão
+    LinkedQueue();
+    //! destrutor
     ~LinkedQueue();
+    //! limpar
+    void clear();
+    //! enfileirar
+    void enqueue(const T& data);
+    //! enfileirar (movendo)
+    void enqueue(T&& data);
+    //! desenfileirar
+    Result<T> dequeue() noexcept(nothrow_move<Policy, T>);
+    //! desenfileirar em *data sem lancar; Status::EMPTY se vazia
+    Status try_dequeue(T* data)
+        noexcept(std::is_nothrow_move_assignable<T>::value);
+    //! primeiro dado
+    Result<T&> front() const noexcept(Policy::nothrow);
+    //! último dado
+    Result<T&> back() const noexcept(Policy::nothrow);
+    //! fila vazia
+    bool empty() const;
+    //! tamanho
+    std::size_t size() const;
+
+ private:
+    class Node {  // Elemento
+     public:
+        explicit Node(const T& data):
+            data_{data}
+        {}
+
+        explicit Node(T&& data):
+            data_{std::move(data)}
+        {}
 
-    void clear(); // limpar
+        T& data() {  // getter: dado
+            return data_;
+        }
 
-    void enqueue(const T& data); // enfilerar
+        const T& data() const {  // getter const: dado
+            return data_;
+        }
 
-    T dequeue(); // desenfilerar
+        Node* next() {  // getter: próximo
+            return next_;
+        }
 
-    T& front() const; // primeiro dado
+        const Node* next() const {  // getter const: próximo
+            return next_;
+        }
 
-    T& back() const; // último dado
+        void next(Node* node) {  // setter: próximo
+            next_ = node;
+        }
 
-    bool empty() const; // fila vazia
+     private:
+        T data_;
+        Node* next_{nullptr};
+    };
 
-    std::size_t size() const; // tamanho
+    LinkedQueue(const LinkedQueue&) = delete;
+    LinkedQueue& operator=(const LinkedQueue&) = delete;
+    //! encadeia node no fim
+    void link(Node* node);
 
-private:
-    Node* head; // nodo-cabeça
-    Node* tail; // nodo-fim
-    std::size_t size_; // tamanho
+    Node* head{nullptr};  // nodo-cabeça
+    Node* tail{nullptr};  // nodo-fim
+    std::size_t size_{0u};  // tamanho
 };
 
+}  // namespace structures
+
+template<typename T, typename P>
+structures::LinkedQueue<T, P>::LinkedQueue() {}
+
+template<typename T, typename P>
+structures::LinkedQueue<T, P>::~LinkedQueue() {
+    clear();
+}
+
+template<typename T, typename P>
+void structures::LinkedQueue<T, P>::clear() {
+    while (head != nullptr) {
+        Node* next = head->next();
+        delete head;
+        head = next;
+    }
+    tail = nullptr;
+    size_ = 0;
+}
+
+template<typename T, typename P>
+void structures::LinkedQueue<T, P>::link(Node* node) {
+    if (empty()) {
+        head = node;
+    } else {
+        tail->next(node);
+    }
+    tail = node;
+    size_++;
+}
+
+template<typename T, typename P>
+void structures::LinkedQueue<T, P>::enqueue(const T& data) {
+    link(new Node(data));
 }
+
+template<typename T, typename P>
+void structures::LinkedQueue<T, P>::enqueue(T&& data) {
+    link(new Node(std::move(data)));
+}
+
+template<typename T, typename P>
+typename P::template result<T> structures::LinkedQueue<T, P>::dequeue()
+    noexcept(nothrow_move<P, T>) {
+    if (P::checked && empty()) {
+        return P::template fail<T>(Status::EMPTY, "fila vazia");
+    }
+    Node* out = head;
+    T data = std::move(out->data());
+    head = out->next();
+    if (head == nullptr) {
+        tail = nullptr;
+    }
+    delete out;
+    size_--;
+    return data;
+}
+
+template<typename T, typename P>
+structures::Status structures::LinkedQueue<T, P>::try_dequeue(T* data)
+    noexcept(std::is_nothrow_move_assignable<T>::value) {
+    if (empty()) {
+        return Status::EMPTY;
+    }
+    Node* out = head;
+    *data = std::move(out->data());
+    head = out->next();
+    if (head == nullptr) {
+        tail = nullptr;
+    }
+    delete out;
+    size_--;
+    return Status::OK;
+}
+
+template<typename T, typename P>
+typename P::template result<T&>
+structures::LinkedQueue<T, P>::front() const noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<T&>(Status::EMPTY, "fila vazia");
+    }
+    return head->data();
+}
+
+template<typename T, typename P>
+typename P::template result<T&>
+structures::LinkedQueue<T, P>::back() const noexcept(P::nothrow) {
+    if (P::checked && empty()) {
+        return P::template fail<T&>(Status::EMPTY, "fila vazia");
+    }
+    return tail->data();
+}
+
+template<typename T, typename P>
+bool structures::LinkedQueue<T, P>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T, typename P>
+std::size_t structures::LinkedQueue<T, P>::size() const {
+    return size_;
+}
+
+#endif
@@ -0,0 +1,308 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_LRU_CACHE_H
+#define STRUCTURES_LRU_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "./doubly_circular_list.h"
+
+namespace structures {
+
+//! Classe de cache LRU com indice hash
+/*!
+ *  A ordem de uso fica em DoublyCircularList (inicio = mais recente) e o
+ *  indice aponta direto para os nodos, entao get, put, erase e a
+ *  promocao sao O(1). A capacidade e' em peso (weigher, 1 por entrada
+ *  por padrao); entradas sao despejadas pelo fim ate o peso caber.
+ *
+ *  Com TWO_QUEUE (2Q), entradas novas entram numa fila FIFO de ate 1/4
+ *  da capacidade; so chegam a lista principal se voltarem depois de
+ *  despejadas (as chaves despejadas ficam numa lista fantasma). Uma
+ *  varredura unica passa pela fila sem expulsar a lista principal.
+ */
+template<typename K, typename V, typename Hash = std::hash<K>>
+class LruCache {
+ public:
+    //! politica de substituicao
+    enum class Policy { LRU, TWO_QUEUE };
+    //! peso de uma entrada
+    using Weigher = std::function<std::size_t(const K&, const V&)>;
+
+    //! construtor com capacidade em numero de entradas
+    explicit LruCache(std::size_t capacity, Policy policy = Policy::LRU);
+    //! construtor com capacidade em peso
+    LruCache(std::size_t capacity, Weigher weigher,
+             Policy policy = Policy::LRU);
+    //! valor da chave (promovido), nullptr se ausente
+    const V* get(const K& key);
+    //! insere ou atualiza; false se a entrada sozinha excede a capacidade
+    bool put(const K& key, const V& value);
+    //! retira a chave; false se ausente
+    bool erase(const K& key);
+    //! verifica a chave sem promove-la
+    bool contains(const K& key) const;
+    //! limpa o cache
+    void clear();
+    //! numero de entradas
+    std::size_t size() const;
+    //! peso total das entradas
+    std::size_t weight() const;
+    //! capacidade em peso
+    std::size_t capacity() const;
+    //! cache vazio
+    bool empty() const;
+    //! acertos de get
+    std::size_t hits() const;
+    //! faltas de get
+    std::size_t misses() const;
+
+ private:
+    struct Entry {
+        K key;
+        V value;
+        std::size_t weight;
+        bool main;  // na lista principal (senao na fila de entrada)
+    };
+    struct Ghost {
+        K key;
+        std::size_t weight;
+    };
+    using List = DoublyCircularList<Entry>;
+    using Handle = typename List::Handle;
+    using GhostList = DoublyCircularList<Ghost>;
+    using GhostHandle = typename GhostList::Handle;
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+    //! despeja pelo fim ate o peso caber, poupando keep
+    void evict(Handle keep);
+    //! entrada mais antiga da lista que nao e' keep (nullptr se nao ha)
+    Handle oldest(const List& list, Handle keep) const;
+    //! retira a entrada das listas e do indice
+    Entry remove(Handle node);
+    //! registra a chave despejada da fila de entrada
+    void remember(const K& key, std::size_t weight);
+    //! esquece a chave fantasma; true se existia
+    bool forget(const K& key);
+
+    List main_;
+    List in_;  // fila de entrada do 2Q
+    GhostList ghosts_;
+    std::unordered_map<K, Handle, Hash> index_;
+    std::unordered_map<K, GhostHandle, Hash> ghost_index_;
+    Weigher weigher_;
+    Policy policy_;
+    std::size_t capacity_;
+    std::size_t weight_;
+    std::size_t in_weight_;
+    std::size_t ghost_weight_;
+    std::size_t hits_;
+    std::size_t misses_;
+};
+
+}  // namespace structures
+
+template<typename K, typename V, typename Hash>
+structures::LruCache<K, V, Hash>::LruCache(std::size_t capacity,
+                                           Policy policy):
+    LruCache(capacity, [](const K&, const V&) { return std::size_t(1); },
+             policy)
+{}
+
+template<typename K, typename V, typename Hash>
+structures::LruCache<K, V, Hash>::LruCache(std::size_t capacity,
+                                           Weigher weigher,
+                                           Policy policy):
+    weigher_{std::move(weigher)},
+    policy_{policy},
+    capacity_{capacity},
+    weight_{0},
+    in_weight_{0},
+    ghost_weight_{0},
+    hits_{0},
+    misses_{0}
+{}
+
+template<typename K, typename V, typename Hash>
+const V* structures::LruCache<K, V, Hash>::get(const K& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        misses_++;
+        return nullptr;
+    }
+    hits_++;
+    Entry& entry = it->second->data();
+    // no 2Q acertos na fila de entrada nao reordenam (FIFO)
+    if (entry.main) {
+        main_.move_to_front(it->second);
+    }
+    return &entry.value;
+}
+
+template<typename K, typename V, typename Hash>
+bool structures::LruCache<K, V, Hash>::put(const K& key, const V& value) {
+    std::size_t weight = weigher_(key, value);
+    auto it = index_.find(key);
+    if (weight > capacity_) {
+        if (it != index_.end()) {
+            remove(it->second);
+        }
+        return false;
+    }
+    Handle node;
+    if (it != index_.end()) {
+        node = it->second;
+        Entry& entry = node->data();
+        entry.value = value;
+        weight_ += weight - entry.weight;
+        if (entry.main) {
+            main_.move_to_front(node);
+        } else {
+            in_weight_ += weight - entry.weight;
+        }
+        entry.weight = weight;
+    } else {
+        bool main = policy_ == Policy::LRU || forget(key);
+        List& list = main ? main_ : in_;
+        node = list.push_front(Entry{key, value, weight, main});
+        index_.emplace(key, node);
+        weight_ += weight;
+        if (!main) {
+            in_weight_ += weight;
+        }
+    }
+    evict(node);
+    return true;
+}
+
+template<typename K, typename V, typename Hash>
+bool structures::LruCache<K, V, Hash>::erase(const K& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        forget(key);
+        return false;
+    }
+    remove(it->second);
+    return true;
+}
+
+template<typename K, typename V, typename Hash>
+bool structures::LruCache<K, V, Hash>::contains(const K& key) const {
+    return index_.find(key) != index_.end();
+}
+
+template<typename K, typename V, typename Hash>
+void structures::LruCache<K, V, Hash>::evict(Handle keep) {
+    std::size_t in_capacity = capacity_ / 4;
+    while (weight_ > capacity_) {
+        // a fila de entrada cede quando passou da cota (ou so ela resta);
+        // keep cabe sozinho, entao sempre ha outra vitima
+        Handle in_victim = oldest(in_, keep);
+        Handle main_victim = oldest(main_, keep);
+        bool over = in_weight_ > in_capacity || main_victim == nullptr;
+        if (in_victim != nullptr && over) {
+            Entry entry = remove(in_victim);
+            remember(entry.key, entry.weight);
+        } else {
+            remove(main_victim);
+        }
+    }
+}
+
+template<typename K, typename V, typename Hash>
+typename structures::LruCache<K, V, Hash>::Handle
+structures::LruCache<K, V, Hash>::oldest(const List& list,
+                                         Handle keep) const {
+    if (list.empty()) {
+        return nullptr;
+    }
+    Handle node = list.back_handle();
+    if (node != keep) {
+        return node;
+    }
+    return list.size() > 1 ? node->prev() : nullptr;
+}
+
+template<typename K, typename V, typename Hash>
+typename structures::LruCache<K, V, Hash>::Entry
+structures::LruCache<K, V, Hash>::remove(Handle node) {
+    index_.erase(node->data().key);
+    Entry entry = node->data().main ? main_.erase(node) : in_.erase(node);
+    weight_ -= entry.weight;
+    if (!entry.main) {
+        in_weight_ -= entry.weight;
+    }
+    return entry;
+}
+
+template<typename K, typename V, typename Hash>
+void structures::LruCache<K, V, Hash>::remember(const K& key,
+                                                std::size_t weight) {
+    ghost_index_.emplace(key, ghosts_.push_front(Ghost{key, weight}));
+    ghost_weight_ += weight;
+    // a lista fantasma cobre metade da capacidade
+    while (ghost_weight_ > capacity_ / 2 && !ghosts_.empty()) {
+        Ghost ghost = ghosts_.erase(ghosts_.back_handle());
+        ghost_index_.erase(ghost.key);
+        ghost_weight_ -= ghost.weight;
+    }
+}
+
+template<typename K, typename V, typename Hash>
+bool structures::LruCache<K, V, Hash>::forget(const K& key) {
+    auto it = ghost_index_.find(key);
+    if (it == ghost_index_.end()) {
+        return false;
+    }
+    ghost_weight_ -= ghosts_.erase(it->second).weight;
+    ghost_index_.erase(it);
+    return true;
+}
+
+template<typename K, typename V, typename Hash>
+void structures::LruCache<K, V, Hash>::clear() {
+    main_.clear();
+    in_.clear();
+    ghosts_.clear();
+    index_.clear();
+    ghost_index_.clear();
+    weight_ = 0;
+    in_weight_ = 0;
+    ghost_weight_ = 0;
+}
+
+template<typename K, typename V, typename Hash>
+std::size_t structures::LruCache<K, V, Hash>::size() const {
+    return index_.size();
+}
+
+template<typename K, typename V, typename Hash>
+std::size_t structures::LruCache<K, V, Hash>::weight() const {
+    return weight_;
+}
+
+template<typename K, typename V, typename Hash>
+std::size_t structures::LruCache<K, V, Hash>::capacity() const {
+    return capacity_;
+}
+
+template<typename K, typename V, typename Hash>
+bool structures::LruCache<K, V, Hash>::empty() const {
+    return index_.empty();
+}
+
+template<typename K, typename V, typename Hash>
+std::size_t structures::LruCache<K, V, Hash>::hits() const {
+    return hits_;
+}
+
+template<typename K, typename V, typename Hash>
+std::size_t structures::LruCache<K, V, Hash>::misses() const {
+    return misses_;
+}
+
+#endif
@@ -0,0 +1,146 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_MAPPED_FILE_H
+#define STRUCTURES_MAPPED_FILE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <stdexcept>  // C++ exceptions
+#include <string>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+//! Classe que mapeia um arquivo inteiro em memoria (POSIX mmap)
+class MappedFile {
+ public:
+    //! construtor padrao (nada mapeado)
+    MappedFile();
+    //! destrutor (desfaz o mapeamento)
+    ~MappedFile();
+    //! construtor de movimento
+    MappedFile(MappedFile&& other);
+    //! atribuicao de movimento
+    MappedFile& operator=(MappedFile&& other);
+    //! mapeia o arquivo; copy_on_write permite escrita privada
+    void open(const char* path, bool copy_on_write = false);
+    //! como open, mas devolve false em vez de lancar
+    bool try_open(const char* path, bool copy_on_write = false);
+    //! desfaz o mapeamento
+    void close();
+    //! inicio do mapeamento
+    char* data() const;
+    //! tamanho do mapeamento em bytes
+    std::size_t size() const;
+    //! verifica se ha arquivo mapeado
+    bool is_open() const;
+
+ private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    char* data_;
+    std::size_t size_;
+};
+
+//! checksum FNV-1a de 64 bits
+inline std::uint64_t checksum(const void* data, std::size_t size);
+
+}  // namespace structures
+
+inline structures::MappedFile::MappedFile() {
+    data_ = nullptr;
+    size_ = 0;
+}
+
+inline structures::MappedFile::~MappedFile() {
+    close();
+}
+
+inline structures::MappedFile::MappedFile(MappedFile&& other) {
+    data_ = other.data_;
+    size_ = other.size_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+inline structures::MappedFile& structures::MappedFile::operator=(
+                                            MappedFile&& other) {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+inline void structures::MappedFile::open(const char* path,
+                                         bool copy_on_write) {
+    if (!try_open(path, copy_on_write)) {
+        raise_runtime_error(std::string("erro ao mapear ") + path);
+    }
+}
+
+inline bool structures::MappedFile::try_open(const char* path,
+                                             bool copy_on_write) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    // MAP_PRIVATE: escritas ficam na copia do processo, nunca no arquivo
+    int protection = copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* address = mmap(nullptr, info.st_size, protection,
+                         MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<char*>(address);
+    size_ = info.st_size;
+    return true;
+}
+
+inline void structures::MappedFile::close() {
+    if (data_ != nullptr) {
+        munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+inline char* structures::MappedFile::data() const {
+    return data_;
+}
+
+inline std::size_t structures::MappedFile::size() const {
+    return size_;
+}
+
+inline bool structures::MappedFile::is_open() const {
+    return data_ != nullptr;
+}
+
+inline std::uint64_t structures::checksum(const void* data,
+                                          std::size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+#endif
@@ -0,0 +1,146 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_MIRRORED_BUFFER_H
+#define STRUCTURES_MIRRORED_BUFFER_H
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+namespace structures {
+
+//! Classe de buffer espelhado: as mesmas paginas mapeadas duas vezes
+/*!
+ *  data()[i] e data()[i + size()] sao o mesmo byte, entao qualquer janela
+ *  de ate size() bytes e' contigua, mesmo passando do fim do buffer.
+ *  Usa memfd_create (Linux); em outros sistemas, ou se o kernel recusar,
+ *  allocate devolve false e quem chamou usa um buffer comum.
+ */
+class MirroredBuffer {
+ public:
+    //! construtor padrao (nada mapeado)
+    MirroredBuffer();
+    //! destrutor (desfaz o mapeamento)
+    ~MirroredBuffer();
+    //! construtor de movimento
+    MirroredBuffer(MirroredBuffer&& other);
+    //! atribuicao de movimento
+    MirroredBuffer& operator=(MirroredBuffer&& other);
+    //! mapeia bytes (arredondado para paginas) duas vezes; false se falhar
+    bool allocate(std::size_t bytes);
+    //! desfaz o mapeamento
+    void release();
+    //! inicio do primeiro mapeamento
+    char* data() const;
+    //! tamanho de uma copia em bytes
+    std::size_t size() const;
+    //! verifica se ha buffer mapeado
+    bool is_open() const;
+    //! tamanho da pagina do sistema
+    static std::size_t page_size();
+
+ private:
+    MirroredBuffer(const MirroredBuffer&) = delete;
+    MirroredBuffer& operator=(const MirroredBuffer&) = delete;
+
+    char* data_;
+    std::size_t size_;
+};
+
+}  // namespace structures
+
+inline structures::MirroredBuffer::MirroredBuffer() {
+    data_ = nullptr;
+    size_ = 0;
+}
+
+inline structures::MirroredBuffer::~MirroredBuffer() {
+    release();
+}
+
+inline structures::MirroredBuffer::MirroredBuffer(MirroredBuffer&& other) {
+    data_ = other.data_;
+    size_ = other.size_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+inline structures::MirroredBuffer& structures::MirroredBuffer::operator=(
+                                            MirroredBuffer&& other) {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+inline bool structures::MirroredBuffer::allocate(std::size_t bytes) {
+    release();
+#ifdef __linux__
+    std::size_t page = page_size();
+    bytes = (bytes + page - 1) / page * page;
+    if (bytes == 0) {
+        return false;
+    }
+    int fd = memfd_create("structures_ring", MFD_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, bytes) != 0) {
+        ::close(fd);
+        return false;
+    }
+    // reserva 2 * bytes de enderecos e mapeia o arquivo nas duas metades
+    void* base = mmap(nullptr, 2 * bytes, PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    char* first = static_cast<char*>(base);
+    bool ok = mmap(first, bytes, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+              mmap(first + bytes, bytes, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    ::close(fd);
+    if (!ok) {
+        munmap(base, 2 * bytes);
+        return false;
+    }
+    data_ = first;
+    size_ = bytes;
+    return true;
+#else
+    (void) bytes;
+    return false;
+#endif
+}
+
+inline void structures::MirroredBuffer::release() {
+    if (data_ != nullptr) {
+        munmap(data_, 2 * size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+inline char* structures::MirroredBuffer::data() const {
+    return data_;
+}
+
+inline std::size_t structures::MirroredBuffer::size() const {
+    return size_;
+}
+
+inline bool structures::MirroredBuffer::is_open() const {
+    return data_ != nullptr;
+}
+
+inline std::size_t structures::MirroredBuffer::page_size() {
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+#endif
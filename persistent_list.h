@@ -0,0 +1,244 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_PERSISTENT_LIST_H
+#define STRUCTURES_PERSISTENT_LIST_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+//! Classe de lista encadeada persistente (imutavel)
+/*!
+ *  push_front/pop_front devolvem uma nova versao que compartilha a cauda
+ *  com a anterior. Os nodos nunca mudam depois de criados e tem contagem
+ *  de referencias atomica, entao copiar uma versao (snapshot) e' O(1) e
+ *  varias threads podem ler versoes que compartilham nodos sem locks.
+ *  Um mesmo objeto PersistentList nao deve ser reatribuido enquanto outra
+ *  thread o copia.
+ */
+template<typename T>
+class PersistentList {
+ public:
+    //! construtor padrão (lista vazia)
+    PersistentList();
+    //! copia O(1): compartilha todos os nodos
+    PersistentList(const PersistentList& other);
+    //! construtor de movimento
+    PersistentList(PersistentList&& other);
+    //! destrutor (libera os nodos que ficaram sem referencia)
+    ~PersistentList();
+    //! atribuição por copia O(1)
+    PersistentList& operator=(const PersistentList& other);
+    //! atribuição de movimento
+    PersistentList& operator=(PersistentList&& other);
+    //! nova versao com data no início
+    PersistentList push_front(const T& data) const;
+    //! nova versao sem o primeiro elemento
+    PersistentList pop_front() const;
+    //! primeiro elemento
+    const T& front() const;
+    //! acessar em um indice (com checagem de limites)
+    const T& at(std::size_t index) const;
+    //! solta a referencia desta versao (fica vazia)
+    void clear();
+    //! lista vazia
+    bool empty() const;
+    //! lista contém determinado dado?
+    bool contains(const T& data) const;
+    //! posição de um item na lista
+    std::size_t find(const T& data) const;
+    //! tamanho da lista
+    std::size_t size() const;
+
+ private:
+    class Node {
+     public:
+        //! construtor com dado e next (assume a referencia de next)
+        Node(const T& data, Node* next):
+            data_{data},
+            next_{next}
+        {}
+        //! getter const: dado
+        const T& data() const {
+            return data_;
+        }
+        //! getter: next
+        Node* next() const {
+            return next_;
+        }
+        //! incrementa a contagem de referencias
+        void retain() {
+            references_.fetch_add(1, std::memory_order_relaxed);
+        }
+        //! decrementa; devolve true se era a ultima referencia
+        bool release() {
+            return references_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+     private:
+        const T data_;
+        Node* const next_;
+        std::atomic<std::size_t> references_{1};
+    };
+
+    //! construtor sobre uma cadeia (assume a referencia de head)
+    PersistentList(Node* head, std::size_t size);
+    //! solta uma referencia; libera a cadeia sem recursao
+    static void release(Node* node);
+
+    //! nodo-cabeça
+    Node* head;
+    //! tamanho
+    std::size_t size_;
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::PersistentList<T>::PersistentList() {
+    head = nullptr;
+    size_ = 0;
+}
+
+template<typename T>
+structures::PersistentList<T>::PersistentList(Node* head, std::size_t size) {
+    this->head = head;
+    size_ = size;
+}
+
+template<typename T>
+structures::PersistentList<T>::PersistentList(const PersistentList& other) {
+    head = other.head;
+    size_ = other.size_;
+    if (head != nullptr) {
+        head->retain();
+    }
+}
+
+template<typename T>
+structures::PersistentList<T>::PersistentList(PersistentList&& other) {
+    head = other.head;
+    size_ = other.size_;
+    other.head = nullptr;
+    other.size_ = 0;
+}
+
+template<typename T>
+structures::PersistentList<T>::~PersistentList() {
+    release(head);
+}
+
+template<typename T>
+structures::PersistentList<T>& structures::PersistentList<T>::operator=(
+                                            const PersistentList& other) {
+    if (other.head != nullptr) {
+        other.head->retain();
+    }
+    release(head);
+    head = other.head;
+    size_ = other.size_;
+    return *this;
+}
+
+template<typename T>
+structures::PersistentList<T>& structures::PersistentList<T>::operator=(
+                                            PersistentList&& other) {
+    if (this != &other) {
+        release(head);
+        head = other.head;
+        size_ = other.size_;
+        other.head = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+template<typename T>
+void structures::PersistentList<T>::release(Node* node) {
+    while (node != nullptr && node->release()) {
+        Node* next = node->next();
+        delete node;
+        node = next;
+    }
+}
+
+template<typename T>
+structures::PersistentList<T> structures::PersistentList<T>::push_front(
+                                                    const T& data) const {
+    if (head != nullptr) {
+        head->retain();
+    }
+    return PersistentList(new Node(data, head), size_ + 1);
+}
+
+template<typename T>
+structures::PersistentList<T>
+structures::PersistentList<T>::pop_front() const {
+    if (empty()) {
+        raise_out_of_range("Persistent list empty");
+    }
+    Node* next = head->next();
+    if (next != nullptr) {
+        next->retain();
+    }
+    return PersistentList(next, size_ - 1);
+}
+
+template<typename T>
+const T& structures::PersistentList<T>::front() const {
+    if (empty()) {
+        raise_out_of_range("Persistent list empty");
+    }
+    return head->data();
+}
+
+template<typename T>
+const T& structures::PersistentList<T>::at(std::size_t index) const {
+    if (index >= size_) {
+        raise_out_of_range("Out of bound");
+    }
+    Node* temp = head;
+    for (std::size_t i = 0; i < index; i++) {
+        temp = temp->next();
+    }
+    return temp->data();
+}
+
+template<typename T>
+void structures::PersistentList<T>::clear() {
+    release(head);
+    head = nullptr;
+    size_ = 0;
+}
+
+template<typename T>
+bool structures::PersistentList<T>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T>
+bool structures::PersistentList<T>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+template<typename T>
+std::size_t structures::PersistentList<T>::find(const T& data) const {
+    Node* temp = head;
+    for (std::size_t i = 0; i < size_; i++) {
+        if (temp->data() == data) {
+            return i;
+        }
+        temp = temp->next();
+    }
+    return size_;
+}
+
+template<typename T>
+std::size_t structures::PersistentList<T>::size() const {
+    return size_;
+}
+
+#endif
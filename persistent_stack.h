@@ -0,0 +1,91 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_PERSISTENT_STACK_H
+#define STRUCTURES_PERSISTENT_STACK_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "./error_policy.h"
+#include "./persistent_list.h"
+
+namespace structures {
+
+//! Classe de pilha encadeada persistente (imutavel)
+/*!
+ *  push/pop devolvem uma nova versao; versoes compartilham os nodos de
+ *  PersistentList, entao um snapshot e' uma copia O(1).
+ */
+template<typename T>
+class PersistentStack {
+ public:
+    //! construtor padrão (pilha vazia)
+    PersistentStack();
+    //! nova versao com data no topo
+    PersistentStack push(const T& data) const;
+    //! nova versao sem o topo
+    PersistentStack pop() const;
+    //! dado no topo
+    const T& top() const;
+    //! solta a referencia desta versao (fica vazia)
+    void clear();
+    //! pilha vazia
+    bool empty() const;
+    //! tamanho da pilha
+    std::size_t size() const;
+
+ private:
+    //! construtor sobre uma versao da lista
+    explicit PersistentStack(PersistentList<T>&& list);
+
+    PersistentList<T> list_;
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::PersistentStack<T>::PersistentStack() {}
+
+template<typename T>
+structures::PersistentStack<T>::PersistentStack(PersistentList<T>&& list):
+    list_{std::move(list)}
+{}
+
+template<typename T>
+structures::PersistentStack<T> structures::PersistentStack<T>::push(
+                                                    const T& data) const {
+    return PersistentStack(list_.push_front(data));
+}
+
+template<typename T>
+structures::PersistentStack<T> structures::PersistentStack<T>::pop() const {
+    if (empty()) {
+        raise_out_of_range("pilha vazia");
+    }
+    return PersistentStack(list_.pop_front());
+}
+
+template<typename T>
+const T& structures::PersistentStack<T>::top() const {
+    if (empty()) {
+        raise_out_of_range("pilha vazia");
+    }
+    return list_.front();
+}
+
+template<typename T>
+void structures::PersistentStack<T>::clear() {
+    list_.clear();
+}
+
+template<typename T>
+bool structures::PersistentStack<T>::empty() const {
+    return list_.empty();
+}
+
+template<typename T>
+std::size_t structures::PersistentStack<T>::size() const {
+    return list_.size();
+}
+
+#endif
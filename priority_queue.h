@@ -0,0 +1,317 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_PRIORITY_QUEUE_H
+#define STRUCTURES_PRIORITY_QUEUE_H
+
+#include <cstdint>  // std::size_t
+#include <functional>  // std::less
+#include <stdexcept>  // C++ exceptions
+#include <utility>
+#include <vector>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+template<typename T, typename Compare = std::less<T>, std::size_t D = 4>
+//! CLASSE FILA DE PRIORIDADE (heap d-ario)
+/*!
+ *  Heap d-ario em armazenamento contiguo. Como em std::priority_queue, o
+ *  topo e' o maior elemento segundo Compare (use std::greater para heap de
+ *  minimo). Aridade 4 ou 8 deixa a arvore mais rasa e os filhos de um nodo
+ *  na mesma linha de cache.
+ */
+class PriorityQueue {
+    static_assert(D >= 2, "aridade minima e' 2");
+
+ public:
+    //! referencia estavel a um elemento, usada em decrease_key/update
+    class Handle {
+     public:
+        //! handle invalido
+        Handle() : id_{NONE}, generation_{0} {}
+
+     private:
+        friend class PriorityQueue;
+        Handle(std::size_t id, std::uint32_t generation):
+            id_{id},
+            generation_{generation}
+        {}
+        std::size_t id_;
+        std::uint32_t generation_;  // ids sao reusados: detecta handle velho
+    };
+
+    //! construtor padrao
+    PriorityQueue();
+    //! construtor com comparador
+    explicit PriorityQueue(const Compare& compare);
+    //! constroi a partir de [first, last) em O(n) (heapify)
+    template<typename Iterator>
+    PriorityQueue(Iterator first, Iterator last,
+                  const Compare& compare = Compare());
+    //! metodo insere
+    Handle push(const T& data);
+    //! metodo retira o topo
+    T pop();
+    //! metodo retorna o topo
+    const T& top() const;
+    //! aumenta a prioridade do elemento (sobe no heap)
+    void decrease_key(Handle handle, const T& data);
+    //! troca o valor do elemento em qualquer direcao
+    void update(Handle handle, const T& data);
+    //! valor atual do elemento
+    const T& get(Handle handle) const;
+    //! verifica se o elemento ainda esta na fila
+    bool contains(Handle handle) const;
+    //! move todos os elementos de other para esta fila em O(n + m)
+    /*!
+     *  other fica vazia e seus handles deixam de ser validos.
+     */
+    void merge(PriorityQueue& other);
+    //! metodo limpa a fila
+    void clear();
+    //! metodo retorna tamanho
+    std::size_t size() const;
+    //! verifica se esta vazia
+    bool empty() const;
+
+ private:
+    struct Entry {
+        T data;
+        std::size_t id;
+    };
+
+    //! novo id de handle apontando para a posicao index
+    std::size_t new_id(std::size_t index);
+    //! libera o id para reuso, invalidando os handles dele
+    void release(std::size_t id);
+    //! posicao do elemento no heap, checando o handle
+    std::size_t index_of(Handle handle) const;
+    //! sobe o elemento em index ate a posicao correta
+    void sift_up(std::size_t index);
+    //! desce o elemento em index ate a posicao correta
+    void sift_down(std::size_t index);
+    //! reorganiza o vetor inteiro em heap (Floyd)
+    void heapify();
+
+    std::vector<Entry> heap_;
+    std::vector<std::size_t> position_;  // id -> posicao no heap
+    std::vector<std::uint32_t> generation_;  // id -> geracao
+    std::vector<std::size_t> free_ids_;
+    Compare compare_;
+
+    static const std::size_t NONE = static_cast<std::size_t>(-1);
+};
+
+}  // namespace structures
+
+template<typename T, typename Compare, std::size_t D>
+structures::PriorityQueue<T, Compare, D>::PriorityQueue() {}
+
+template<typename T, typename Compare, std::size_t D>
+structures::PriorityQueue<T, Compare, D>::PriorityQueue(
+                                            const Compare& compare):
+    compare_{compare}
+{}
+
+template<typename T, typename Compare, std::size_t D>
+template<typename Iterator>
+structures::PriorityQueue<T, Compare, D>::PriorityQueue(
+                                            Iterator first, Iterator last,
+                                            const Compare& compare):
+    compare_{compare}
+{
+    for (; first != last; ++first) {
+        heap_.push_back(Entry{*first, 0});
+        heap_.back().id = new_id(heap_.size() - 1);
+    }
+    heapify();
+}
+
+template<typename T, typename Compare, std::size_t D>
+std::size_t structures::PriorityQueue<T, Compare, D>::new_id(
+                                                    std::size_t index) {
+    if (!free_ids_.empty()) {
+        std::size_t id = free_ids_.back();
+        free_ids_.pop_back();
+        position_[id] = index;
+        return id;
+    }
+    position_.push_back(index);
+    generation_.push_back(0);
+    return position_.size() - 1;
+}
+
+template<typename T, typename Compare, std::size_t D>
+void structures::PriorityQueue<T, Compare, D>::release(std::size_t id) {
+    position_[id] = NONE;
+    generation_[id]++;
+    free_ids_.push_back(id);
+}
+
+template<typename T, typename Compare, std::size_t D>
+std::size_t structures::PriorityQueue<T, Compare, D>::index_of(
+                                                    Handle handle) const {
+    if (!contains(handle)) {
+        raise_out_of_range("handle invalido");
+    }
+    return position_[handle.id_];
+}
+
+template<typename T, typename Compare, std::size_t D>
+void structures::PriorityQueue<T, Compare, D>::sift_up(std::size_t index) {
+    Entry moving = std::move(heap_[index]);
+    while (index > 0) {
+        std::size_t parent = (index - 1) / D;
+        if (!compare_(heap_[parent].data, moving.data)) {
+            break;
+        }
+        heap_[index] = std::move(heap_[parent]);
+        position_[heap_[index].id] = index;
+        index = parent;
+    }
+    heap_[index] = std::move(moving);
+    position_[heap_[index].id] = index;
+}
+
+template<typename T, typename Compare, std::size_t D>
+void structures::PriorityQueue<T, Compare, D>::sift_down(std::size_t index) {
+    std::size_t size = heap_.size();
+    Entry moving = std::move(heap_[index]);
+    while (true) {
+        std::size_t first = index * D + 1;
+        if (first >= size) {
+            break;
+        }
+        std::size_t last = first + D < size ? first + D : size;
+        std::size_t best = first;
+        for (std::size_t child = first + 1; child < last; child++) {
+            if (compare_(heap_[best].data, heap_[child].data)) {
+                best = child;
+            }
+        }
+        if (!compare_(moving.data, heap_[best].data)) {
+            break;
+        }
+        heap_[index] = std::move(heap_[best]);
+        position_[heap_[index].id] = index;
+        index = best;
+    }
+    heap_[index] = std::move(moving);
+    position_[heap_[index].id] = index;
+}
+
+template<typename T, typename Compare, std::size_t D>
+void structures::PriorityQueue<T, Compare, D>::heapify() {
+    if (heap_.size() < 2) {
+        return;
+    }
+    for (std::size_t i = (heap_.size() - 2) / D + 1; i > 0; i--) {
+        sift_down(i - 1);
+    }
+}
+
+template<typename T, typename Compare, std::size_t D>
+typename structures::PriorityQueue<T, Compare, D>::Handle
+structures::PriorityQueue<T, Compare, D>::push(const T& data) {
+    std::size_t id = new_id(heap_.size());
+    heap_.push_back(Entry{data, id});
+    sift_up(heap_.size() - 1);
+    return Handle(id, generation_[id]);
+}
+
+template<typename T, typename Compare, std::size_t D>
+T structures::PriorityQueue<T, Compare, D>::pop() {
+    if (empty()) {
+        raise_out_of_range("fila vazia");
+    }
+    T data = std::move(heap_.front().data);
+    release(heap_.front().id);
+    if (heap_.size() > 1) {
+        heap_.front() = std::move(heap_.back());
+        heap_.pop_back();
+        sift_down(0);
+    } else {
+        heap_.pop_back();
+    }
+    return data;
+}
+
+template<typename T, typename Compare, std::size_t D>
+const T& structures::PriorityQueue<T, Compare, D>::top() const {
+    if (empty()) {
+        raise_out_of_range("fila vazia");
+    }
+    return heap_.front().data;
+}
+
+template<typename T, typename Compare, std::size_t D>
+void structures::PriorityQueue<T, Compare, D>::decrease_key(Handle handle,
+                                                            const T& data) {
+    std::size_t index = index_of(handle);
+    if (compare_(data, heap_[index].data)) {
+        raise_invalid_argument("nova chave tem prioridade menor");
+    }
+    heap_[index].data = data;
+    sift_up(index);
+}
+
+template<typename T, typename Compare, std::size_t D>
+void structures::PriorityQueue<T, Compare, D>::update(Handle handle,
+                                                      const T& data) {
+    std::size_t index = index_of(handle);
+    bool higher = compare_(heap_[index].data, data);
+    heap_[index].data = data;
+    if (higher) {
+        sift_up(index);
+    } else {
+        sift_down(index);
+    }
+}
+
+template<typename T, typename Compare, std::size_t D>
+const T& structures::PriorityQueue<T, Compare, D>::get(Handle handle) const {
+    return heap_[index_of(handle)].data;
+}
+
+template<typename T, typename Compare, std::size_t D>
+bool structures::PriorityQueue<T, Compare, D>::contains(
+                                                    Handle handle) const {
+    return handle.id_ < position_.size() &&
+           position_[handle.id_] != NONE &&
+           generation_[handle.id_] == handle.generation_;
+}
+
+template<typename T, typename Compare, std::size_t D>
+void structures::PriorityQueue<T, Compare, D>::merge(PriorityQueue& other) {
+    if (this == &other) {
+        return;
+    }
+    heap_.reserve(heap_.size() + other.heap_.size());
+    for (auto& entry : other.heap_) {
+        heap_.push_back(Entry{std::move(entry.data), 0});
+        heap_.back().id = new_id(heap_.size() - 1);
+    }
+    other.clear();
+    heapify();
+}
+
+template<typename T, typename Compare, std::size_t D>
+void structures::PriorityQueue<T, Compare, D>::clear() {
+    // os ids continuam reservados para que handles antigos nao casem
+    for (const Entry& entry : heap_) {
+        release(entry.id);
+    }
+    heap_.clear();
+}
+
+template<typename T, typename Compare, std::size_t D>
+std::size_t structures::PriorityQueue<T, Compare, D>::size() const {
+    return heap_.size();
+}
+
+template<typename T, typename Compare, std::size_t D>
+bool structures::PriorityQueue<T, Compare, D>::empty() const {
+    return heap_.empty();
+}
+
+#endif
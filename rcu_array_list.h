@@ -0,0 +1,294 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_RCU_ARRAY_LIST_H
+#define STRUCTURES_RCU_ARRAY_LIST_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <stdexcept>  // C++ Exceptions
+#include <utility>
+#include <vector>
+
+#include "./array_list.h"
+#include "./error_policy.h"
+
+namespace structures {
+
+template<typename T>
+//! Classe ArrayList read-copy-update para leitura concorrente
+/*!
+ *  Leitores obtem um snapshot imutavel sem locks e sem escrita em linha
+ *  de cache compartilhada: cada leitor anuncia a epoca atual no seu
+ *  proprio slot. O escritor copia a versao atual, aplica um lote de
+ *  alteracoes e publica a nova versao com uma troca atomica; a versao
+ *  antiga so e' liberada quando nenhum leitor ativo pode ve-la (epocas).
+ */
+class RcuArrayList {
+ public:
+    class Reader;
+
+    //! leitura fixada em uma versao; valida ate ser destruida
+    class Snapshot {
+     public:
+        //! construtor de movimento
+        Snapshot(Snapshot&& other);
+        //! destrutor (libera a epoca do leitor)
+        ~Snapshot();
+        //! versao lida
+        const ArrayList<T>& operator*() const;
+        //! versao lida
+        const ArrayList<T>* operator->() const;
+
+     private:
+        friend class Reader;
+        Snapshot(Reader* reader, const ArrayList<T>* version);
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        Reader* reader_;
+        const ArrayList<T>* version_;
+    };
+
+    //! registro de uma thread leitora (um slot de epoca)
+    class Reader {
+     public:
+        //! construtor de movimento
+        Reader(Reader&& other);
+        //! destrutor (devolve o slot)
+        ~Reader();
+        //! snapshot wait-free da versao atual
+        Snapshot snapshot();
+
+     private:
+        friend class RcuArrayList;
+        friend class Snapshot;
+        Reader(RcuArrayList* list, std::size_t slot);
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        //! sai da secao de leitura
+        void unpin();
+
+        RcuArrayList* list_;
+        std::size_t slot_;
+        std::size_t depth_;
+    };
+
+    //! construtor com capacidade das versoes
+    explicit RcuArrayList(std::size_t max_size);
+    //! destrutor (nao pode haver snapshots ativos)
+    ~RcuArrayList();
+    //! registra a thread atual como leitora
+    Reader reader();
+    //! copia a versao atual, aplica batch(lista) e publica o resultado
+    template<typename F>
+    void update(F&& batch);
+    //! libera versoes antigas que nenhum leitor enxerga mais
+    std::size_t reclaim();
+    //! numero maximo de leitores registrados ao mesmo tempo
+    std::size_t max_readers() const;
+
+ private:
+    //! slot de epoca de um leitor, isolado em sua linha de cache
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> epoch{IDLE};
+        std::atomic<bool> used{false};
+    };
+    //! versao aguardando liberacao
+    struct Retired {
+        ArrayList<T>* version;
+        std::uint64_t epoch;
+    };
+
+    RcuArrayList(const RcuArrayList&) = delete;
+    RcuArrayList& operator=(const RcuArrayList&) = delete;
+    //! menor epoca anunciada por um leitor ativo
+    std::uint64_t oldest_reader() const;
+    //! libera versoes retiradas ja invisiveis (com writer_ travado)
+    std::size_t collect();
+
+    std::atomic<ArrayList<T>*> current_;
+    std::atomic<std::uint64_t> epoch_;
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<Retired> retired_;
+    std::mutex writer_;
+    std::size_t max_size_;
+
+    static const std::uint64_t IDLE = 0u;
+    static const std::size_t MAX_READERS = 128u;
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::RcuArrayList<T>::Snapshot::Snapshot(Reader* reader,
+                                                const ArrayList<T>* version) {
+    reader_ = reader;
+    version_ = version;
+}
+
+template<typename T>
+structures::RcuArrayList<T>::Snapshot::Snapshot(Snapshot&& other) {
+    reader_ = other.reader_;
+    version_ = other.version_;
+    other.reader_ = nullptr;
+    other.version_ = nullptr;
+}
+
+template<typename T>
+structures::RcuArrayList<T>::Snapshot::~Snapshot() {
+    if (reader_ != nullptr) {
+        reader_->unpin();
+    }
+}
+
+template<typename T>
+const structures::ArrayList<T>&
+structures::RcuArrayList<T>::Snapshot::operator*() const {
+    return *version_;
+}
+
+template<typename T>
+const structures::ArrayList<T>*
+structures::RcuArrayList<T>::Snapshot::operator->() const {
+    return version_;
+}
+
+template<typename T>
+structures::RcuArrayList<T>::Reader::Reader(RcuArrayList* list,
+                                            std::size_t slot) {
+    list_ = list;
+    slot_ = slot;
+    depth_ = 0;
+}
+
+template<typename T>
+structures::RcuArrayList<T>::Reader::Reader(Reader&& other) {
+    list_ = other.list_;
+    slot_ = other.slot_;
+    depth_ = other.depth_;
+    other.list_ = nullptr;
+}
+
+template<typename T>
+structures::RcuArrayList<T>::Reader::~Reader() {
+    if (list_ != nullptr) {
+        list_->slots_[slot_].epoch.store(IDLE, std::memory_order_release);
+        list_->slots_[slot_].used.store(false, std::memory_order_release);
+    }
+}
+
+template<typename T>
+typename structures::RcuArrayList<T>::Snapshot
+structures::RcuArrayList<T>::Reader::snapshot() {
+    if (depth_++ == 0) {
+        // anuncia a epoca antes de ler a versao (ordem seq_cst)
+        std::uint64_t epoch = list_->epoch_.load(std::memory_order_seq_cst);
+        list_->slots_[slot_].epoch.store(epoch, std::memory_order_seq_cst);
+    }
+    return Snapshot(this, list_->current_.load(std::memory_order_seq_cst));
+}
+
+template<typename T>
+void structures::RcuArrayList<T>::Reader::unpin() {
+    if (--depth_ == 0) {
+        list_->slots_[slot_].epoch.store(IDLE, std::memory_order_release);
+    }
+}
+
+template<typename T>
+structures::RcuArrayList<T>::RcuArrayList(std::size_t max_size):
+    current_{new ArrayList<T>(max_size)},
+    epoch_{1},
+    slots_{new Slot[MAX_READERS]},
+    max_size_{max_size}
+{}
+
+template<typename T>
+structures::RcuArrayList<T>::~RcuArrayList() {
+    for (auto& retired : retired_) {
+        delete retired.version;
+    }
+    delete current_.load();
+}
+
+template<typename T>
+typename structures::RcuArrayList<T>::Reader
+structures::RcuArrayList<T>::reader() {
+    for (std::size_t i = 0; i < MAX_READERS; i++) {
+        bool expected = false;
+        if (!slots_[i].used.load(std::memory_order_relaxed) &&
+            slots_[i].used.compare_exchange_strong(expected, true)) {
+            return Reader(this, i);
+        }
+    }
+    raise_out_of_range("leitores demais");
+}
+
+template<typename T>
+template<typename F>
+void structures::RcuArrayList<T>::update(F&& batch) {
+    std::lock_guard<std::mutex> lock(writer_);
+    ArrayList<T>* old = current_.load(std::memory_order_relaxed);
+    ArrayList<T>* version = new ArrayList<T>(max_size_);
+#if STRUCTURES_EXCEPTIONS
+    try {
+#endif
+        for (std::size_t i = 0; i < old->size(); i++) {
+            version->push_back((*old)[i]);
+        }
+        batch(*version);
+#if STRUCTURES_EXCEPTIONS
+    } catch (...) {
+        delete version;
+        throw;
+    }
+#endif
+    current_.exchange(version, std::memory_order_seq_cst);
+    // leitores que ainda podem ver old anunciaram epoca <= retired
+    std::uint64_t retired = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    retired_.push_back(Retired{old, retired});
+    collect();
+}
+
+template<typename T>
+std::size_t structures::RcuArrayList<T>::reclaim() {
+    std::lock_guard<std::mutex> lock(writer_);
+    return collect();
+}
+
+template<typename T>
+std::size_t structures::RcuArrayList<T>::collect() {
+    std::uint64_t oldest = oldest_reader();
+    std::size_t kept = 0;
+    std::size_t freed = 0;
+    for (auto& item : retired_) {
+        if (item.epoch < oldest) {
+            delete item.version;
+            freed++;
+        } else {
+            retired_[kept++] = item;
+        }
+    }
+    retired_.resize(kept);
+    return freed;
+}
+
+template<typename T>
+std::uint64_t structures::RcuArrayList<T>::oldest_reader() const {
+    std::uint64_t oldest = UINT64_MAX;
+    for (std::size_t i = 0; i < MAX_READERS; i++) {
+        std::uint64_t epoch = slots_[i].epoch.load(std::memory_order_seq_cst);
+        if (epoch != IDLE && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    return oldest;
+}
+
+template<typename T>
+std::size_t structures::RcuArrayList<T>::max_readers() const {
+    return MAX_READERS;
+}
+
+#endif
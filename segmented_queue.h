@@ -0,0 +1,234 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_SEGMENTED_QUEUE_H
+#define STRUCTURES_SEGMENTED_QUEUE_H
+
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator
+#include <new>  // placement new
+#include <stdexcept>  // C++ exceptions
+#include <type_traits>
+#include <utility>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+template<typename T>
+//! CLASSE FILA SEGMENTADA
+/*!
+ *  Mesma interface de LinkedQueue, mas os dados ficam em blocos contiguos
+ *  de tamanho fixo encadeados do inicio ao fim: enqueue so aloca quando o
+ *  bloco do fim enche, uma vez a cada segment_size() dados. Blocos
+ *  esvaziados no inicio voltam para um pequeno cache e sao reaproveitados
+ *  pelo fim, entao uma fila em regime estavel nao aloca nada.
+ */
+class SegmentedQueue {
+ public:
+    //! construtor simples (blocos de ~4 KiB)
+    SegmentedQueue();
+    //! construtor com o numero de dados por bloco
+    explicit SegmentedQueue(std::size_t segment_size);
+    //! destrutor
+    ~SegmentedQueue();
+    //! limpar (blocos voltam ao cache ate o limite)
+    void clear();
+    //! enfileirar
+    void enqueue(const T& data);
+    //! enfileirar (movendo)
+    void enqueue(T&& data);
+    //! desenfileirar
+    T dequeue();
+    //! primeiro dado
+    T& front() const;
+    //! último dado
+    T& back() const;
+    //! fila vazia
+    bool empty() const;
+    //! tamanho
+    std::size_t size() const;
+    //! dados por bloco
+    std::size_t segment_size() const;
+
+ private:
+    //! bloco de tamanho fixo; [begin, end) ocupado
+    struct Segment {
+        T* contents;
+        std::size_t begin;
+        std::size_t end;
+        Segment* next;
+    };
+
+    SegmentedQueue(const SegmentedQueue&) = delete;
+    SegmentedQueue& operator=(const SegmentedQueue&) = delete;
+    //! bloco vazio do cache, ou um novo
+    Segment* acquire();
+    //! devolve um bloco vazio ao cache (ou o libera, se cheio)
+    void recycle(Segment* segment);
+    //! posicao livre no fim (encadeando bloco se preciso)
+    T* slot();
+
+    static const std::size_t CACHE_SIZE = 4u;
+    static const std::size_t SEGMENT_BYTES = 4096u;
+
+    Segment* head_;  // bloco do inicio
+    Segment* tail_;  // bloco do fim
+    Segment* cache_[CACHE_SIZE];  // blocos vazios para reuso
+    std::size_t cached_;
+    std::size_t size_;
+    std::size_t segment_size_;
+};
+
+}  // namespace structures
+
+
+template<typename T>
+structures::SegmentedQueue<T>::SegmentedQueue() :
+    SegmentedQueue(SEGMENT_BYTES / sizeof(T) > 16 ?
+                   SEGMENT_BYTES / sizeof(T) : 16)
+{}
+
+template<typename T>
+structures::SegmentedQueue<T>::SegmentedQueue(std::size_t segment_size) {
+    segment_size_ = segment_size == 0 ? 1 : segment_size;
+    head_ = nullptr;
+    tail_ = nullptr;
+    cached_ = 0;
+    size_ = 0;
+}
+
+template<typename T>
+structures::SegmentedQueue<T>::~SegmentedQueue() {
+    clear();
+    while (cached_ > 0) {
+        Segment* segment = cache_[--cached_];
+        std::allocator<T>().deallocate(segment->contents, segment_size_);
+        delete segment;
+    }
+}
+
+template<typename T>
+typename structures::SegmentedQueue<T>::Segment*
+structures::SegmentedQueue<T>::acquire() {
+    Segment* segment;
+    if (cached_ > 0) {
+        segment = cache_[--cached_];
+    } else {
+        segment = new Segment;
+        segment->contents = std::allocator<T>().allocate(segment_size_);
+    }
+    segment->begin = 0;
+    segment->end = 0;
+    segment->next = nullptr;
+    return segment;
+}
+
+template<typename T>
+void structures::SegmentedQueue<T>::recycle(Segment* segment) {
+    if (cached_ < CACHE_SIZE) {
+        cache_[cached_++] = segment;
+    } else {
+        std::allocator<T>().deallocate(segment->contents, segment_size_);
+        delete segment;
+    }
+}
+
+template<typename T>
+void structures::SegmentedQueue<T>::clear() {
+    while (head_ != nullptr) {
+        Segment* next = head_->next;
+        if (!std::is_trivially_destructible<T>::value) {
+            for (std::size_t i = head_->begin; i < head_->end; i++) {
+                head_->contents[i].~T();
+            }
+        }
+        recycle(head_);
+        head_ = next;
+    }
+    tail_ = nullptr;
+    size_ = 0;
+}
+
+template<typename T>
+T* structures::SegmentedQueue<T>::slot() {
+    if (tail_ == nullptr) {
+        head_ = tail_ = acquire();
+    } else if (tail_->end == segment_size_) {
+        tail_->next = acquire();
+        tail_ = tail_->next;
+    }
+    return tail_->contents + tail_->end;
+}
+
+template<typename T>
+void structures::SegmentedQueue<T>::enqueue(const T& data) {
+    new (slot()) T(data);
+    tail_->end++;
+    size_++;
+}
+
+template<typename T>
+void structures::SegmentedQueue<T>::enqueue(T&& data) {
+    new (slot()) T(std::move(data));
+    tail_->end++;
+    size_++;
+}
+
+template<typename T>
+T structures::SegmentedQueue<T>::dequeue() {
+    if (empty()) {
+        raise_out_of_range("fila vazia");
+    }
+    T* slot = head_->contents + head_->begin;
+    T data = std::move(*slot);
+    if (!std::is_trivially_destructible<T>::value) {
+        slot->~T();
+    }
+    head_->begin++;
+    size_--;
+    if (head_->begin == head_->end) {
+        // bloco esgotado: o ultimo bloco so e' rebobinado, os demais vao
+        // para o cache
+        if (head_ == tail_) {
+            head_->begin = 0;
+            head_->end = 0;
+        } else {
+            Segment* emptied = head_;
+            head_ = head_->next;
+            recycle(emptied);
+        }
+    }
+    return data;
+}
+
+template<typename T>
+T& structures::SegmentedQueue<T>::front() const {
+    if (empty()) {
+        raise_out_of_range("fila vazia");
+    }
+    return head_->contents[head_->begin];
+}
+
+template<typename T>
+T& structures::SegmentedQueue<T>::back() const {
+    if (empty()) {
+        raise_out_of_range("fila vazia");
+    }
+    return tail_->contents[tail_->end - 1];
+}
+
+template<typename T>
+bool structures::SegmentedQueue<T>::empty() const {
+    return size_ == 0;
+}
+
+template<typename T>
+std::size_t structures::SegmentedQueue<T>::size() const {
+    return size_;
+}
+
+template<typename T>
+std::size_t structures::SegmentedQueue<T>::segment_size() const {
+    return segment_size_;
+}
+
+#endif
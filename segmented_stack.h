@@ -0,0 +1,199 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_SEGMENTED_STACK_H
+#define STRUCTURES_SEGMENTED_STACK_H
+
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator
+#include <new>  // placement new
+#include <stdexcept>  // C++ exceptions
+#include <type_traits>
+#include <utility>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+template<typename T>
+//! CLASSE PILHA SEGMENTADA
+/*!
+ *  Pilha crescente formada por uma cadeia de blocos de tamanho fixo, cada
+ *  um com o dobro da capacidade do anterior. Crescer apenas encadeia um
+ *  bloco novo: nenhum elemento e' copiado ou realocado.
+ */
+class SegmentedStack {
+ public:
+    //! construtor simples
+    SegmentedStack();
+    //! construtor com a capacidade do primeiro bloco
+    explicit SegmentedStack(std::size_t first_segment);
+    //! destrutor
+    ~SegmentedStack();
+    //! metodo empilha
+    void push(const T& data);
+    //! metodo desempilha
+    T pop();
+    //! metodo retorna o topo
+    T& top();
+    //! metodo limpa pilha
+    void clear();
+    //! metodo retorna tamanho
+    std::size_t size();
+    //! metodo retorna capacidade alocada nos blocos em uso
+    std::size_t max_size();
+    //! verifica se esta vazia
+    bool empty();
+
+ private:
+    //! bloco de tamanho fixo
+    struct Segment {
+        T* contents;
+        std::size_t capacity;
+        std::size_t size;
+        Segment* prev;
+    };
+
+    SegmentedStack(const SegmentedStack&) = delete;
+    SegmentedStack& operator=(const SegmentedStack&) = delete;
+    //! aloca um bloco (memoria nao inicializada)
+    static Segment* new_segment(std::size_t capacity, Segment* prev);
+    //! libera um bloco (elementos ja destruidos)
+    static void delete_segment(Segment* segment);
+
+    Segment* top_;  // bloco do topo
+    Segment* spare_;  // bloco vazio mantido como cache (histerese)
+    std::size_t size_;
+    std::size_t capacity_;
+    std::size_t first_segment_;
+
+    static const auto DEFAULT_SIZE = 16u;
+};
+
+}  // namespace structures
+
+
+template<typename T>
+structures::SegmentedStack<T>::SegmentedStack() :
+    SegmentedStack(DEFAULT_SIZE)
+{}
+
+template<typename T>
+structures::SegmentedStack<T>::SegmentedStack(std::size_t first_segment) {
+    first_segment_ = first_segment == 0 ? 1 : first_segment;
+    top_ = nullptr;
+    spare_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+template<typename T>
+structures::SegmentedStack<T>::~SegmentedStack() {
+    clear();
+}
+
+template<typename T>
+typename structures::SegmentedStack<T>::Segment*
+structures::SegmentedStack<T>::new_segment(std::size_t capacity,
+                                           Segment* prev) {
+    Segment* segment = new Segment;
+    segment->contents = std::allocator<T>().allocate(capacity);
+    segment->capacity = capacity;
+    segment->size = 0;
+    segment->prev = prev;
+    return segment;
+}
+
+template<typename T>
+void structures::SegmentedStack<T>::delete_segment(Segment* segment) {
+    std::allocator<T>().deallocate(segment->contents, segment->capacity);
+    delete segment;
+}
+
+template<typename T>
+void structures::SegmentedStack<T>::push(const T& data) {
+    if (top_ == nullptr || top_->size == top_->capacity) {
+        // reaproveita o bloco em cache antes de alocar outro
+        if (spare_ != nullptr) {
+            spare_->prev = top_;
+            top_ = spare_;
+            spare_ = nullptr;
+        } else {
+            std::size_t capacity = top_ == nullptr ?
+                first_segment_ : top_->capacity * 2;
+            top_ = new_segment(capacity, top_);
+        }
+        capacity_ += top_->capacity;
+    }
+    new (top_->contents + top_->size) T(data);
+    top_->size++;
+    size_++;
+}
+
+template<typename T>
+T structures::SegmentedStack<T>::pop() {
+    if (empty()) {
+        raise_out_of_range("pilha vazia");
+    }
+    top_->size--;
+    T* slot = top_->contents + top_->size;
+    T data = std::move(*slot);
+    if (!std::is_trivially_destructible<T>::value) {
+        slot->~T();
+    }
+    size_--;
+    if (top_->size == 0 && top_->prev != nullptr) {
+        // o bloco esvaziado vira cache; um cache antigo (maior) e' liberado
+        Segment* emptied = top_;
+        top_ = top_->prev;
+        capacity_ -= emptied->capacity;
+        if (spare_ != nullptr) {
+            delete_segment(spare_);
+        }
+        spare_ = emptied;
+    }
+    return data;
+}
+
+template<typename T>
+T& structures::SegmentedStack<T>::top() {
+    if (empty()) {
+        raise_out_of_range("pilha vazia");
+    }
+    return top_->contents[top_->size - 1];
+}
+
+template<typename T>
+void structures::SegmentedStack<T>::clear() {
+    while (top_ != nullptr) {
+        Segment* prev = top_->prev;
+        if (!std::is_trivially_destructible<T>::value) {
+            for (std::size_t i = 0; i < top_->size; i++) {
+                top_->contents[i].~T();
+            }
+        }
+        delete_segment(top_);
+        top_ = prev;
+    }
+    if (spare_ != nullptr) {
+        delete_segment(spare_);
+        spare_ = nullptr;
+    }
+    size_ = 0;
+    capacity_ = 0;
+}
+
+template<typename T>
+std::size_t structures::SegmentedStack<T>::size() {
+    return size_;
+}
+
+template<typename T>
+std::size_t structures::SegmentedStack<T>::max_size() {
+    return capacity_;
+}
+
+template<typename T>
+bool structures::SegmentedStack<T>::empty() {
+    return size_ == 0;
+}
+
+#endif
@@ -0,0 +1,374 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_SOA_ARRAY_LIST_H
+#define STRUCTURES_SOA_ARRAY_LIST_H
+
+#include <cstdint>
+#include <memory>  // std::allocator
+#include <new>  // placement new
+#include <stdexcept>  // C++ Exceptions
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "./error_policy.h"
+
+namespace structures {
+
+//! Lista de campos de um agregado, especializada pelo usuario
+/*!
+ *  Exemplo:
+ *      template<> struct soa_fields<Trade> {
+ *          static constexpr auto members =
+ *              std::make_tuple(&Trade::price, &Trade::qty, &Trade::id);
+ *      };
+ */
+template<typename T>
+struct soa_fields;
+
+//! tipo do campo apontado por um ponteiro para membro
+template<typename M>
+struct member_type;
+
+template<typename C, typename M>
+struct member_type<M C::*> {
+    using type = M;
+};
+
+template<typename T>
+//! Classe ArrayList em estrutura de arrays (um array por campo)
+/*!
+ *  Cada campo de T listado em soa_fields<T> fica num array contiguo, entao
+ *  uma varredura por um campo so traz esse campo para a cache. Linhas sao
+ *  remontadas sob demanda (at) e T precisa ser default-construtivel.
+ */
+class SoaArrayList {
+    using Fields = typename std::decay<
+        decltype(soa_fields<T>::members)>::type;
+    static const std::size_t FIELDS = std::tuple_size<Fields>::value;
+
+ public:
+    //! tipo do campo I
+    template<std::size_t I>
+    using field_type = typename member_type<
+        typename std::tuple_element<I, Fields>::type>::type;
+
+    //! Metodo construtor
+    SoaArrayList();
+    //! Metodo construtor com parametro
+    explicit SoaArrayList(std::size_t max_size);
+    //! Metodo destrutor
+    ~SoaArrayList();
+    //! limpa lista
+    void clear();
+    //! adiciona no fim
+    void push_back(const T& data);
+    //! adiciona no começo
+    void push_front(const T& data);
+    //! adiciona na posicao index
+    void insert(const T& data, std::size_t index);
+    //! remove na posicao index
+    T pop(std::size_t index);
+    //! remove do fim
+    T pop_back();
+    //! remove do comeco
+    T pop_front();
+    //! verifica se a lista esta cheia
+    bool full() const;
+    //! verifica se a lista esta vazia
+    bool empty() const;
+    //! numero de posicoes ocupadas
+    std::size_t size() const;
+    //! tamanho do array
+    std::size_t max_size() const;
+    //! remonta a linha index
+    T at(std::size_t index) const;
+    //! sobrescreve a linha index
+    void set(std::size_t index, const T& data);
+    //! array contiguo do campo I (size() elementos)
+    template<std::size_t I>
+    field_type<I>* column();
+    //! array contiguo do campo I (size() elementos)
+    template<std::size_t I>
+    const field_type<I>* column() const;
+    //! campo I da linha index
+    template<std::size_t I>
+    field_type<I>& get(std::size_t index);
+    //! primeira linha cujo campo I satisfaz pred, ou size()
+    template<std::size_t I, typename Predicate>
+    std::size_t find_if(Predicate pred) const;
+    //! numero de linhas cujo campo I satisfaz pred
+    template<std::size_t I, typename Predicate>
+    std::size_t count_if(Predicate pred) const;
+
+ private:
+    template<typename F> struct Columns;
+    template<typename... M>
+    struct Columns<std::tuple<M...>> {
+        using type = std::tuple<typename member_type<M>::type*...>;
+    };
+
+    SoaArrayList(const SoaArrayList&) = delete;
+    SoaArrayList& operator=(const SoaArrayList&) = delete;
+    //! chama f(std::integral_constant<I>) para cada campo
+    template<typename F>
+    static void each_field(F&& f);
+    template<typename F, std::size_t... I>
+    static void each_field(F&& f, std::index_sequence<I...>);
+    //! abre espaco em index deslocando [index, size_) para a direita
+    void shift_right(std::size_t index);
+    //! fecha o espaco em index deslocando (index, size_) para a esquerda
+    void shift_left(std::size_t index);
+
+    typename Columns<Fields>::type columns_;
+    std::size_t size_;
+    std::size_t max_size_;
+
+    static const auto DEFAULT_MAX = 10u;
+    static const std::size_t BLOCK = 64u;
+};
+
+}  // namespace structures
+
+template <typename T>
+template <typename F>
+void structures::SoaArrayList<T>::each_field(F&& f) {
+    each_field(std::forward<F>(f), std::make_index_sequence<FIELDS>());
+}
+
+template <typename T>
+template <typename F, std::size_t... I>
+void structures::SoaArrayList<T>::each_field(F&& f,
+                                             std::index_sequence<I...>) {
+    (f(std::integral_constant<std::size_t, I>()), ...);
+}
+
+template <typename T>
+structures::SoaArrayList<T>::SoaArrayList():
+    SoaArrayList(DEFAULT_MAX)
+{}
+
+template <typename T>
+structures::SoaArrayList<T>::SoaArrayList(std::size_t max_size) {
+    max_size_ = max_size;
+    size_ = 0;
+    each_field([this](auto field) {
+        using M = field_type<decltype(field)::value>;
+        std::get<decltype(field)::value>(columns_) =
+            std::allocator<M>().allocate(max_size_);
+    });
+}
+
+template <typename T>
+structures::SoaArrayList<T>::~SoaArrayList() {
+    clear();
+    each_field([this](auto field) {
+        using M = field_type<decltype(field)::value>;
+        std::allocator<M>().deallocate(
+            std::get<decltype(field)::value>(columns_), max_size_);
+    });
+}
+
+template <typename T>
+void structures::SoaArrayList<T>::clear() {
+    each_field([this](auto field) {
+        using M = field_type<decltype(field)::value>;
+        if (!std::is_trivially_destructible<M>::value) {
+            M* column = std::get<decltype(field)::value>(columns_);
+            for (std::size_t i = 0; i < size_; i++) {
+                column[i].~M();
+            }
+        }
+    });
+    size_ = 0;
+}
+
+template <typename T>
+void structures::SoaArrayList<T>::shift_right(std::size_t index) {
+    each_field([this, index](auto field) {
+        using M = field_type<decltype(field)::value>;
+        M* column = std::get<decltype(field)::value>(columns_);
+        // a posicao size_ ainda nao foi construida: move o ultimo para la
+        new (column + size_) M(std::move(column[size_ - 1]));
+        for (std::size_t atual = size_ - 1; atual > index; atual--) {
+            column[atual] = std::move(column[atual - 1]);
+        }
+    });
+}
+
+template <typename T>
+void structures::SoaArrayList<T>::shift_left(std::size_t index) {
+    each_field([this, index](auto field) {
+        using M = field_type<decltype(field)::value>;
+        M* column = std::get<decltype(field)::value>(columns_);
+        for (std::size_t atual = index; atual + 1 < size_; atual++) {
+            column[atual] = std::move(column[atual + 1]);
+        }
+        column[size_ - 1].~M();
+    });
+}
+
+template <typename T>
+void structures::SoaArrayList<T>::push_back(const T& data) {
+    insert(data, size_);
+}
+
+template <typename T>
+void structures::SoaArrayList<T>::push_front(const T& data) {
+    insert(data, 0);
+}
+
+template <typename T>
+void structures::SoaArrayList<T>::insert(const T& data, std::size_t index) {
+    if (full()) {
+        raise_out_of_range("lista cheia");
+    }
+    if (index > size_) {
+        raise_out_of_range("posicao invalida");
+    }
+    if (index == size_) {
+        each_field([this, &data](auto field) {
+            using M = field_type<decltype(field)::value>;
+            new (std::get<decltype(field)::value>(columns_) + size_)
+                M(data.*std::get<decltype(field)::value>(
+                    soa_fields<T>::members));
+        });
+    } else {
+        shift_right(index);
+        set(index, data);
+    }
+    size_++;
+}
+
+template <typename T>
+T structures::SoaArrayList<T>::pop(std::size_t index) {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    if (index >= size_) {
+        raise_out_of_range("posicao invalida");
+    }
+    T value = at(index);
+    shift_left(index);
+    size_--;
+    return value;
+}
+
+template <typename T>
+T structures::SoaArrayList<T>::pop_back() {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    return pop(size_ - 1);
+}
+
+template <typename T>
+T structures::SoaArrayList<T>::pop_front() {
+    if (empty()) {
+        raise_out_of_range("lista vazia");
+    }
+    return pop(0);
+}
+
+template <typename T>
+bool structures::SoaArrayList<T>::full() const {
+    return size_ == max_size_;
+}
+
+template <typename T>
+bool structures::SoaArrayList<T>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T>
+std::size_t structures::SoaArrayList<T>::size() const {
+    return size_;
+}
+
+template <typename T>
+std::size_t structures::SoaArrayList<T>::max_size() const {
+    return max_size_;
+}
+
+template <typename T>
+T structures::SoaArrayList<T>::at(std::size_t index) const {
+    if (index >= size_) {
+        raise_out_of_range("posicao invalida");
+    }
+    T row{};
+    each_field([this, index, &row](auto field) {
+        row.*std::get<decltype(field)::value>(soa_fields<T>::members) =
+            std::get<decltype(field)::value>(columns_)[index];
+    });
+    return row;
+}
+
+template <typename T>
+void structures::SoaArrayList<T>::set(std::size_t index, const T& data) {
+    if (index >= size_) {
+        raise_out_of_range("posicao invalida");
+    }
+    each_field([this, index, &data](auto field) {
+        std::get<decltype(field)::value>(columns_)[index] =
+            data.*std::get<decltype(field)::value>(soa_fields<T>::members);
+    });
+}
+
+template <typename T>
+template <std::size_t I>
+typename structures::SoaArrayList<T>::template field_type<I>*
+structures::SoaArrayList<T>::column() {
+    return std::get<I>(columns_);
+}
+
+template <typename T>
+template <std::size_t I>
+const typename structures::SoaArrayList<T>::template field_type<I>*
+structures::SoaArrayList<T>::column() const {
+    return std::get<I>(columns_);
+}
+
+template <typename T>
+template <std::size_t I>
+typename structures::SoaArrayList<T>::template field_type<I>&
+structures::SoaArrayList<T>::get(std::size_t index) {
+    if (index >= size_) {
+        raise_out_of_range("posicao invalida");
+    }
+    return std::get<I>(columns_)[index];
+}
+
+template <typename T>
+template <std::size_t I, typename Predicate>
+std::size_t structures::SoaArrayList<T>::find_if(Predicate pred) const {
+    const field_type<I>* column = std::get<I>(columns_);
+    std::size_t i = 0;
+    // blocos sem desvio (vetorizaveis); so o bloco com acerto e' refeito
+    for (; i + BLOCK <= size_; i += BLOCK) {
+        unsigned hits = 0;
+        for (std::size_t j = 0; j < BLOCK; j++) {
+            hits += pred(column[i + j]) ? 1u : 0u;
+        }
+        if (hits != 0) {
+            break;
+        }
+    }
+    for (; i < size_; i++) {
+        if (pred(column[i])) {
+            return i;
+        }
+    }
+    return size_;
+}
+
+template <typename T>
+template <std::size_t I, typename Predicate>
+std::size_t structures::SoaArrayList<T>::count_if(Predicate pred) const {
+    const field_type<I>* column = std::get<I>(columns_);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < size_; i++) {
+        count += pred(column[i]) ? 1u : 0u;
+    }
+    return count;
+}
+
+#endif
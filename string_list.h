@@ -3,9 +3,29 @@
 #ifndef STRUCTURES_STRING_LIST_H
 #define STRUCTURES_STRING_LIST_H
 
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstdio>  // std::FILE
+#include <limits>
+#include <memory>  // std::allocator
+#include <new>  // placement new
 #include <stdexcept>  // C++ exceptions
 #include <cstring>
+#include <functional>  // std::less
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "./error_policy.h"
+#include "./mapped_file.h"
+#include "./string_pool.h"
 
 namespace structures {
 
@@ -19,6 +39,8 @@ class ArrayList {
     explicit ArrayList(std::size_t max_size);
     //! destrutor
     ~ArrayList();
+    //! construtor de movimento
+    ArrayList(ArrayList&& other);
 
     //! limpa lista
     void clear();
@@ -50,6 +72,8 @@ class ArrayList {
     std::size_t size() const;
     //! devolve tamanho max
     std::size_t max_size() const;
+    //! aumenta a capacidade para max_size (nunca diminui)
+    void reserve(std::size_t max_size);
     //! devolve dado em tal posicao
     T& at(std::size_t index);
     //! devolve dado em tal posicao
@@ -60,6 +84,15 @@ class ArrayList {
     const T& operator[](std::size_t index) const;
 
  protected:
+    //! constroi dado em uma posicao ainda nao inicializada
+    void construct(std::size_t index, const T& data);
+    //! destroi dado em uma posicao (nada a fazer se trivial)
+    void destroy(std::size_t index);
+    //! abre espaco em index deslocando [index, last] para a direita
+    void shift_right(std::size_t index);
+    //! fecha o espaco em index deslocando (index, last] para a esquerda
+    void shift_left(std::size_t index);
+
     //! ponteiro do tipo T
     T* contents;
     //! variavel do tamanho atual
@@ -74,7 +107,8 @@ class ArrayList {
 
 template <typename T>
 structures::ArrayList<T>::ArrayList() {
-  contents = new T[max_size_];
+  max_size_ = DEFAULT_MAX;
+  contents = std::allocator<T>().allocate(max_size_);
   size_ = 0;
   last = -1;
 }
@@ -82,18 +116,65 @@ structures::ArrayList<T>::ArrayList() {
 template <typename T>
 structures::ArrayList<T>::ArrayList(std::size_t max_size) {
   max_size_ = max_size;
-  contents = new T[max_size_];
+  contents = std::allocator<T>().allocate(max_size_);
   size_ = 0;
   last = -1;
 }
 
 template <typename T>
 structures::ArrayList<T>::~ArrayList() {
-  delete [] contents;
+  clear();
+  std::allocator<T>().deallocate(contents, max_size_);
+}
+
+template <typename T>
+structures::ArrayList<T>::ArrayList(ArrayList&& other) {
+  contents = other.contents;
+  size_ = other.size_;
+  max_size_ = other.max_size_;
+  last = other.last;
+  other.contents = nullptr;
+  other.size_ = 0;
+  other.max_size_ = 0;
+  other.last = -1;
+}
+
+template <typename T>
+void structures::ArrayList<T>::construct(std::size_t index, const T& data) {
+  new (contents + index) T(data);
+}
+
+template <typename T>
+void structures::ArrayList<T>::destroy(std::size_t index) {
+  if (!std::is_trivially_destructible<T>::value) {
+    contents[index].~T();
+  }
+}
+
+template <typename T>
+void structures::ArrayList<T>::shift_right(std::size_t index) {
+  // a posicao size_ ainda nao foi construida: move o ultimo para la
+  new (contents + size_) T(std::move(contents[size_ - 1]));
+  for (std::size_t atual = size_ - 1; atual > index; atual--) {
+    contents[atual] = std::move(contents[atual - 1]);
+  }
+}
+
+template <typename T>
+void structures::ArrayList<T>::shift_left(std::size_t index) {
+  for (std::size_t atual = index; atual + 1 < size_; atual++) {
+    contents[atual] = std::move(contents[atual + 1]);
+  }
+  destroy(size_ - 1);
 }
 
 template <typename T>
 void structures::ArrayList<T>::clear() {
+  if (!std::is_trivially_destructible<T>::value) {
+    for (std::size_t i = 0; i < size_; i++) {
+      contents[i].~T();
+    }
+  }
   size_ = 0;
   last = -1;
 }
@@ -111,10 +192,10 @@ bool structures::ArrayList<T>::empty() {
 template <typename T>
 void structures::ArrayList<T>:: push_back(const T& data) {
   if (full()) {
-    throw std::out_of_range("Lista cheia");
+    raise_out_of_range("Lista cheia");
   } else {
+    construct(size_, data);
     last++;
-    contents[last] = data;
     size_++;
   }
 }
@@ -122,92 +203,68 @@ void structures::ArrayList<T>:: push_back(const T& data) {
 template <typename T>
 void structures::ArrayList<T>::remove(const T& data) {
   if (empty()) {
-    throw std::out_of_range("Lista vazia");
+    raise_out_of_range("Lista vazia");
   } else {
       if (contains(data)) {
           pop(find(data));
       } else {
-          throw std::out_of_range("erro posicao");
+          raise_out_of_range("erro posicao");
       }
   }
 }
 
 template <typename T>
 void structures::ArrayList<T>::push_front(const T& data) {
-  int position;
   if (full()) {
-    throw std::out_of_range("lista cheia");
+    raise_out_of_range("lista cheia");
   } else {
-    last++;
-    size_++;
-    position = last;
-    while (position > 0) {
-      contents[position] = contents[position - 1];
-      position--;
-    }
-    contents[0] = data;
+    insert(data, 0);
   }
 }
 
 template <typename T>
 T structures::ArrayList<T>::pop_front() {
-  T value;
-  int position;
   if (empty()) {
-    throw std::out_of_range("lista vazia");
+    raise_out_of_range("lista vazia");
   } else {
-    last--;
-    size_--;
-    value = contents[0];
-    position = 0;
-    while (position <= last) {
-      contents[position] = contents[position + 1];
-      position++;
-    }
-    return value;
+    return pop(0);
   }
 }
 
 template <typename T>
 T structures::ArrayList<T>::pop(std::size_t index) {
-    int atual;
-    T value;
     if (index < 0 || index > last) {
-        throw std::out_of_range("erro posicao");
+        raise_out_of_range("erro posicao");
     } else {
         if (empty()) {
-            throw std::out_of_range("lista vazia");
+            raise_out_of_range("lista vazia");
         } else {
+            T value = std::move(contents[index]);
+            shift_left(index);
             last--;
             size_--;
-            value = contents[index];
-            atual = index;
-            while (atual <= last) {
-                contents[atual] = contents[atual + 1];
-                atual++;
-            }
             return value;
         }
     }
 }
 
+
 template <typename T>
 void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
-  int atual;
   if (full()) {
-    throw std::out_of_range("lista cheia");
+    raise_out_of_range("lista cheia");
   } else {
     if (index < 0 || index > (last + 1)) {
-      throw std::out_of_range("index com valor invalido");
+      raise_out_of_range("index com valor invalido");
     } else {
+      if (index == size_) {
+        construct(index, data);
+      } else {
+        shift_right(index);
+        contents[index] = data;
+      }
       last++;
       size_++;
-      atual = last;
-      while (atual > index) {
-        contents[atual] = contents[atual - 1];
-        atual--;
-      }
-    contents[index] = data;
     }
   }
 }
@@ -216,7 +273,7 @@ template <typename T>
 void structures::ArrayList<T>::insert_sorted(const T& data) {
     int atual;
     if (full()) {
-        throw std::out_of_range("lista cheia");
+        raise_out_of_range("lista cheia");
     } else {
         atual = 0;
         while (atual <= last && data > contents[atual]) {
@@ -229,9 +286,10 @@ void structures::ArrayList<T>::insert_sorted(const T& data) {
 template <typename T>
 T structures::ArrayList<T>:: pop_back() {
     if (empty()) {
-        throw std::out_of_range("lista vazia");
+        raise_out_of_range("lista vazia");
     } else {
-        T popContent = contents[last];
+        T popContent = std::move(contents[last]);
+        destroy(last);
         last--;
         size_--;
         return popContent;
@@ -267,10 +325,25 @@ std::size_t structures::ArrayList<T>::max_size() const {
     return max_size_;
 }
 
+template <typename T>
+void structures::ArrayList<T>::reserve(std::size_t max_size) {
+    if (max_size <= max_size_) {
+        return;
+    }
+    T* bigger = std::allocator<T>().allocate(max_size);
+    for (std::size_t i = 0; i < size_; i++) {
+        new (bigger + i) T(std::move(contents[i]));
+        destroy(i);
+    }
+    std::allocator<T>().deallocate(contents, max_size_);
+    contents = bigger;
+    max_size_ = max_size;
+}
+
 template <typename T>
 T& structures::ArrayList<T>::at(std::size_t index) {
     if (index > last || index < 0) {
-        throw std::out_of_range("index invalido");
+        raise_out_of_range("index invalido");
     } else {
         return contents[index];
     }
@@ -281,155 +354,989 @@ T& structures::ArrayList<T>::operator[](std::size_t index) {
     return contents[index];
 }
 
+template <typename T>
+const T& structures::ArrayList<T>::at(std::size_t index) const {
+    if (index > last || index < 0) {
+        raise_out_of_range("index invalido");
+    } else {
+        return contents[index];
+    }
+}
+
+template <typename T>
+const T& structures::ArrayList<T>::operator[](std::size_t index) const {
+    return contents[index];
+}
+
 //-------------------------------------
 
+//! opcoes de ArrayListString::load_file
+struct StringLoadOptions {
+    //! numero de threads (0 = std::thread::hardware_concurrency())
+    std::size_t threads{0};
+    //! descarta strings repetidas (inclusive as ja presentes na lista)
+    bool deduplicate{false};
+    //! deixa a lista inteira ordenada ao final da carga
+    bool sort{false};
+};
+
+//! entrada de ArrayListString: ponteiro, tamanho e prefixo embutido
+/*!
+ *  prefix guarda os 8 primeiros bytes em big-endian (zeros depois do fim),
+ *  entao comparar prefixos como inteiros da a mesma ordem de strcmp e a
+ *  maioria das comparacoes termina sem ler a string no heap.
+ */
+struct StringEntry {
+    char *data;
+    std::uint32_t length;
+    std::uint64_t prefix;
+};
+
 //! ...
 //! ArrayListString e' uma especializacao da classe ArrayList
-class ArrayListString : public ArrayList<char *> {
+/*!
+ *  Policy decide o que acontece quando uma pre-condicao falha (lista
+ *  cheia, vazia, indice invalido, string longa demais), como nas outras
+ *  listas (veja error_policy.h). Escrita em lista mapeada falha com
+ *  Status::READ_ONLY em qualquer Policy.
+ */
+template<typename Policy = ThrowPolicy>
+class BasicArrayListString : public ArrayList<StringEntry> {
  public:
+    //! retorno de uma operacao que devolveria R, conforme Policy
+    template<typename R>
+    using Result = typename Policy::template result<R>;
+
     //! construtor
-    ArrayListString() : ArrayList() {}
+    BasicArrayListString() : ArrayList() {}
     //! construtor com parametro
-    explicit ArrayListString(std::size_t max_size) : ArrayList(max_size) {}
+    explicit BasicArrayListString(std::size_t max_size) :
+        ArrayList(max_size) {}
+    //! construtor em modo internado: strings iguais dividem uma copia
+    /*!
+     *  O pool pode ser compartilhado por varias listas. Os ponteiros
+     *  devolvidos por pop pertencem ao pool e nao devem ser liberados.
+     */
+    BasicArrayListString(std::size_t max_size,
+                         std::shared_ptr<StringPool> pool) :
+        ArrayList(max_size), pool_{std::move(pool)} {}
     //! destrutor
-    ~ArrayListString();
+    ~BasicArrayListString();
+    //! construtor de movimento
+    BasicArrayListString(BasicArrayListString&& other);
 
     //! limpa lista
     void clear();
     //! empilha atras
-    void push_back(const char *data);
+    Result<void> push_back(const char *data);
     //! empilha na frente
-    void push_front(const char *data);
+    Result<void> push_front(const char *data);
     //! insere dado em index x
-    void insert(const char *data, std::size_t index);
+    Result<void> insert(const char *data, std::size_t index);
     //! insere em ordem
-    void insert_sorted(const char *data);
+    Result<void> insert_sorted(const char *data);
     //! desempilha em tal index
-    char *pop(std::size_t index);
+    Result<char *> pop(std::size_t index) noexcept(Policy::nothrow);
     //! desempilha do final
-    char *pop_back();
+    Result<char *> pop_back() noexcept(Policy::nothrow);
     //! desempilha da frente
-    char *pop_front();
+    Result<char *> pop_front() noexcept(Policy::nothrow);
     //! remove dado x
-    void remove(const char *data);
+    Result<void> remove(const char *data);
+    //! empilha atras sem lancar por pre-condicao; Status::FULL se cheia
+    Status try_push_back(const char *data);
+    //! desempilha do final em *data sem lancar; Status::EMPTY se vazia
+    Status try_pop_back(char **data) noexcept;
     //! verifica se ha dado x
     bool contains(const char *data);
+    //! verifica se ha dado x (sem strlen na chave)
+    bool contains(std::string_view data);
     //! retorna index do dado x se houver
     std::size_t find(const char *data);
+    //! retorna index do dado x se houver (sem strlen na chave)
+    std::size_t find(std::string_view data);
+    //! devolve string em tal posicao (checando limites)
+    Result<const char *> at(std::size_t index) const
+        noexcept(Policy::nothrow);
+    //! devolve string em tal posicao
+    const char *operator[](std::size_t index) const;
+
+    //! grava a lista como tabela de strings (blob + offsets)
+    void save(const char *path) const;
+    //! abre tabela gravada por save() via mmap, somente leitura
+    /*!
+     *  find/contains/operator[] sao servidos direto do mapeamento, sem
+     *  copias; varios processos compartilham as paginas do page cache.
+     *  Tamanhos, o ultimo offset e o '\0' final do blob sao sempre
+     *  conferidos; verify confere tambem o checksum e que os offsets e o
+     *  indice de prefixo crescem, o que le as tabelas inteiras.
+     */
+    static BasicArrayListString open_mapped(const char *path,
+                                            bool verify = false);
+    //! verifica se a lista esta mapeada de um arquivo
+    bool mapped() const;
+    //! pool de strings internadas, ou nullptr
+    StringPool *pool() const;
+    //! carrega arquivo texto (uma string por linha) em lote
+    /*!
+     *  O arquivo e' mapeado e dividido em blocos, um por thread, cortados
+     *  em quebras de linha. As strings vao para um unico arena do tamanho
+     *  do arquivo, que a lista libera inteiro em clear(): cada thread
+     *  copia seu bloco de uma vez e troca as quebras por '\0'. pop
+     *  devolve uma copia propria das strings do arena. A lista cresce uma
+     *  unica vez. Devolve quantas strings foram lidas do arquivo; uma
+     *  linha com MAX_LENGTH bytes ou mais falha com Status::TOO_LONG e um
+     *  arquivo que nao abre com Status::IO_ERROR, sem carregar nada.
+     */
+    Result<std::size_t> load_file(const char *path,
+                                  const StringLoadOptions& options);
+    //! carrega arquivo texto com as opcoes padrao
+    Result<std::size_t> load_file(const char *path);
+
+    //! strings com MAX_LENGTH bytes ou mais sao recusadas
+    static const std::size_t MAX_LENGTH = 10000;
+
+ private:
+    //! cabecalho da tabela de strings (64 bytes)
+    /*!
+     *  Layout: cabecalho, offsets[count + 1] (uint64, relativos ao blob),
+     *  indice de prefixo opcional[PREFIX_SLOTS + 1] e o blob com as
+     *  strings terminadas em '\0'.
+     */
+    struct TableHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianness;
+        std::uint64_t count;
+        std::uint64_t blob_size;
+        std::uint32_t flags;
+        std::uint32_t reserved0;
+        std::uint64_t checksum;
+        char reserved[16];
+    };
+
+    //! insere a entrada em index (lista nao cheia, index <= size)
+    void place(const StringEntry& entry, std::size_t index);
+    //! retira a entrada de index (index < size)
+    StringEntry take(std::size_t index);
+    //! prefixo big-endian dos 8 primeiros bytes
+    static std::uint64_t load_prefix(const char *data, std::size_t length);
+    //! copia data para o heap (ou interna no pool) e monta a entrada
+    static StringEntry make_entry(const char *data, std::size_t length,
+                                  StringPool *pool);
+    //! libera a string de uma entrada (as internadas ficam no pool e as
+    //! carregadas, no arena)
+    void release(char *data) const;
+    //! verifica se data esta em um arena de load_file
+    bool in_arena(const char *data) const;
+    //! string de uma entrada retirada, que passa a ser de quem chamou
+    char *detach(const StringEntry& entry) const;
+    //! compara a entrada com a chave (prefixo ja calculado), como strcmp
+    static int compare(const StringEntry& entry, std::string_view data,
+                       std::uint64_t prefix);
+    //! igualdade: tamanho e prefixo antes de tocar o heap
+    static bool equals(const StringEntry& entry, std::string_view data,
+                       std::uint64_t prefix);
+    //! ordem das entradas
+    static bool less(const StringEntry& a, const StringEntry& b);
+    //! chave de prefixo (dois primeiros bytes) usada no indice
+    static std::size_t prefix_key(std::string_view data);
+    //! string em tal posicao do mapeamento
+    const char *mapped_at(std::size_t index) const;
+    //! busca em tabela mapeada; devolve size_ se nao achar
+    std::size_t mapped_find(std::string_view data) const;
+    //! poe as linhas de [begin, end) em out, copiando o bloco para arena
+    //! (ou internando no pool); false se alguma e' longa
+    static bool split_lines(const char *begin, const char *end, char *arena,
+                            std::vector<StringEntry> *out, StringPool *pool);
+
+    //! bloco de strings de uma carga, liberado de uma vez
+    struct Arena {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    MappedFile mapping_;
+    const std::uint64_t *offsets_{nullptr};
+    const std::uint64_t *prefix_index_{nullptr};
+    const char *blob_{nullptr};
+    bool sorted_{false};
+    std::shared_ptr<StringPool> pool_;
+    std::vector<Arena> arenas_;
+
+    static const std::uint32_t TABLE_VERSION = 1u;
+    static const std::uint32_t ENDIAN_MARK = 0x01020304u;
+    static const std::uint32_t FLAG_SORTED = 1u;
+    static const std::uint32_t FLAG_PREFIX_INDEX = 2u;
+    static const std::size_t PREFIX_SLOTS = 1u << 16;
 };
 
+//! lista de strings com a politica padrao (lanca std::out_of_range)
+using ArrayListString = BasicArrayListString<>;
 
 }  // namespace structures
 
-structures::ArrayListString::~ArrayListString() {
-    // delete [] contents;
+template<typename P>
+structures::BasicArrayListString<P>::~BasicArrayListString() {
+    clear();
+}
+
+template<typename P>
+structures::BasicArrayListString<P>::BasicArrayListString(
+                                        BasicArrayListString&& other) :
+    ArrayList(std::move(other)) {
+    mapping_ = std::move(other.mapping_);
+    offsets_ = other.offsets_;
+    prefix_index_ = other.prefix_index_;
+    blob_ = other.blob_;
+    sorted_ = other.sorted_;
+    pool_ = std::move(other.pool_);
+    arenas_ = std::move(other.arenas_);
+    other.offsets_ = nullptr;
+    other.prefix_index_ = nullptr;
+    other.blob_ = nullptr;
+    other.sorted_ = false;
 }
-void structures::ArrayListString::clear() {
+
+template<typename P>
+void structures::BasicArrayListString<P>::clear() {
+    if (mapped()) {
+        // lista mapeada nao possui as strings: apenas desfaz o mapeamento
+        mapping_.close();
+        offsets_ = nullptr;
+        prefix_index_ = nullptr;
+        blob_ = nullptr;
+        sorted_ = false;
+        size_ = 0;
+        max_size_ = 0;
+        last = -1;
+        return;
+    }
+    for (int i = 0; i <= last; i++) {
+        release(contents[i].data);
+    }
+    arenas_.clear();
     size_ = 0;
     last = -1;
 }
 
-void structures::ArrayListString::insert(const char *data, std::size_t index) {
-    std::size_t stringLength = strlen(data);
-    if (stringLength < 1000) {
-        char* dataPointer = new char[stringLength + 1];
-        snprintf(dataPointer, strlen(data) + 1, "%s", data);
-        ArrayList::insert(dataPointer, index);
+template<typename P>
+void structures::BasicArrayListString<P>::place(const StringEntry& entry,
+                                                std::size_t index) {
+    if (index == size_) {
+        construct(index, entry);
     } else {
-        throw std::out_of_range("string maior que 10.000");
+        shift_right(index);
+        contents[index] = entry;
     }
+    last++;
+    size_++;
+}
+
+template<typename P>
+structures::StringEntry
+structures::BasicArrayListString<P>::take(std::size_t index) {
+    StringEntry entry = contents[index];
+    shift_left(index);
+    last--;
+    size_--;
+    return entry;
 }
 
-void structures::ArrayListString::push_back(const char *data) {
+template<typename P>
+typename P::template result<void>
+structures::BasicArrayListString<P>::insert(const char *data,
+                                            std::size_t index) {
+    if (mapped()) {
+        return P::template fail<void>(Status::READ_ONLY,
+                                      "lista somente leitura");
+    }
+    if (P::checked && full()) {
+        return P::template fail<void>(Status::FULL, "lista cheia");
+    }
+    if (P::checked && index > size_) {
+        return P::template fail<void>(Status::INVALID_INDEX,
+                                      "index com valor invalido");
+    }
     std::size_t stringLength = strlen(data);
-    if (stringLength < 10000) {
-        char* dataPointer = new char[stringLength + 1];
-        snprintf(dataPointer, strlen(data) + 1, "%s", data);
-        ArrayList::push_back(dataPointer);
-    } else {
-        std::out_of_range("string maior que 10.000");
+    if (P::checked && stringLength >= MAX_LENGTH) {
+        return P::template fail<void>(Status::TOO_LONG,
+                                      "string maior que 10.000");
     }
+    place(make_entry(data, stringLength, pool_.get()), index);
+    return typename P::template result<void>();
+}
+
+template<typename P>
+typename P::template result<void>
+structures::BasicArrayListString<P>::push_back(const char *data) {
+    return insert(data, size_);
+}
+
+template<typename P>
+typename P::template result<void>
+structures::BasicArrayListString<P>::push_front(const char *data) {
+    return insert(data, 0);
 }
 
-void structures::ArrayListString::push_front(const char *data) {
+template<typename P>
+typename P::template result<void>
+structures::BasicArrayListString<P>::insert_sorted(const char *data) {
+    if (mapped()) {
+        return P::template fail<void>(Status::READ_ONLY,
+                                      "lista somente leitura");
+    }
+    if (P::checked && full()) {
+        return P::template fail<void>(Status::FULL, "Lista cheia");
+    }
     std::size_t stringLength = strlen(data);
-    if (full()) {
-        throw std::out_of_range("Lista cheia");
-    } else {
-        if (stringLength < 10000) {
-            char* dataPointer = new char[stringLength + 1];
-            snprintf(dataPointer, strlen(data) + 1, "%s", data);
-            ArrayList::push_front(dataPointer);
-        } else {
-            std::out_of_range("string maior que 10.000");
-        }
+    if (P::checked && stringLength >= MAX_LENGTH) {
+        return P::template fail<void>(Status::TOO_LONG,
+                                      "string maior que 10.000");
+    }
+    std::string_view key(data, stringLength);
+    std::uint64_t prefix = load_prefix(data, stringLength);
+    std::size_t index = 0;
+    while (index < size_ && compare(contents[index], key, prefix) < 0) {
+        index++;
     }
+    place(make_entry(data, stringLength, pool_.get()), index);
+    return typename P::template result<void>();
 }
 
-void structures::ArrayListString::insert_sorted(const char *data) {
-    std::size_t stringLength = strlen(data);
-    if (full()) {
-        throw std::out_of_range("Lista cheia");
-    } else {
-        if (stringLength < 10000) {
-            std::size_t index = 0;
-            while (index < size_ && strcmp(contents[index], data) < 0) {
-                index++;
-            }
-            char* dataPointer = new char[stringLength + 1];
-            snprintf(dataPointer, strlen(data) + 1, "%s", data);
-            ArrayList::insert(dataPointer, index);
-        } else {
-            std::out_of_range("string maior que 10.000");
-        }
+template<typename P>
+typename P::template result<char *>
+structures::BasicArrayListString<P>::pop(std::size_t index)
+    noexcept(P::nothrow) {
+    if (mapped()) {
+        return P::template fail<char *>(Status::READ_ONLY,
+                                        "lista somente leitura");
+    }
+    if (P::checked && empty()) {
+        return P::template fail<char *>(Status::EMPTY, "lista vazia");
     }
+    if (P::checked && index >= size_) {
+        return P::template fail<char *>(Status::INVALID_INDEX,
+                                        "erro posicao");
+    }
+    return detach(take(index));
 }
 
-char* structures::ArrayListString::pop(std::size_t index) {
-    return ArrayList::pop(index);
+template<typename P>
+typename P::template result<char *>
+structures::BasicArrayListString<P>::pop_back() noexcept(P::nothrow) {
+    return pop(size_ - 1);
 }
 
-char* structures::ArrayListString::pop_back() {
-    return ArrayList::pop_back();
+template<typename P>
+typename P::template result<char *>
+structures::BasicArrayListString<P>::pop_front() noexcept(P::nothrow) {
+    return pop(0);
 }
 
-char* structures::ArrayListString::pop_front() {
-    return ArrayList::pop_front();
+template<typename P>
+typename P::template result<void>
+structures::BasicArrayListString<P>::remove(const char *data) {
+    if (mapped()) {
+        return P::template fail<void>(Status::READ_ONLY,
+                                      "lista somente leitura");
+    }
+    if (P::checked && empty()) {
+        return P::template fail<void>(Status::EMPTY, "lista vazia");
+    }
+    std::size_t index = find(data);
+    if (index == size_) {
+        if (P::checked) {
+            return P::template fail<void>(Status::NOT_FOUND, "erro posicao");
+        }
+        return typename P::template result<void>();
+    }
+    release(take(index).data);
+    return typename P::template result<void>();
+}
+
+template<typename P>
+structures::Status
+structures::BasicArrayListString<P>::try_push_back(const char *data) {
+    if (mapped()) {
+        return Status::READ_ONLY;
+    }
+    if (full()) {
+        return Status::FULL;
+    }
+    std::size_t stringLength = strlen(data);
+    if (stringLength >= MAX_LENGTH) {
+        return Status::TOO_LONG;
+    }
+    place(make_entry(data, stringLength, pool_.get()), size_);
+    return Status::OK;
 }
 
-void structures::ArrayListString::remove(const char *data) {
+template<typename P>
+structures::Status
+structures::BasicArrayListString<P>::try_pop_back(char **data) noexcept {
+    if (mapped()) {
+        return Status::READ_ONLY;
+    }
     if (empty()) {
-        std::out_of_range("lista vazia");
-    } else {
-        if (contains(data)) {
-            pop(find(data));
-        }
+        return Status::EMPTY;
     }
+    *data = detach(take(size_ - 1));
+    return Status::OK;
+}
+
+template<typename P>
+bool structures::BasicArrayListString<P>::contains(const char *data) {
+    return contains(std::string_view(data));
 }
 
-bool structures::ArrayListString::contains(const char *data) {
+template<typename P>
+bool structures::BasicArrayListString<P>::contains(std::string_view data) {
+    return !empty() && find(data) != size_;
+}
+
+template<typename P>
+std::size_t structures::BasicArrayListString<P>::find(const char *data) {
+    return find(std::string_view(data));
+}
+
+template<typename P>
+std::size_t structures::BasicArrayListString<P>::find(std::string_view data) {
     if (empty()) {
-        std::out_of_range("lista vazia");
+        return size_;
+    } else if (mapped()) {
+        return mapped_find(data);
+    } else if (pool_) {
+        // internadas: igualdade e' comparacao de ponteiros
+        const char *interned = pool_->lookup(data);
+        for (int i = 0; interned != nullptr && i <= last; i++) {
+            if (this->contents[i].data == interned) {
+                return i;
+            }
+        }
     } else {
+        std::uint64_t prefix = load_prefix(data.data(), data.size());
         for (int i = 0; i <= last; i++) {
-            if (strcmp(this->contents[i], data) == 0) {
-                return true;
+            if (equals(this->contents[i], data, prefix)) {
+                return i;
             }
         }
     }
+    return size_;
+}
+
+template<typename P>
+typename P::template result<const char *>
+structures::BasicArrayListString<P>::at(std::size_t index) const
+    noexcept(P::nothrow) {
+    if (P::checked && index >= size_) {
+        return P::template fail<const char *>(Status::INVALID_INDEX,
+                                              "index invalido");
+    }
+    return (*this)[index];
+}
+
+template<typename P>
+const char*
+structures::BasicArrayListString<P>::operator[](std::size_t index) const {
+    if (mapped()) {
+        return mapped_at(index);
+    }
+    return contents[index].data;
+}
+
+template<typename P>
+bool structures::BasicArrayListString<P>::mapped() const {
+    return mapping_.is_open();
+}
+
+template<typename P>
+structures::StringPool *structures::BasicArrayListString<P>::pool() const {
+    return pool_.get();
+}
+
+template<typename P>
+void structures::BasicArrayListString<P>::release(char *data) const {
+    if (!pool_ && !in_arena(data)) {
+        delete [] data;
+    }
+}
+
+template<typename P>
+bool structures::BasicArrayListString<P>::in_arena(const char *data) const {
+    std::less<const char *> before;
+    for (const Arena& arena : arenas_) {
+        const char *begin = arena.data.get();
+        if (!before(data, begin) && before(data, begin + arena.size)) {
+            return true;
+        }
+    }
     return false;
 }
 
-std::size_t structures::ArrayListString::find(const char *data) {
-    if (empty()) {
-        std::out_of_range("lista vazia");
+template<typename P>
+char *structures::BasicArrayListString<P>::detach(
+                                        const StringEntry& entry) const {
+    if (!in_arena(entry.data)) {
+        return entry.data;
+    }
+    // o arena so e' liberado inteiro: quem chamou recebe uma copia
+    char *copy = new char[entry.length + 1];
+    memcpy(copy, entry.data, entry.length + 1);
+    return copy;
+}
+
+template<typename P>
+std::uint64_t
+structures::BasicArrayListString<P>::load_prefix(const char *data,
+                                                 std::size_t length) {
+    std::uint64_t prefix = 0;
+    for (std::size_t i = 0; i < 8; i++) {
+        std::uint64_t byte = 0;
+        if (i < length) {
+            byte = static_cast<unsigned char>(data[i]);
+        }
+        prefix = (prefix << 8) | byte;
+    }
+    return prefix;
+}
+
+template<typename P>
+structures::StringEntry
+structures::BasicArrayListString<P>::make_entry(const char *data,
+                                                std::size_t length,
+                                                StringPool *pool) {
+    char *dataPointer;
+    if (pool != nullptr) {
+        dataPointer = const_cast<char *>(
+            pool->intern(std::string_view(data, length)));
     } else {
-        for (int i = 0; i <= last; i++) {
-            if (strcmp(this->contents[i], data) == 0) {
+        dataPointer = new char[length + 1];
+        memcpy(dataPointer, data, length);
+        dataPointer[length] = '\0';
+    }
+    return StringEntry{dataPointer, static_cast<std::uint32_t>(length),
+                       load_prefix(data, length)};
+}
+
+template<typename P>
+int structures::BasicArrayListString<P>::compare(const StringEntry& entry,
+                                                 std::string_view data,
+                                                 std::uint64_t prefix) {
+    if (entry.prefix != prefix) {
+        return entry.prefix < prefix ? -1 : 1;
+    }
+    // 8 primeiros bytes iguais: compara o resto e desempata pelo tamanho
+    std::size_t shorter = std::min<std::size_t>(entry.length, data.size());
+    if (shorter > 8) {
+        int comparison = memcmp(entry.data + 8, data.data() + 8, shorter - 8);
+        if (comparison != 0) {
+            return comparison;
+        }
+    }
+    if (entry.length == data.size()) {
+        return 0;
+    }
+    return entry.length < data.size() ? -1 : 1;
+}
+
+template<typename P>
+bool structures::BasicArrayListString<P>::equals(const StringEntry& entry,
+                                                 std::string_view data,
+                                                 std::uint64_t prefix) {
+    return entry.length == data.size() && entry.prefix == prefix &&
+           (entry.length <= 8 ||
+            memcmp(entry.data + 8, data.data() + 8, entry.length - 8) == 0);
+}
+
+template<typename P>
+bool structures::BasicArrayListString<P>::less(const StringEntry& a,
+                                               const StringEntry& b) {
+    return compare(a, std::string_view(b.data, b.length), b.prefix) < 0;
+}
+
+template<typename P>
+std::size_t
+structures::BasicArrayListString<P>::prefix_key(std::string_view data) {
+    std::size_t first = 0;
+    std::size_t second = 0;
+    if (data.size() > 0) {
+        first = static_cast<unsigned char>(data[0]);
+    }
+    if (data.size() > 1) {
+        second = static_cast<unsigned char>(data[1]);
+    }
+    return (first << 8) | second;
+}
+
+template<typename P>
+const char*
+structures::BasicArrayListString<P>::mapped_at(std::size_t index) const {
+    return blob_ + offsets_[index];
+}
+
+template<typename P>
+std::size_t
+structures::BasicArrayListString<P>::mapped_find(std::string_view data) const {
+    // strcmp entre a string mapeada e a chave, que nao termina em '\0'
+    auto compare_mapped = [&data](const char *string) {
+        int comparison = strncmp(string, data.data(), data.size());
+        if (comparison != 0) {
+            return comparison;
+        }
+        return string[data.size()] == '\0' ? 0 : 1;
+    };
+    if (!sorted_) {
+        for (std::size_t i = 0; i < size_; i++) {
+            if (compare_mapped(mapped_at(i)) == 0) {
                 return i;
             }
         }
+        return size_;
+    }
+    // tabela ordenada: busca binaria restrita pelo indice de prefixo
+    std::size_t low = 0;
+    std::size_t high = size_;
+    if (prefix_index_ != nullptr) {
+        std::size_t key = prefix_key(data);
+        low = prefix_index_[key];
+        high = prefix_index_[key + 1];
+    }
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        int comparison = compare_mapped(mapped_at(middle));
+        if (comparison == 0) {
+            // volta ate a primeira ocorrencia, como na busca linear
+            while (middle > low && compare_mapped(mapped_at(middle - 1)) == 0) {
+                middle--;
+            }
+            return middle;
+        } else if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
     }
     return size_;
 }
+
+template<typename P>
+void structures::BasicArrayListString<P>::save(const char *path) const {
+    std::size_t count = size_;
+    bool sorted = true;
+    std::uint64_t *offsets = new std::uint64_t[count + 1];
+    std::uint64_t blob_size = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        offsets[i] = blob_size;
+        blob_size += strlen((*this)[i]) + 1;
+        if (i > 0 && strcmp((*this)[i - 1], (*this)[i]) > 0) {
+            sorted = false;
+        }
+    }
+    offsets[count] = blob_size;
+
+    std::uint64_t *prefix_index = nullptr;
+    if (sorted) {
+        prefix_index = new std::uint64_t[PREFIX_SLOTS + 1];
+        std::size_t i = 0;
+        for (std::size_t key = 0; key <= PREFIX_SLOTS; key++) {
+            while (i < count && prefix_key((*this)[i]) < key) {
+                i++;
+            }
+            prefix_index[key] = i;
+        }
+    }
+
+    TableHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "EDSTRTB", 8);
+    header.version = TABLE_VERSION;
+    header.endianness = ENDIAN_MARK;
+    header.count = count;
+    header.blob_size = blob_size;
+    header.flags = sorted ? FLAG_SORTED | FLAG_PREFIX_INDEX : 0;
+    header.checksum = checksum(offsets, (count + 1) * sizeof(std::uint64_t));
+
+    std::FILE *file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        delete [] offsets;
+        delete [] prefix_index;
+        raise_runtime_error(std::string("erro ao criar ") + path);
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fwrite(offsets, sizeof(std::uint64_t), count + 1, file)
+               == count + 1;
+    if (prefix_index != nullptr) {
+        ok = ok && std::fwrite(prefix_index, sizeof(std::uint64_t),
+                               PREFIX_SLOTS + 1, file) == PREFIX_SLOTS + 1;
+    }
+    for (std::size_t i = 0; ok && i < count; i++) {
+        const char *data = (*this)[i];
+        std::size_t length = offsets[i + 1] - offsets[i];
+        ok = std::fwrite(data, 1, length, file) == length;
+    }
+    ok = std::fclose(file) == 0 && ok;
+    delete [] offsets;
+    delete [] prefix_index;
+    if (!ok) {
+        raise_runtime_error(std::string("erro ao gravar ") + path);
+    }
+}
+
+template<typename P>
+structures::BasicArrayListString<P>
+structures::BasicArrayListString<P>::open_mapped(const char *path,
+                                                 bool verify) {
+    MappedFile mapping;
+    mapping.open(path);
+    if (mapping.size() < sizeof(TableHeader)) {
+        raise_runtime_error(std::string("arquivo truncado ") + path);
+    }
+    TableHeader header;
+    std::memcpy(&header, mapping.data(), sizeof(header));
+    if (std::memcmp(header.magic, "EDSTRTB", 8) != 0 ||
+        header.version != TABLE_VERSION ||
+        header.endianness != ENDIAN_MARK) {
+        raise_runtime_error(std::string("formato invalido ") + path);
+    }
+    bool has_index = (header.flags & FLAG_PREFIX_INDEX) != 0;
+    // os tamanhos vem do arquivo: compara por divisao e subtracao para
+    // nao estourar, e last e' int
+    std::uint64_t payload = mapping.size() - sizeof(TableHeader);
+    std::uint64_t index_size =
+        has_index ? (PREFIX_SLOTS + 1) * sizeof(std::uint64_t) : 0;
+    if (payload < index_size ||
+        header.count >= (payload - index_size) / sizeof(std::uint64_t) ||
+        header.count > static_cast<std::uint64_t>(
+                           std::numeric_limits<int>::max())) {
+        raise_runtime_error(std::string("tamanho invalido ") + path);
+    }
+    std::uint64_t tables =
+        (header.count + 1) * sizeof(std::uint64_t) + index_size;
+    if (header.blob_size != payload - tables) {
+        raise_runtime_error(std::string("tamanho invalido ") + path);
+    }
+
+    BasicArrayListString list(0);
+    const char *base = mapping.data() + sizeof(TableHeader);
+    list.offsets_ = reinterpret_cast<const std::uint64_t *>(base);
+    base += (header.count + 1) * sizeof(std::uint64_t);
+    if (has_index) {
+        list.prefix_index_ = reinterpret_cast<const std::uint64_t *>(base);
+        base += (PREFIX_SLOTS + 1) * sizeof(std::uint64_t);
+    }
+    list.blob_ = base;
+    // toda string termina dentro do blob
+    if (list.offsets_[0] != 0 ||
+        list.offsets_[header.count] != header.blob_size ||
+        (header.blob_size > 0 && base[header.blob_size - 1] != '\0')) {
+        raise_runtime_error(std::string("tabela invalida ") + path);
+    }
+    if (verify) {
+        bool valid = checksum(list.offsets_,
+                              (header.count + 1) * sizeof(std::uint64_t)) ==
+                     header.checksum;
+        for (std::size_t i = 0; valid && i < header.count; i++) {
+            valid = list.offsets_[i] < list.offsets_[i + 1];
+        }
+        for (std::size_t key = 0;
+             valid && list.prefix_index_ != nullptr && key <= PREFIX_SLOTS;
+             key++) {
+            valid = list.prefix_index_[key] <= header.count &&
+                    (key == 0 || list.prefix_index_[key - 1] <=
+                                 list.prefix_index_[key]);
+        }
+        if (!valid) {
+            raise_runtime_error(std::string("tabela invalida ") + path);
+        }
+    }
+    list.sorted_ = (header.flags & FLAG_SORTED) != 0;
+    list.mapping_ = std::move(mapping);
+    list.size_ = header.count;
+    list.max_size_ = 0;
+    list.last = static_cast<int>(header.count) - 1;
+    return list;
+}
+
+template<typename P>
+bool structures::BasicArrayListString<P>::split_lines(
+                                            const char *begin, const char *end,
+                                            char *arena,
+                                            std::vector<StringEntry> *out,
+                                            StringPool *pool) {
+    if (arena != nullptr) {
+        memcpy(arena, begin, end - begin);
+    }
+    while (begin < end) {
+        const char *newline = static_cast<const char *>(
+            memchr(begin, '\n', end - begin));
+        const char *line_end = newline == nullptr ? end : newline;
+        std::size_t length = line_end - begin;
+        if (length > 0 && begin[length - 1] == '\r') {
+            length--;
+        }
+        if (length >= MAX_LENGTH) {
+            return false;
+        }
+        if (arena != nullptr) {
+            // a quebra (ou o '\r') vira o '\0'; a ultima linha sem quebra
+            // usa o byte extra do fim do arena
+            arena[length] = '\0';
+            out->push_back(StringEntry{arena,
+                                       static_cast<std::uint32_t>(length),
+                                       load_prefix(begin, length)});
+            arena += line_end + 1 - begin;
+        } else {
+            out->push_back(make_entry(begin, length, pool));
+        }
+        begin = line_end + 1;
+    }
+    return true;
+}
+
+template<typename P>
+typename P::template result<std::size_t>
+structures::BasicArrayListString<P>::load_file(const char *path) {
+    return load_file(path, StringLoadOptions());
+}
+
+template<typename P>
+typename P::template result<std::size_t>
+structures::BasicArrayListString<P>::load_file(
+                                    const char *path,
+                                    const StringLoadOptions& options) {
+    if (mapped()) {
+        return P::template fail<std::size_t>(Status::READ_ONLY,
+                                             "lista somente leitura");
+    }
+    struct stat info;
+    if (::stat(path, &info) != 0) {
+        return P::template fail<std::size_t>(Status::IO_ERROR,
+                                             "erro ao abrir o arquivo");
+    }
+    if (info.st_size == 0) {
+        return 0;
+    }
+    MappedFile file;
+    if (!file.try_open(path)) {
+        return P::template fail<std::size_t>(Status::IO_ERROR,
+                                             "erro ao mapear o arquivo");
+    }
+    const char *data = file.data();
+    const char *end = data + file.size();
+
+    // blocos de pelo menos 1 MiB, cortados logo apos uma quebra de linha
+    std::size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<std::size_t>(1, std::min(threads,
+                                                file.size() >> 20));
+    if (pool_) {
+        // o pool nao e' sincronizado: internar e' sequencial
+        threads = 1;
+    }
+    std::vector<const char *> bounds(threads + 1, end);
+    bounds[0] = data;
+    for (std::size_t i = 1; i < threads; i++) {
+        const char *guess = std::max(bounds[i - 1],
+                                     data + file.size() / threads * i);
+        const char *newline = static_cast<const char *>(
+            memchr(guess, '\n', end - guess));
+        bounds[i] = newline == nullptr ? end : newline + 1;
+    }
+
+    // cada bloco copia para a mesma posicao no arena; + 1 para o '\0' da
+    // ultima linha sem quebra
+    Arena arena{nullptr, 0};
+    if (!pool_) {
+        arena.size = file.size() + 1;
+        arena.data.reset(new char[arena.size]);
+    }
+    std::vector<std::vector<StringEntry>> parts(threads);
+    std::atomic<bool> too_long{false};
+    auto work = [&](std::size_t part) {
+        char *copy = arena.data ? arena.data.get() + (bounds[part] - data)
+                                : nullptr;
+        if (!split_lines(bounds[part], bounds[part + 1], copy, &parts[part],
+                         pool_.get())) {
+            too_long = true;
+        } else if (options.sort) {
+            std::sort(parts[part].begin(), parts[part].end(), less);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < threads; i++) {
+        workers.emplace_back(work, i);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    file.close();
+
+    std::size_t loaded = 0;
+    for (auto& part : parts) {
+        loaded += part.size();
+    }
+    if (too_long) {
+        // nada saiu do arena (ou do pool) ainda: ele e' liberado aqui
+        return P::template fail<std::size_t>(Status::TOO_LONG,
+                                             "string maior que 10.000");
+    }
+    if (arena.data) {
+        arenas_.push_back(std::move(arena));
+    }
+
+    // junta lista atual + partes em um vetor e aplica as opcoes
+    std::vector<StringEntry> all(contents, contents + size_);
+    all.reserve(size_ + loaded);
+    if (options.sort) {
+        std::sort(all.begin(), all.end(), less);
+    }
+    for (auto& part : parts) {
+        std::size_t middle = all.size();
+        all.insert(all.end(), part.begin(), part.end());
+        if (options.sort) {
+            std::inplace_merge(all.begin(), all.begin() + middle, all.end(),
+                               less);
+        }
+        std::vector<StringEntry>().swap(part);
+    }
+    if (options.deduplicate) {
+        std::size_t kept = 0;
+        if (options.sort) {
+            for (std::size_t i = 0; i < all.size(); i++) {
+                if (kept > 0 && equals(all[kept - 1],
+                                       std::string_view(all[i].data,
+                                                        all[i].length),
+                                       all[i].prefix)) {
+                    release(all[i].data);
+                } else {
+                    all[kept++] = all[i];
+                }
+            }
+        } else {
+            std::unordered_set<std::string_view> seen(all.size());
+            for (std::size_t i = 0; i < all.size(); i++) {
+                if (!seen.insert(std::string_view(all[i].data,
+                                                  all[i].length)).second) {
+                    release(all[i].data);
+                } else {
+                    all[kept++] = all[i];
+                }
+            }
+        }
+        all.resize(kept);
+    }
+
+    reserve(all.size());
+    for (std::size_t i = 0; i < all.size(); i++) {
+        contents[i] = all[i];
+    }
+    size_ = all.size();
+    last = static_cast<int>(size_) - 1;
+    return loaded;
+}
+
 #endif
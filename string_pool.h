@@ -0,0 +1,126 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_STRING_POOL_H
+#define STRUCTURES_STRING_POOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace structures {
+
+//! Classe de pool de strings internadas
+/*!
+ *  Cada string distinta e' guardada uma unica vez, terminada em '\0', em
+ *  blocos grandes que nunca se movem; os ponteiros devolvidos valem ate o
+ *  pool ser destruido. A busca e' por tabela hash, entao duas strings
+ *  internadas no mesmo pool sao iguais se e somente se os ponteiros sao
+ *  iguais. Nao e' sincronizado: listas em threads diferentes precisam de
+ *  pools diferentes.
+ */
+class StringPool {
+ public:
+    //! construtor padrão
+    StringPool();
+    //! destrutor (invalida todos os ponteiros)
+    ~StringPool();
+    //! copia unica de data, inserindo se ainda nao existe
+    const char *intern(std::string_view data);
+    //! copia unica de data, ou nullptr se nao foi internada
+    const char *lookup(std::string_view data) const;
+    //! numero de strings distintas
+    std::size_t size() const;
+    //! bytes das strings guardadas (com os '\0')
+    std::size_t bytes() const;
+    //! bytes que deixaram de ser copiados por repeticao
+    std::size_t saved() const;
+    //! memoria dos blocos e da tabela
+    std::size_t memory_usage() const;
+
+ private:
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    //! espaco para length bytes no bloco atual (ou num novo)
+    char *allocate(std::size_t length);
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::unordered_set<std::string_view> index_;
+    char *cursor_;
+    std::size_t available_;
+    std::size_t bytes_;
+    std::size_t saved_;
+    std::size_t block_bytes_;  // soma do tamanho dos blocos
+
+    static const std::size_t BLOCK_SIZE = 64u * 1024u;
+};
+
+}  // namespace structures
+
+inline structures::StringPool::StringPool() {
+    cursor_ = nullptr;
+    available_ = 0;
+    bytes_ = 0;
+    saved_ = 0;
+    block_bytes_ = 0;
+}
+
+inline structures::StringPool::~StringPool() {}
+
+inline char *structures::StringPool::allocate(std::size_t length) {
+    if (length > available_) {
+        // strings maiores que um bloco ganham bloco proprio
+        std::size_t size = length > BLOCK_SIZE ? length : BLOCK_SIZE;
+        blocks_.emplace_back(new char[size]);
+        block_bytes_ += size;
+        if (size > BLOCK_SIZE) {
+            return blocks_.back().get();
+        }
+        cursor_ = blocks_.back().get();
+        available_ = size;
+    }
+    char *result = cursor_;
+    cursor_ += length;
+    available_ -= length;
+    return result;
+}
+
+inline const char *structures::StringPool::intern(std::string_view data) {
+    auto it = index_.find(data);
+    if (it != index_.end()) {
+        saved_ += data.size() + 1;
+        return it->data();
+    }
+    char *copy = allocate(data.size() + 1);
+    memcpy(copy, data.data(), data.size());
+    copy[data.size()] = '\0';
+    index_.insert(std::string_view(copy, data.size()));
+    bytes_ += data.size() + 1;
+    return copy;
+}
+
+inline const char *structures::StringPool::lookup(std::string_view data) const {
+    auto it = index_.find(data);
+    return it == index_.end() ? nullptr : it->data();
+}
+
+inline std::size_t structures::StringPool::size() const {
+    return index_.size();
+}
+
+inline std::size_t structures::StringPool::bytes() const {
+    return bytes_;
+}
+
+inline std::size_t structures::StringPool::saved() const {
+    return saved_;
+}
+
+inline std::size_t structures::StringPool::memory_usage() const {
+    // aproximacao da tabela: um nodo (view + hash + ponteiro) por string
+    return block_bytes_ + index_.bucket_count() * sizeof(void *) +
+           index_.size() * (sizeof(std::string_view) + 2 * sizeof(void *));
+}
+
+#endif
@@ -0,0 +1,296 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_TASK_SCHEDULER_H
+#define STRUCTURES_TASK_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "./error_policy.h"
+#include "./work_stealing_deque.h"
+
+namespace structures {
+
+//! Classe escalonador fork-join com roubo de trabalho
+/*!
+ *  Cada worker tem um WorkStealingDeque proprio: tarefas criadas por um
+ *  worker vao para o fundo do seu deque e sao executadas em ordem LIFO
+ *  (boa localidade); workers ociosos roubam do topo dos outros. Tarefas
+ *  criadas fora dos workers entram numa fila global com lock. Group::wait
+ *  nao bloqueia a thread: ela executa tarefas pendentes enquanto espera,
+ *  entao recursao fork-join (fib, quicksort) nao esgota os workers.
+ */
+class TaskScheduler {
+ public:
+    //! conjunto de tarefas esperadas juntas
+    class Group {
+     public:
+        //! construtor
+        explicit Group(TaskScheduler* scheduler);
+        //! destrutor (espera as tarefas)
+        ~Group();
+        //! agenda f() neste grupo
+        template<typename F>
+        void run(F&& f);
+        //! executa tarefas ate o grupo terminar; relanca a 1a excecao
+        void wait();
+
+     private:
+        friend class TaskScheduler;
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+        //! marca uma tarefa como terminada
+        void finish(std::exception_ptr error);
+
+        TaskScheduler* scheduler_;
+        std::atomic<std::size_t> pending_;
+        std::exception_ptr error_;
+        std::mutex error_lock_;
+    };
+
+    //! construtor (0 workers = um por nucleo)
+    explicit TaskScheduler(std::size_t workers = 0);
+    //! destrutor (descarta tarefas nao iniciadas)
+    ~TaskScheduler();
+    //! numero de workers
+    std::size_t workers() const;
+
+ private:
+    struct Task {
+        std::function<void()> function;
+        Group* group;
+    };
+    struct Worker {
+        WorkStealingDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    //! enfileira uma tarefa (no deque do worker atual, se houver)
+    void submit(Task* task);
+    //! executa uma tarefa disponivel; false se nao achou nenhuma
+    bool run_one();
+    //! procura tarefa: proprio deque, fila global, roubo
+    Task* find_task(std::size_t self);
+    //! laco de um worker
+    void loop(std::size_t index);
+    //! indice do worker atual neste escalonador, ou workers()
+    std::size_t current() const;
+    //! escalonador e indice da thread atual
+    static std::pair<const TaskScheduler*, std::size_t>& local();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::deque<Task*> injected_;
+    std::mutex injected_lock_;
+    std::atomic<std::size_t> queued_;
+    std::atomic<std::size_t> sleeping_;
+    std::atomic<bool> stop_;
+    std::mutex sleep_lock_;
+    std::condition_variable wake_;
+
+    static const auto SPINS = 64u;
+};
+
+}  // namespace structures
+
+inline structures::TaskScheduler::Group::Group(TaskScheduler* scheduler):
+    scheduler_{scheduler},
+    pending_{0}
+{}
+
+inline structures::TaskScheduler::Group::~Group() {
+#if STRUCTURES_EXCEPTIONS
+    try {
+        wait();
+    } catch (...) {
+    }
+#else
+    wait();
+#endif
+}
+
+template<typename F>
+void structures::TaskScheduler::Group::run(F&& f) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    scheduler_->submit(new Task{std::function<void()>(std::forward<F>(f)),
+                                this});
+}
+
+inline void structures::TaskScheduler::Group::wait() {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (!scheduler_->run_one()) {
+            std::this_thread::yield();
+        }
+    }
+    std::lock_guard<std::mutex> lock(error_lock_);
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+inline void structures::TaskScheduler::Group::finish(
+                                            std::exception_ptr error) {
+    if (error) {
+        std::lock_guard<std::mutex> lock(error_lock_);
+        if (!error_) {
+            error_ = error;
+        }
+    }
+    pending_.fetch_sub(1, std::memory_order_release);
+}
+
+inline structures::TaskScheduler::TaskScheduler(std::size_t workers):
+    queued_{0},
+    sleeping_{0},
+    stop_{false}
+{
+    if (workers == 0) {
+        workers = std::thread::hardware_concurrency();
+        if (workers == 0) {
+            workers = 1;
+        }
+    }
+    for (std::size_t i = 0; i < workers; i++) {
+        workers_.emplace_back(new Worker());
+    }
+    for (std::size_t i = 0; i < workers; i++) {
+        workers_[i]->thread = std::thread([this, i] { loop(i); });
+    }
+}
+
+inline structures::TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_lock_);
+        stop_.store(true);
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+    Task* task;
+    for (auto& worker : workers_) {
+        while (worker->deque.pop(&task)) {
+            delete task;
+        }
+    }
+    for (Task* injected : injected_) {
+        delete injected;
+    }
+}
+
+inline std::size_t structures::TaskScheduler::workers() const {
+    return workers_.size();
+}
+
+inline std::pair<const structures::TaskScheduler*, std::size_t>&
+structures::TaskScheduler::local() {
+    static thread_local std::pair<const TaskScheduler*, std::size_t> value{
+        nullptr, 0};
+    return value;
+}
+
+inline std::size_t structures::TaskScheduler::current() const {
+    auto& value = local();
+    return value.first == this ? value.second : workers_.size();
+}
+
+inline void structures::TaskScheduler::submit(Task* task) {
+    std::size_t self = current();
+    // conta antes de publicar: um worker que ve a tarefa ja ve a contagem
+    queued_.fetch_add(1, std::memory_order_seq_cst);
+    if (self < workers_.size()) {
+        workers_[self]->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(injected_lock_);
+        injected_.push_back(task);
+    }
+    if (sleeping_.load(std::memory_order_seq_cst) != 0) {
+        std::lock_guard<std::mutex> lock(sleep_lock_);
+        wake_.notify_one();
+    }
+}
+
+inline structures::TaskScheduler::Task*
+structures::TaskScheduler::find_task(std::size_t self) {
+    Task* task;
+    if (self < workers_.size() && workers_[self]->deque.pop(&task)) {
+        return task;
+    }
+    {
+        std::lock_guard<std::mutex> lock(injected_lock_);
+        if (!injected_.empty()) {
+            task = injected_.front();
+            injected_.pop_front();
+            return task;
+        }
+    }
+    // rouba comecando pelo vizinho, para espalhar os ladroes
+    std::size_t count = workers_.size();
+    for (std::size_t i = 1; i <= count; i++) {
+        std::size_t victim = (self + i) % count;
+        if (victim != self && workers_[victim]->deque.steal(&task)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+inline bool structures::TaskScheduler::run_one() {
+    Task* task = find_task(current());
+    if (task == nullptr) {
+        return false;
+    }
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    std::exception_ptr error;
+#if STRUCTURES_EXCEPTIONS
+    try {
+        task->function();
+    } catch (...) {
+        error = std::current_exception();
+    }
+#else
+    task->function();
+#endif
+    Group* group = task->group;
+    delete task;
+    group->finish(error);
+    return true;
+}
+
+inline void structures::TaskScheduler::loop(std::size_t index) {
+    local() = std::make_pair(this, index);
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (run_one()) {
+            continue;
+        }
+        bool found = false;
+        for (std::size_t i = 0; i < SPINS && !found; i++) {
+            std::this_thread::yield();
+            found = queued_.load(std::memory_order_relaxed) != 0;
+        }
+        if (found) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_lock_);
+        sleeping_.fetch_add(1, std::memory_order_seq_cst);
+        wake_.wait(lock, [this] {
+            return stop_.load() ||
+                   queued_.load(std::memory_order_seq_cst) != 0;
+        });
+        sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    local() = std::make_pair(nullptr, 0);
+}
+
+#endif
@@ -0,0 +1,262 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../array_list.h"
+
+static const char* const PATH = "array_list_test.bin";
+//! mesma razao de ArrayList::GALLOP_RATIO
+static const std::size_t GALLOP = 32;
+static const int ROUNDS = 3000;
+
+//! lista gravada e reaberta via mmap
+static void test_save_and_open() {
+    structures::ArrayList<std::uint64_t> list(8);
+    for (std::uint64_t i = 0; i < 8; i++) {
+        list.push_back(i * i);
+    }
+    list.save(PATH);
+    const auto mapped =
+        structures::ArrayList<std::uint64_t>::open_mapped(PATH, false, true);
+    assert(mapped.size() == 8 && mapped[3] == 9 && mapped.at(7) == 49);
+}
+
+//! mapeamento somente leitura: mutacoes lancam, leitura nao-const vale
+static void test_read_only_throws() {
+    auto list = structures::ArrayList<std::uint64_t>::open_mapped(PATH);
+    assert(list[2] == 4 && list.at(3) == 9);
+    int thrown = 0;
+    try { list.push_back(1); } catch (const std::out_of_range&) { thrown++; }
+    try { list.pop_back(); } catch (const std::out_of_range&) { thrown++; }
+    try { list.remove(4); } catch (const std::out_of_range&) { thrown++; }
+    assert(thrown == 3 && list.size() == 8 && list[0] == 0);
+}
+
+//! escrita por operator[] num mapeamento PROT_READ termina em SIGSEGV
+static void test_read_only_faults() {
+    pid_t child = fork();
+    if (child == 0) {
+        // sem o handler do ASan e sem core: so o sinal
+        struct rlimit no_core = {0, 0};
+        setrlimit(RLIMIT_CORE, &no_core);
+        signal(SIGSEGV, SIG_DFL);
+        auto list = structures::ArrayList<std::uint64_t>::open_mapped(PATH);
+        list[0] = 1;
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    assert(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+}
+
+//! count do cabecalho que estouraria count * sizeof(T) e' recusado
+static void test_count_overflow() {
+    structures::ArrayList<std::uint64_t> list(1);
+    list.push_back(7);
+    const char* const path = "array_list_overflow.bin";
+    list.save(path);
+    // 2^61 + 1 dados de 8 bytes: o produto da a volta e parece 8 bytes
+    std::uint64_t count = (std::uint64_t(1) << 61) + 1;
+    std::FILE* file = std::fopen(path, "r+b");
+    std::fseek(file, 24, SEEK_SET);  // FileHeader::count
+    std::fwrite(&count, sizeof(count), 1, file);
+    std::fclose(file);
+    bool thrown = false;
+    try {
+        structures::ArrayList<std::uint64_t>::open_mapped(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    std::remove(path);
+    assert(thrown);
+}
+
+//! com ExpectedPolicy a recusa vem como Status::READ_ONLY
+static void test_read_only_expected() {
+    using List = structures::ArrayList<std::uint64_t,
+                                       structures::ExpectedPolicy>;
+    auto list = List::open_mapped(PATH);
+    assert(list.at(0).value() == 0 && list[1] == 1);
+    assert(list.push_back(1).error() == structures::Status::READ_ONLY);
+    assert(list.try_push_back(1) == structures::Status::READ_ONLY);
+    assert(static_cast<const List&>(list).at(1).value() == 1);
+}
+
+//! copy_on_write aceita escrita sem tocar no arquivo
+static void test_copy_on_write() {
+    auto list = structures::ArrayList<std::uint64_t>::open_mapped(PATH, true);
+    list[0] = 100;
+    const auto mapped = structures::ArrayList<std::uint64_t>::open_mapped(PATH);
+    assert(list[0] == 100 && mapped[0] == 0);
+}
+
+//! noexcept segue a Policy e o tipo guardado
+static void test_noexcept() {
+    using Throwing = structures::ArrayList<int>;
+    using Expected = structures::ArrayList<int, structures::ExpectedPolicy>;
+    using Strings = structures::ArrayList<std::string,
+                                          structures::ExpectedPolicy>;
+    static_assert(!noexcept(std::declval<Throwing&>().pop_back()), "");
+    static_assert(noexcept(std::declval<const Throwing&>()[0]), "");
+    static_assert(noexcept(std::declval<Expected&>().pop_back()), "");
+    static_assert(noexcept(std::declval<Expected&>().push_back(0)), "");
+    static_assert(noexcept(std::declval<Strings&>().pop_back()), "");
+    static_assert(!noexcept(std::declval<Strings&>().push_back("")), "");
+}
+
+//! dado r da sorteio como T: inteiros em torno de base, ou texto
+template<typename T>
+static T make_value(std::uint32_t base, std::uint32_t r) {
+    return static_cast<T>(base + r);
+}
+
+template<>
+std::string make_value<std::string>(std::uint32_t base, std::uint32_t r) {
+    return std::to_string(base + r);
+}
+
+//! size dados em ordem tirados de range valores, logo com repetidos
+template<typename T>
+static std::vector<T> random_sorted(std::mt19937* random, std::size_t size,
+                                    std::uint32_t base, std::uint32_t range) {
+    std::vector<T> values;
+    for (std::size_t i = 0; i < size; i++) {
+        values.push_back(make_value<T>(base, (*random)() % range));
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+template<typename T>
+static structures::ArrayList<T> make_list(const std::vector<T>& values,
+                                          std::size_t capacity) {
+    structures::ArrayList<T> list(capacity);
+    for (const T& value : values) {
+        list.push_back(value);
+    }
+    return list;
+}
+
+template<typename T>
+static bool equal(const structures::ArrayList<T>& list,
+                  const std::vector<T>& expected) {
+    if (list.size() != expected.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < list.size(); i++) {
+        if (!(list[i] == expected[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! as quatro operacoes de a com b conferidas com <algorithm>
+template<typename T>
+static void check_set_ops(const std::vector<T>& a, const std::vector<T>& b) {
+    std::size_t capacity = a.size() + b.size() + 1;
+    const auto other = make_list(b, capacity);
+    std::vector<T> expected;
+
+    auto list = make_list(a, capacity);
+    list.merge(other);
+    std::merge(a.begin(), a.end(), b.begin(), b.end(),
+               std::back_inserter(expected));
+    assert(equal(list, expected));
+
+    list = make_list(a, capacity);
+    list.set_union(other);
+    expected.clear();
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(expected));
+    assert(equal(list, expected));
+
+    list = make_list(a, capacity);
+    list.set_intersection(other);
+    expected.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(expected));
+    assert(equal(list, expected));
+
+    list = make_list(a, capacity);
+    list.set_difference(other);
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected));
+    assert(equal(list, expected));
+}
+
+//! a lista operada com ela mesma
+template<typename T>
+static void check_self_ops(const std::vector<T>& a) {
+    std::size_t capacity = 2 * a.size() + 1;
+    std::vector<T> doubled;
+    std::merge(a.begin(), a.end(), a.begin(), a.end(),
+               std::back_inserter(doubled));
+    auto list = make_list(a, capacity);
+    list.merge(list);
+    assert(equal(list, doubled));
+    list = make_list(a, capacity);
+    list.set_union(list);
+    assert(equal(list, a));
+    list.set_intersection(list);
+    assert(equal(list, a));
+    list.set_difference(list);
+    assert(list.empty());
+}
+
+//! tamanhos em volta do bloco de 4 e da razao de galope, com repetidos
+/*!
+ *  base desloca os valores: para uint32_t em torno de 2^31 os dados
+ *  cruzam o bit de sinal e exercitam o vies da comparacao SSE2.
+ */
+template<typename T>
+static void test_set_ops(std::uint32_t base) {
+    std::mt19937 random(7);
+    for (int round = 0; round < ROUNDS; round++) {
+        std::size_t small = random() % 10;
+        std::size_t large = random() % 10;
+        if (round % 3 == 0) {
+            // no limite do galope: uma das listas ~32x a outra
+            large = small * GALLOP + random() % 3;
+            large -= large > 0;
+        }
+        std::uint32_t range = 1 + random() % (2 * (small + large) + 1);
+        auto a = random_sorted<T>(&random, small, base - range / 2, range);
+        auto b = random_sorted<T>(&random, large, base - range / 2, range);
+        check_set_ops(a, b);
+        check_set_ops(b, a);
+        check_self_ops(a);
+    }
+}
+
+int main() {
+    test_noexcept();
+    test_set_ops<std::int32_t>(0);
+    test_set_ops<std::uint32_t>(0x80000000u);
+    test_set_ops<std::uint32_t>(0);
+    test_set_ops<std::int64_t>(0);
+    test_set_ops<std::string>(1000);
+    test_save_and_open();
+    test_read_only_throws();
+    test_read_only_faults();
+    test_count_overflow();
+    test_read_only_expected();
+    test_copy_on_write();
+    std::remove(PATH);
+    std::puts("array_list_test: ok");
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Copyright [2019] <Bryan Martins Lima>
+// TOTAL bytes de uma ArrayQueue<char> para outra atraves de um pipe e de
+// um socketpair UNIX, nos dois sentidos na mesma thread. A copia passa
+// por um buffer temporario com read/write e enqueue/dequeue byte a byte,
+// como era antes dos trechos; as outras linhas usam write_to_fd e
+// read_from_fd direto no anel, com buffer comum e espelhado. Mostra MB/s.
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+
+#include "../array_queue.h"
+#include "./bench.h"
+
+static const std::size_t TOTAL = std::size_t(1) << 28;
+static const std::size_t CAPACITY = 65536;
+
+using Queue = structures::ArrayQueue<char>;
+
+//! par de descritores nao bloqueantes: [0] leitura, [1] escrita
+static bool open_pair(bool socket, int fds[2]) {
+    int result = socket ? ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) :
+                          ::pipe(fds);
+    if (result != 0) {
+        return false;
+    }
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    return true;
+}
+
+//! byte a byte pela fila, com read/write num buffer temporario
+static std::size_t copy(int fds[2]) {
+    Queue source(CAPACITY);
+    Queue sink(CAPACITY);
+    static char buffer[CAPACITY];
+    std::size_t produced = 0;
+    std::size_t consumed = 0;
+    std::size_t sum = 0;
+    while (consumed < TOTAL) {
+        while (produced < TOTAL && !source.full()) {
+            source.enqueue(static_cast<char>(produced++));
+        }
+        std::size_t n = 0;
+        while (!source.empty()) {
+            buffer[n++] = source.dequeue();
+        }
+        ssize_t written = ::write(fds[1], buffer, n);
+        // o que o pipe nao aceitou volta para a fila, na mesma ordem
+        for (std::size_t i = written > 0 ? written : 0; i < n; i++) {
+            source.enqueue(buffer[i]);
+        }
+        ssize_t read = ::read(fds[0], buffer, sink.max_size() - sink.size());
+        for (ssize_t i = 0; i < read; i++) {
+            sink.enqueue(buffer[i]);
+        }
+        while (!sink.empty()) {
+            sum += static_cast<unsigned char>(sink.dequeue());
+            consumed++;
+        }
+    }
+    return sum;
+}
+
+//! trechos preenchidos e lidos no lugar, readv/writev direto no anel
+static std::size_t direct(int fds[2], bool mirrored) {
+    Queue source(CAPACITY, mirrored);
+    Queue sink(CAPACITY, mirrored);
+    std::size_t produced = 0;
+    std::size_t consumed = 0;
+    std::size_t sum = 0;
+    while (consumed < TOTAL) {
+        auto write = source.writable_spans();
+        std::size_t n = 0;
+        for (auto span : {write.first, write.second}) {
+            for (std::size_t i = 0; i < span.size && produced < TOTAL; i++) {
+                span.data[i] = static_cast<char>(produced++);
+                n++;
+            }
+        }
+        source.commit_write(n);
+        if (!source.empty()) {
+            source.write_to_fd(fds[1]);
+        }
+        if (!sink.full()) {
+            sink.read_from_fd(fds[0]);
+        }
+        auto read = sink.readable_spans();
+        for (auto span : {read.first, read.second}) {
+            for (std::size_t i = 0; i < span.size; i++) {
+                sum += static_cast<unsigned char>(span.data[i]);
+            }
+        }
+        consumed += read.first.size + read.second.size;
+        sink.consume(read.first.size + read.second.size);
+    }
+    return sum;
+}
+
+int main() {
+    std::printf("%zu MiB por uma fila de %zu bytes, MB/s\n", TOTAL >> 20,
+                CAPACITY);
+    std::puts("                 copia   readv/writev  espelhado");
+    for (bool socket : {false, true}) {
+        double rates[3];
+        for (int mode = 0; mode < 3; mode++) {
+            int fds[2];
+            if (!open_pair(socket, fds)) {
+                std::perror("pipe");
+                return 1;
+            }
+            bench::Stopwatch watch;
+            bench::keep(mode == 0 ? copy(fds) : direct(fds, mode == 2));
+            rates[mode] = TOTAL / watch.ms() / 1e3;
+            close(fds[0]);
+            close(fds[1]);
+        }
+        std::printf("  %-10s %10.0f %14.0f %11.0f\n",
+                    socket ? "socketpair" : "pipe", rates[0], rates[1],
+                    rates[2]);
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "../array_queue.h"
+
+using structures::ExpectedPolicy;
+using structures::Status;
+
+//! trechos legiveis e livres antes e depois da volta do buffer
+static void test_spans() {
+    structures::ArrayQueue<int> queue(8);
+    for (int i = 0; i < 6; i++) {
+        queue.enqueue(i);
+    }
+    for (int i = 0; i < 4; i++) {
+        assert(queue.dequeue() == i);
+    }
+    // posicoes 4 e 5 ocupadas
+    auto read = queue.readable_spans();
+    assert(read.first.size == 2 && read.first.data[0] == 4);
+    assert(read.second.size == 0);
+    auto write = queue.writable_spans();
+    assert(write.first.size == 2 && write.second.size == 4);
+    assert(write.second.data + 4 == read.first.data);
+    for (int i = 6; i < 10; i++) {
+        queue.enqueue(i);
+    }
+    // 4..7 no fim do buffer, 8 e 9 no inicio
+    read = queue.readable_spans();
+    assert(read.first.size == 4 && read.first.data[0] == 4);
+    assert(read.second.size == 2 && read.second.data[1] == 9);
+    write = queue.writable_spans();
+    assert(write.first.size == 2 && write.second.size == 0);
+    assert(write.first.data == read.second.data + 2);
+    queue.clear();
+    read = queue.readable_spans();
+    assert(read.first.size == 0 && read.second.size == 0);
+    write = queue.writable_spans();
+    assert(write.first.size == 8 && write.second.size == 0);
+}
+
+//! escrita direta nos trechos livres, commit_write e consume
+static void test_commit_consume() {
+    structures::ArrayQueue<int, ExpectedPolicy> queue(8);
+    for (int round = 0; round < 5; round++) {
+        // escreve 5 em ate dois trechos e confere a ordem na saida
+        auto write = queue.writable_spans();
+        int value = round * 10;
+        std::size_t left = 5;
+        for (auto span : {write.first, write.second}) {
+            for (std::size_t i = 0; i < span.size && left > 0; i++) {
+                span.data[i] = value++;
+                left--;
+            }
+        }
+        assert(left == 0 && queue.commit_write(5).has_value());
+        assert(queue.size() == 5 && *queue.back() == round * 10 + 4);
+        assert(*queue.dequeue() == round * 10);
+        assert(queue.consume(3).has_value());
+        assert(*queue.dequeue() == round * 10 + 4 && queue.empty());
+    }
+    queue.enqueue(1);
+    assert(queue.commit_write(8).error() == Status::FULL);
+    assert(queue.consume(2).error() == Status::EMPTY);
+    assert(queue.size() == 1 && queue.commit_write(7).has_value());
+    assert(queue.full() && queue.consume(8).has_value() && queue.empty());
+    structures::ArrayQueue<int> throwing(4);
+    bool thrown = false;
+    try { throwing.consume(1); } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+//! consume destroi os elementos que descarta
+static void test_consume_destroys() {
+    structures::ArrayQueue<std::string> queue(4);
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 3; i++) {
+            queue.enqueue(std::string(64, static_cast<char>('a' + i)));
+        }
+        queue.consume(2);
+        assert(queue.dequeue() == std::string(64, 'c'));
+    }
+    queue.enqueue(std::string(64, 'z'));
+}
+
+//! ida e volta por um pipe: source -> pipe -> sink, com os dois aneis
+//! dando voltas; depois do fechamento read_from_fd devolve 0
+static void round_trip(bool mirrored) {
+    int fds[2];
+    assert(pipe(fds) == 0);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    structures::ArrayQueue<char> source(5000, mirrored);
+    structures::ArrayQueue<char> sink(3000, mirrored);
+    const std::size_t total = 1u << 20;
+    std::size_t produced = 0;
+    std::size_t checked = 0;
+    while (checked < total) {
+        while (produced < total && !source.full()) {
+            source.enqueue(static_cast<char>(produced++ * 7 % 251));
+        }
+        if (!source.empty()) {
+            ssize_t written = source.write_to_fd(fds[1]);
+            assert(written > 0 || errno == EAGAIN);
+        }
+        if (!sink.full()) {
+            ssize_t read = sink.read_from_fd(fds[0]);
+            assert(read > 0 || errno == EAGAIN);
+        }
+        // confere metade pelos trechos e metade por dequeue
+        auto spans = sink.readable_spans();
+        std::size_t n = spans.first.size / 2;
+        for (std::size_t i = 0; i < n; i++) {
+            assert(spans.first.data[i] ==
+                   static_cast<char>((checked + i) * 7 % 251));
+        }
+        sink.consume(n);
+        checked += n;
+        while (!sink.empty()) {
+            assert(sink.dequeue() == static_cast<char>(checked++ * 7 % 251));
+        }
+    }
+    close(fds[1]);
+    assert(sink.read_from_fd(fds[0]) == 0);
+    close(fds[0]);
+    int thrown = 0;
+    try { sink.write_to_fd(fds[1]); } catch (const std::out_of_range&) {
+        thrown++;
+    }
+    while (!sink.full()) {
+        sink.enqueue('x');
+    }
+    try { sink.read_from_fd(fds[0]); } catch (const std::out_of_range&) {
+        thrown++;
+    }
+    assert(thrown == 2);
+}
+
+static void test_pipe_round_trip() {
+    round_trip(false);
+    round_trip(true);
+}
+
+int main() {
+    test_spans();
+    test_commit_consume();
+    test_consume_destroys();
+    test_pipe_round_trip();
+    std::puts("array_queue_test: ok");
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Custo de construir e destruir conteineres de array com capacidade
+// grande: a memoria e' reservada sem construir os dados, entao o custo
+// deve ficar perto de zero. A referencia e' new T[capacidade], que
+// constroi (e depois destroi) cada posicao.
+#include <cstdio>
+#include <string>
+
+#include "../array_list.h"
+#include "../array_queue.h"
+#include "../array_stack.h"
+#include "./bench.h"
+
+static const std::size_t CAPACITY = 1u << 22;
+static const std::size_t USED = 1000;
+static const int REPEATS = 3;
+
+//! melhor de REPEATS para make() com USED dados e a destruicao
+template<typename F>
+static double best_ms(F make) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        bench::Stopwatch watch;
+        make();
+        double ms = watch.ms();
+        best = r == 0 || ms < best ? ms : best;
+    }
+    return best;
+}
+
+template<typename T>
+static void bench_type(const char* name, const T& value) {
+    double array = best_ms([&value] {
+        T* contents = new T[CAPACITY];
+        for (std::size_t i = 0; i < USED; i++) {
+            contents[i] = value;
+        }
+        bench::keep(contents[USED - 1]);
+        delete [] contents;
+    });
+    double list = best_ms([&value] {
+        structures::ArrayList<T> list(CAPACITY);
+        for (std::size_t i = 0; i < USED; i++) {
+            list.push_back(value);
+        }
+        bench::keep(list[USED - 1]);
+    });
+    double stack = best_ms([&value] {
+        structures::ArrayStack<T> stack(CAPACITY);
+        for (std::size_t i = 0; i < USED; i++) {
+            stack.push(value);
+        }
+        bench::keep(stack.top());
+    });
+    double queue = best_ms([&value] {
+        structures::ArrayQueue<T> queue(CAPACITY);
+        for (std::size_t i = 0; i < USED; i++) {
+            queue.enqueue(value);
+        }
+        bench::keep(queue.size());
+    });
+    std::printf("  %-12s %10.3f %10.3f %10.3f %10.3f\n", name, array, list,
+                stack, queue);
+}
+
+int main() {
+    std::printf("capacidade %zu, %zu dados usados: ms por construir, "
+                "encher e destruir\n", CAPACITY, USED);
+    std::puts("  T              new T[]  ArrayList ArrayStack ArrayQueue");
+    bench_type<int>("int", 1);
+    bench_type<std::string>("std::string", std::string(32, 's'));
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright [2019] <Bryan Martins Lima>
+// AsyncQueue entre corrotinas num EventLoop (C++20): latencia de ida e
+// volta em ping-pong e vazao de um produtor para um consumidor conforme
+// o limite da fila.
+#include <cstdio>
+#include <optional>
+
+#include "../async_queue.h"
+#include "../event_loop.h"
+#include "./bench.h"
+
+using structures::AsyncQueue;
+using structures::EventLoop;
+
+static const int ROUND_TRIPS = 1000000;
+static const int ITEMS = 4000000;
+static const std::size_t LIMITS[] = {1, 16, 256, 0};
+
+static EventLoop::Task ping(AsyncQueue<int>* out, AsyncQueue<int>* in,
+                            int count, long* sum) {
+    for (int i = 0; i < count; i++) {
+        co_await out->enqueue(i);
+        std::optional<int> reply = co_await in->dequeue();
+        *sum += *reply;
+    }
+}
+
+static EventLoop::Task pong(AsyncQueue<int>* in, AsyncQueue<int>* out,
+                            int count) {
+    for (int i = 0; i < count; i++) {
+        std::optional<int> data = co_await in->dequeue();
+        co_await out->enqueue(*data);
+    }
+}
+
+static EventLoop::Task produce(AsyncQueue<int>* queue, int count) {
+    for (int i = 0; i < count; i++) {
+        co_await queue->enqueue(i);
+    }
+    queue->close();
+}
+
+static EventLoop::Task consume(AsyncQueue<int>* queue, long* sum) {
+    while (std::optional<int> data = co_await queue->dequeue()) {
+        *sum += *data;
+    }
+}
+
+//! ns por ida e volta, retomando pelo laco ou na hora
+static void bench_ping_pong() {
+    std::puts("AsyncQueue ping-pong: ns por ida e volta");
+    for (int posted = 1; posted >= 0; posted--) {
+        EventLoop loop;
+        auto executor = posted ? loop.executor() : nullptr;
+        AsyncQueue<int> there(1, executor);
+        AsyncQueue<int> back(1, executor);
+        long sum = 0;
+        loop.spawn(ping(&there, &back, ROUND_TRIPS, &sum));
+        loop.spawn(pong(&there, &back, ROUND_TRIPS));
+        bench::Stopwatch watch;
+        loop.run();
+        double ms = watch.ms();
+        bench::keep(sum);
+        std::printf("  %-8s %8.1f\n", posted ? "executor" : "inline",
+                    ms * 1e6 / ROUND_TRIPS);
+    }
+}
+
+//! dados por segundo de um produtor a um consumidor, pelo laco
+static void bench_throughput() {
+    std::puts("AsyncQueue produtor -> consumidor: milhoes de dados/s");
+    for (std::size_t limit : LIMITS) {
+        EventLoop loop;
+        AsyncQueue<int> queue(limit, loop.executor());
+        long sum = 0;
+        loop.spawn(consume(&queue, &sum));
+        loop.spawn(produce(&queue, ITEMS));
+        bench::Stopwatch watch;
+        loop.run();
+        double ms = watch.ms();
+        bench::keep(sum);
+        std::printf("  limite %4zu: %8.2f\n", limit, ITEMS / ms / 1e3);
+    }
+}
+
+int main() {
+    bench_ping_pong();
+    bench_throughput();
+    return 0;
+}
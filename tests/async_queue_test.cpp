@@ -0,0 +1,173 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Compilado com -std=c++20 (veja o Makefile).
+#include <cassert>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../async_queue.h"
+#include "../event_loop.h"
+
+using structures::AsyncQueue;
+using structures::CancelToken;
+using structures::EventLoop;
+using Queue = AsyncQueue<std::string>;
+using Log = std::vector<std::string>;
+
+//! le ate count dados, anotando cada um; "fim" se vier vazio
+static EventLoop::Task consume(Queue* queue, int count, Log* log,
+                               CancelToken* token = nullptr) {
+    for (int i = 0; i < count; i++) {
+        std::optional<std::string> data = co_await queue->dequeue(token);
+        if (!data) {
+            log->push_back("fim");
+            co_return;
+        }
+        log->push_back(*data);
+    }
+}
+
+//! envia "p0".."p<count-1>", anotando "ok" ou "falhou" para cada um
+static EventLoop::Task produce(Queue* queue, int count, Log* log,
+                               CancelToken* token = nullptr) {
+    for (int i = 0; i < count; i++) {
+        bool sent = co_await queue->enqueue("p" + std::to_string(i), token);
+        log->push_back(sent ? "ok" : "falhou");
+    }
+}
+
+//! ao receber, reenfileira na mesma fila: o flush interno volta ao
+//! externo em vez de retomar outra corrotina aninhada
+static EventLoop::Task forward(Queue* queue, Log* log) {
+    std::optional<std::string> data = co_await queue->dequeue();
+    log->push_back("recebeu " + *data);
+    queue->try_enqueue(*data + "'");
+    log->push_back("reenviou " + *data);
+}
+
+//! fila limitada: produtor espera espaco e tudo chega em ordem
+static void test_bounded() {
+    EventLoop loop;
+    Queue queue(2, loop.executor());
+    Log produced;
+    Log consumed;
+    loop.spawn(produce(&queue, 5, &produced));
+    loop.run();
+    assert(queue.size() == 2 && queue.waiting_producers() == 1);
+    assert(produced.size() == 2);
+    loop.spawn(consume(&queue, 5, &consumed));
+    loop.run();
+    assert((consumed == Log{"p0", "p1", "p2", "p3", "p4"}));
+    assert(produced.size() == 5 && queue.empty());
+    assert(queue.waiting_producers() == 0 && queue.waiting_consumers() == 0);
+}
+
+//! cancelar uma espera tira a corrotina da lista e a retoma sem dado
+static void test_cancel_parked() {
+    EventLoop loop;
+    Queue queue(1, loop.executor());
+    Log log;
+    CancelToken consumer_token;
+    loop.spawn(consume(&queue, 1, &log, &consumer_token));
+    loop.run();
+    assert(queue.waiting_consumers() == 1);
+    consumer_token.cancel();
+    assert(queue.waiting_consumers() == 0);
+    loop.run();
+    assert((log == Log{"fim"}));
+    // o dado seguinte fica na fila, nao vai para a espera cancelada
+    assert(queue.try_enqueue("a") && queue.size() == 1);
+
+    CancelToken producer_token;
+    loop.spawn(produce(&queue, 1, &log, &producer_token));
+    loop.run();
+    assert(queue.waiting_producers() == 1);
+    producer_token.cancel();
+    loop.run();
+    assert(log.back() == "falhou" && queue.waiting_producers() == 0);
+    assert(queue.size() == 1 && *queue.try_dequeue() == "a");
+
+    // token ja cancelado nem suspende
+    loop.spawn(consume(&queue, 1, &log, &consumer_token));
+    loop.run();
+    assert(log.back() == "fim" && queue.waiting_consumers() == 0);
+}
+
+//! close acorda produtores com false e consumidores sem dado
+static void test_close() {
+    EventLoop loop;
+    Queue queue(1, loop.executor());
+    Log log;
+    loop.spawn(produce(&queue, 3, &log));
+    loop.run();
+    assert((log == Log{"ok"}) && queue.waiting_producers() == 1);
+    queue.close();
+    loop.run();
+    assert((log == Log{"ok", "falhou", "falhou"}));
+    assert(queue.closed() && queue.waiting_producers() == 0);
+    // o que ja estava na fila ainda sai; depois, vazio
+    log.clear();
+    loop.spawn(consume(&queue, 2, &log));
+    loop.run();
+    assert((log == Log{"p0", "fim"}));
+    assert(!queue.try_enqueue("x"));
+}
+
+//! sem executor, uma retomada que volta a acordar nao aninha corrotinas
+static void test_flush_reentrancy() {
+    EventLoop loop;
+    Queue queue;
+    Log log;
+    loop.spawn(forward(&queue, &log));
+    loop.spawn(consume(&queue, 1, &log));
+    loop.run();
+    assert(queue.waiting_consumers() == 2);
+    // retoma forward, que entrega a consume; consume so roda depois que
+    // forward termina, pelo mesmo flush
+    queue.try_enqueue("a");
+    assert((log == Log{"recebeu a", "reenviou a", "a'"}));
+    assert(queue.waiting_consumers() == 0 && queue.empty());
+}
+
+//! com executor a retomada espera o laco; sem, acontece na hora
+static void test_executor_vs_inline() {
+    EventLoop loop;
+    Queue posted(0, loop.executor());
+    Log log;
+    loop.spawn(consume(&posted, 1, &log));
+    loop.run();
+    posted.try_enqueue("a");
+    assert(log.empty() && loop.pending() == 1);
+    loop.run();
+    assert((log == Log{"a"}));
+
+    Queue inline_queue;
+    log.clear();
+    loop.spawn(consume(&inline_queue, 1, &log));
+    loop.run();
+    inline_queue.try_enqueue("b");
+    assert((log == Log{"b"}) && loop.pending() == 0);
+}
+
+//! Task que nunca rodou e' destruida pelo laco
+static void test_unstarted_task() {
+    Queue queue;
+    Log log;
+    {
+        EventLoop loop;
+        loop.spawn(consume(&queue, 1, &log));
+    }
+    assert(log.empty() && queue.waiting_consumers() == 0);
+}
+
+int main() {
+    test_bounded();
+    test_cancel_parked();
+    test_close();
+    test_flush_reentrancy();
+    test_executor_vs_inline();
+    test_unstarted_task();
+    std::puts("async_queue_test: ok");
+    return 0;
+}
@@ -0,0 +1,32 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Apoio comum das medidas de make -C tests bench.
+#ifndef STRUCTURES_TESTS_BENCH_H
+#define STRUCTURES_TESTS_BENCH_H
+
+#include <chrono>  // NOLINT
+
+namespace bench {
+
+//! cronometro de parede, em ms desde a construcao ou do ultimo restart
+class Stopwatch {
+ public:
+    Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+    void restart() { start_ = std::chrono::steady_clock::now(); }
+    double ms() const {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start_).count();
+    }
+
+ private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+//! impede o otimizador de descartar o calculo de value
+template<typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+}  // namespace bench
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Dicionario ordenado de COUNT chaves de cada tipo (URLs e palavras):
+// BurstTrie contra std::multiset<std::string>. Mostra ms para montar, ms
+// para LOOKUPS buscas (metade ausente) e bytes de heap por chave
+// (mallinfo2, com os cabecalhos do malloc). As chaves sao geradas de
+// novo a partir do indice, sem ficar guardadas.
+#include <malloc.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <string>
+
+#include "../burst_trie.h"
+#include "./bench.h"
+
+static const std::size_t COUNT = 10000000;
+static const std::size_t LOOKUPS = 2000000;
+
+static std::size_t heap_bytes() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+//! URL de uma API, com prefixo comum longo
+static void url(std::uint64_t i, std::string* key) {
+    std::uint64_t h = mix(i);
+    *key = "https://example.com/api/v";
+    *key += std::to_string(h % 3);
+    *key += "/users/";
+    *key += std::to_string(h >> 20 & 0xfffff);
+    *key += "/items/";
+    *key += std::to_string(i);
+}
+
+//! palavra de 3 a 12 letras mais o indice em base 36
+static void word(std::uint64_t i, std::string* key) {
+    std::uint64_t h = mix(i);
+    key->clear();
+    for (std::size_t n = 3 + h % 10; n > 0; n--) {
+        h = h / 26 + mix(h);
+        key->push_back(static_cast<char>('a' + h % 26));
+    }
+    for (std::uint64_t rest = i; rest > 0; rest /= 36) {
+        key->push_back("0123456789abcdefghijklmnopqrstuvwxyz"[rest % 36]);
+    }
+}
+
+template<typename Set, typename Insert, typename Contains>
+static void run(const char* name, void (*make)(std::uint64_t, std::string*),
+                Insert insert, Contains contains) {
+    std::size_t before = heap_bytes();
+    Set set;
+    std::string key;
+    bench::Stopwatch watch;
+    for (std::size_t i = 0; i < COUNT; i++) {
+        make(i, &key);
+        insert(&set, key);
+    }
+    double build = watch.ms();
+    double per_key = static_cast<double>(heap_bytes() - before) / COUNT;
+    watch.restart();
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < LOOKUPS; i++) {
+        // indices pares existem, impares passam do fim
+        make(i % 2 == 0 ? mix(i) % COUNT : COUNT + i, &key);
+        found += contains(set, key) ? 1u : 0u;
+    }
+    double lookup = watch.ms();
+    bench::keep(found);
+    std::printf("  %-24s %9.0f %9.0f %8.1f\n", name, build, lookup, per_key);
+}
+
+int main() {
+    using Multiset = std::multiset<std::string>;
+    auto trie_insert = [](structures::BurstTrie* trie,
+                          const std::string& key) {
+        trie->insert_sorted(key);
+    };
+    auto trie_contains = [](const structures::BurstTrie& trie,
+                            const std::string& key) {
+        return trie.contains(key);
+    };
+    auto set_insert = [](Multiset* set, const std::string& key) {
+        set->insert(key);
+    };
+    auto set_contains = [](const Multiset& set, const std::string& key) {
+        return set.count(key) != 0;
+    };
+    std::printf("%zu chaves, %zu buscas: ms para montar, ms para buscar, "
+                "bytes por chave\n", COUNT, LOOKUPS);
+    run<structures::BurstTrie>("URLs BurstTrie", url, trie_insert,
+                               trie_contains);
+    run<Multiset>("URLs std::multiset", url, set_insert, set_contains);
+    run<structures::BurstTrie>("palavras BurstTrie", word, trie_insert,
+                               trie_contains);
+    run<Multiset>("palavras std::multiset", word, set_insert, set_contains);
+    return 0;
+}
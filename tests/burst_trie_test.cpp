@@ -0,0 +1,140 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../burst_trie.h"
+
+using Reference = std::multiset<std::string>;
+
+//! chave curta de alfabeto pequeno: muitos prefixos comuns e repetidos,
+//! com bytes acima de 127 para conferir a ordem sem sinal
+static std::string random_key(std::mt19937* random) {
+    static const char alphabet[] = {'a', 'b', 'c', '\x7f', '\x80', '\xff'};
+    std::string key;
+    for (std::size_t n = (*random)() % 7; n > 0; n--) {
+        key += alphabet[(*random)() % sizeof(alphabet)];
+    }
+    return key;
+}
+
+static std::vector<std::string> prefixed(const structures::BurstTrie& trie,
+                                         std::string_view prefix) {
+    std::vector<std::string> out;
+    trie.for_each_prefix(prefix, [&out](std::string_view key) {
+        out.emplace_back(key);
+    });
+    return out;
+}
+
+static std::vector<std::string> expected_prefixed(const Reference& reference,
+                                                  const std::string& prefix) {
+    std::vector<std::string> out;
+    for (auto it = reference.lower_bound(prefix);
+         it != reference.end() && it->compare(0, prefix.size(), prefix) == 0;
+         ++it) {
+        out.push_back(*it);
+    }
+    return out;
+}
+
+//! ordem, posicoes e prefixos iguais aos do multiset
+static void check(const structures::BurstTrie& trie,
+                  const Reference& reference, std::mt19937* random) {
+    assert(trie.size() == reference.size());
+    std::vector<std::string> all;
+    trie.for_each([&all](std::string_view key) { all.emplace_back(key); });
+    assert(all == std::vector<std::string>(reference.begin(),
+                                           reference.end()));
+    for (int i = 0; i < 20 && !reference.empty(); i++) {
+        std::size_t index = (*random)() % reference.size();
+        assert(trie.at(index) == all[index]);
+    }
+    for (int i = 0; i < 50; i++) {
+        std::string key = random_key(random);
+        auto it = reference.lower_bound(key);
+        bool present = it != reference.end() && *it == key;
+        assert(trie.contains(key) == present);
+        assert(trie.find(key) == (present ? static_cast<std::size_t>(
+            std::distance(reference.begin(), it)) : reference.size()));
+        std::string prefix = key.substr(0, (*random)() % (key.size() + 1));
+        assert(prefixed(trie, prefix) == expected_prefixed(reference,
+                                                           prefix));
+    }
+}
+
+//! insercoes que estouram recipientes em varios niveis e remocoes
+static void test_against_multiset() {
+    std::mt19937 random(41);
+    structures::BurstTrie trie;
+    Reference reference;
+    for (int round = 0; round < 30; round++) {
+        for (int i = 0; i < 1000; i++) {
+            std::string key = random_key(&random);
+            trie.insert_sorted(key);
+            reference.insert(key);
+        }
+        for (int i = 0; i < 400; i++) {
+            std::string key = random_key(&random);
+            auto it = reference.find(key);
+            assert(trie.remove(key) == (it != reference.end()));
+            if (it != reference.end()) {
+                reference.erase(it);
+            }
+        }
+        check(trie, reference, &random);
+    }
+    // esvazia tudo
+    while (!reference.empty()) {
+        assert(trie.remove(*reference.begin()));
+        reference.erase(reference.begin());
+    }
+    assert(trie.empty() && trie.find("a") == 0 && !trie.remove("a"));
+    assert(prefixed(trie, "").empty());
+}
+
+//! estouro com chaves de prefixo comum longo e autocomplete
+static void test_burst_prefixes() {
+    structures::BurstTrie trie;
+    std::size_t empty_memory = trie.memory_usage();
+    for (int i = 0; i < 5000; i++) {
+        std::string key = "https://example.com/" + std::to_string(i);
+        trie.insert_sorted(key.c_str());
+    }
+    trie.insert_sorted("https://example.com/");
+    trie.insert_sorted("https://example.com/");
+    assert(trie.size() == 5002);
+    assert(trie.find("https://example.com/") == 0);
+    assert(trie.at(1) == "https://example.com/");
+    assert(trie.at(2) == "https://example.com/0");
+    std::vector<std::string> hits = prefixed(trie, "https://example.com/42");
+    // 42, 420..429, 4200..4299
+    assert(hits.size() == 1 + 10 + 100);
+    assert(hits.front() == "https://example.com/42");
+    assert(hits.back() == "https://example.com/4299");
+    assert(prefixed(trie, "https://example.com/5000").empty());
+    assert(prefixed(trie, "https://example.com/").size() == 5002);
+    assert(trie.memory_usage() > empty_memory);
+    trie.clear();
+    assert(trie.empty() && trie.memory_usage() == empty_memory);
+    bool thrown = false;
+    try { trie.insert_sorted(std::string(10000, 'x')); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown && trie.empty());
+    thrown = false;
+    try { trie.at(0); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+}
+
+int main() {
+    test_against_multiset();
+    test_burst_prefixes();
+    std::puts("burst_trie_test: ok");
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Partida de uma ArrayList<uint64_t> grande: reconstruir a partir de CSV
+// contra abrir o arquivo de save() com open_mapped, com e sem verify. O
+// arquivo ja esta no page cache; a soma final toca todas as paginas.
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "../array_list.h"
+#include "./bench.h"
+
+static const char* const CSV = "cold_start_bench.csv";
+static const char* const BIN = "cold_start_bench.bin";
+static const std::size_t COUNT = 1u << 22;
+
+using List = structures::ArrayList<std::uint64_t>;
+
+static std::uint64_t sum(const List& list) {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < list.size(); i++) {
+        total += list[i];
+    }
+    return total;
+}
+
+//! abre e soma a lista, em ms
+template<typename F>
+static double time_open(F open) {
+    bench::Stopwatch watch;
+    List list = open();
+    double opened = watch.ms();
+    bench::keep(sum(list));
+    std::printf(" %9.2f", opened);
+    return watch.ms();
+}
+
+int main() {
+    {
+        List list(COUNT);
+        std::FILE* csv = std::fopen(CSV, "w");
+        for (std::uint64_t i = 0; i < COUNT; i++) {
+            list.push_back(i * 2654435761u);
+            std::fprintf(csv, "%llu\n",
+                         static_cast<unsigned long long>(list[i]));
+        }
+        std::fclose(csv);
+        list.save(BIN);
+    }
+    std::printf("%zu uint64: ms para abrir e ms ate somar tudo\n", COUNT);
+    std::printf("  CSV          ");
+    double parsed = time_open([] {
+        List list(COUNT);
+        std::ifstream csv(CSV);
+        for (std::string line; std::getline(csv, line);) {
+            list.push_back(std::strtoull(line.c_str(), nullptr, 10));
+        }
+        return list;
+    });
+    std::printf(" %9.2f\n  mmap         ", parsed);
+    double mapped = time_open([] { return List::open_mapped(BIN); });
+    std::printf(" %9.2f\n  mmap+verify  ", mapped);
+    double verified = time_open([] {
+        return List::open_mapped(BIN, false, true);
+    });
+    std::printf(" %9.2f\n", verified);
+    std::remove(CSV);
+    std::remove(BIN);
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Copyright [2019] <Bryan Martins Lima>
+// COUNT ints numa CompactDoublyList e numa DoublyCircularList: memoria do
+// heap (mallinfo2, com os cabecalhos do malloc) e ms para percorrer a
+// lista inteira (find de um valor ausente). A lista e' montada com
+// push_front e push_back sorteados e depois gira metade dos dados
+// (pop_front + push_back), o que espalha os nodos pela memoria; a versao
+// compacta e' medida de novo depois de compact().
+#include <malloc.h>
+
+#include <cstdio>
+#include <random>
+
+#include "../compact_doubly_list.h"
+#include "../doubly_circular_list.h"
+#include "./bench.h"
+
+static const std::size_t COUNT = 20000000;
+static const int REPEATS = 3;
+
+//! bytes em uso no heap agora
+static std::size_t heap_bytes() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+//! monta a lista e devolve os bytes que ela ocupa no heap
+template<typename List>
+static std::size_t build(List* list) {
+    std::size_t before = heap_bytes();
+    std::mt19937 random(38);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        if (random() % 2) {
+            list->push_back(static_cast<int>(i));
+        } else {
+            list->push_front(static_cast<int>(i));
+        }
+    }
+    for (std::size_t i = 0; i < COUNT / 2; i++) {
+        list->push_back(list->pop_front());
+    }
+    return heap_bytes() - before;
+}
+
+//! melhor de REPEATS percursos completos
+template<typename List>
+static double traverse_ms(const List& list) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        bench::Stopwatch watch;
+        bench::keep(list.find(-1));
+        double ms = watch.ms();
+        best = r == 0 || ms < best ? ms : best;
+    }
+    return best;
+}
+
+int main() {
+    std::printf("%zu ints: MiB no heap e ms por percurso\n", COUNT);
+    {
+        structures::DoublyCircularList<int> list;
+        std::size_t bytes = build(&list);
+        std::printf("  DoublyCircularList         %8.1f %8.1f\n",
+                    bytes / 1048576.0, traverse_ms(list));
+    }
+    structures::CompactDoublyList<int> list;
+    std::size_t bytes = build(&list);
+    std::printf("  CompactDoublyList          %8.1f %8.1f\n",
+                bytes / 1048576.0, traverse_ms(list));
+    std::size_t before = heap_bytes();
+    list.compact();
+    std::printf("  CompactDoublyList+compact  %8.1f %8.1f\n",
+                (bytes + heap_bytes() - before) / 1048576.0,
+                traverse_ms(list));
+    return 0;
+}
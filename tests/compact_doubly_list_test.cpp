@@ -0,0 +1,173 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <list>
+#include <random>
+#include <stdexcept>
+
+#include "../compact_doubly_list.h"
+
+using List = structures::CompactDoublyList<int>;
+
+//! mesma sequencia que a lista de referencia
+static void check(const List& list, const std::list<int>& expected) {
+    assert(list.size() == expected.size());
+    assert(list.empty() == expected.empty());
+    std::size_t i = 0;
+    for (int value : expected) {
+        assert(list.at(i++) == value);
+    }
+}
+
+//! operacoes aleatorias comparadas com std::list, com compact() no meio
+static void test_against_std_list() {
+    std::mt19937 random(38);
+    List list;
+    std::list<int> expected;
+    for (int step = 0; step < 20000; step++) {
+        int value = static_cast<int>(random() % 50);
+        std::size_t size = expected.size();
+        switch (random() % 12) {
+        case 0:
+        case 1:
+            list.push_back(value);
+            expected.push_back(value);
+            break;
+        case 2:
+            list.push_front(value);
+            expected.push_front(value);
+            break;
+        case 3: {
+            std::size_t index = random() % (size + 1);
+            list.insert(value, index);
+            expected.insert(std::next(expected.begin(), index), value);
+            break;
+        }
+        case 4:
+            list.insert_sorted(value);
+            expected.insert(std::find_if(expected.begin(), expected.end(),
+                [value](int other) { return !(value > other); }), value);
+            break;
+        case 5:
+            if (size > 0) {
+                std::size_t index = random() % size;
+                auto it = std::next(expected.begin(), index);
+                assert(list.pop(index) == *it);
+                expected.erase(it);
+            }
+            break;
+        case 6:
+            if (size > 0) {
+                assert(list.pop_back() == expected.back());
+                expected.pop_back();
+            }
+            break;
+        case 7:
+            if (size > 0) {
+                assert(list.pop_front() == expected.front());
+                expected.pop_front();
+            }
+            break;
+        case 8:
+            if (size > 0) {
+                list.remove(value);
+                auto it = std::find(expected.begin(), expected.end(),
+                                    value);
+                if (it != expected.end()) {
+                    expected.erase(it);
+                }
+            }
+            break;
+        case 9: {
+            auto it = std::find(expected.begin(), expected.end(), value);
+            std::size_t index = std::distance(expected.begin(), it);
+            assert(list.find(value) == index);
+            assert(list.contains(value) == (it != expected.end()));
+            break;
+        }
+        case 10:
+            if (size > 0) {
+                std::size_t index = random() % size;
+                list.at(index) = value;
+                *std::next(expected.begin(), index) = value;
+            }
+            break;
+        case 11:
+            if (random() % 8 == 0) {
+                list.compact();
+            }
+            break;
+        }
+        // lista pequena: ora cresce, ora encolhe
+        if (expected.size() > 300) {
+            while (expected.size() > 100) {
+                assert(list.pop_front() == expected.front());
+                expected.pop_front();
+            }
+        }
+        if (step % 50 == 0) {
+            check(list, expected);
+        }
+    }
+    check(list, expected);
+}
+
+//! compact() mantem a ordem, zera os livres e encolhe o vetor
+static void test_compact() {
+    List list;
+    for (int i = 0; i < 1000; i++) {
+        list.push_back(i);
+    }
+    std::size_t full = list.memory_usage();
+    for (int i = 0; i < 1000; i += 2) {
+        list.remove(i);
+    }
+    for (int i = 0; i < 100; i++) {
+        list.push_front(-i);
+    }
+    assert(list.memory_usage() == full);
+    list.compact();
+    assert(list.size() == 600);
+    // 1024 nodos antes (vetor dobrando), 600 mais o sentinela depois
+    assert(list.memory_usage() * 1024 == full * 601);
+    for (int i = 0; i < 100; i++) {
+        assert(list.at(i) == i - 99);
+    }
+    for (int i = 0; i < 500; i++) {
+        assert(list.at(100 + i) == 2 * i + 1);
+    }
+    // depois de compact, push_back continua em ordem
+    list.push_back(5000);
+    assert(list.at(600) == 5000 && list.find(5000) == 600);
+    list.compact();
+    list.clear();
+    list.compact();
+    assert(list.empty() && list.find(1) == 0);
+    list.push_front(1);
+    assert(list.at(0) == 1 && list.pop_back() == 1);
+}
+
+//! lista vazia e indices invalidos lancam
+static void test_errors() {
+    List list;
+    int thrown = 0;
+    try { list.pop_back(); } catch (const std::out_of_range&) { thrown++; }
+    try { list.pop_front(); } catch (const std::out_of_range&) { thrown++; }
+    try { list.remove(1); } catch (const std::out_of_range&) { thrown++; }
+    list.push_back(1);
+    try { list.at(1); } catch (const std::out_of_range&) { thrown++; }
+    try { list.pop(1); } catch (const std::out_of_range&) { thrown++; }
+    try { list.insert(2, 2); } catch (const std::out_of_range&) { thrown++; }
+    assert(thrown == 6);
+    assert(list.size() == 1 && list.at(0) == 1);
+}
+
+int main() {
+    test_against_std_list();
+    test_compact();
+    test_errors();
+    std::puts("compact_doubly_list_test: ok");
+    return 0;
+}
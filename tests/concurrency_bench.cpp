@@ -0,0 +1,404 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Medidas das estruturas concorrentes: make -C tests bench
+// Cada medida roda por DURATION e imprime operacoes por segundo conforme
+// o numero de threads; as de fork-join imprimem ms por execucao.
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <random>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "../concurrent_doubly_circular_list.h"
+#include "../doubly_circular_list.h"
+#include "../rcu_array_list.h"
+#include "../task_scheduler.h"
+#include "../work_stealing_deque.h"
+
+static const std::chrono::milliseconds DURATION(300);
+static const int MAX_THREADS = 8;
+static const int FIB_N = 36;
+static const int FIB_LEAF = 16;
+static const std::size_t SORT_SIZE = 20000000;
+static const std::ptrdiff_t SORT_LEAF = 4096;
+
+//! roda work(thread, stop) em threads threads e devolve operacoes/s
+template<typename F>
+static double measure(int threads, F work) {
+    std::atomic<bool> stop{false};
+    std::atomic<long> total{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&work, &stop, &total, t] {
+            total += work(t, stop);
+        });
+    }
+    std::this_thread::sleep_for(DURATION);
+    stop = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return total / std::chrono::duration<double>(DURATION).count();
+}
+
+//! leitores de RcuArrayList contra leitores de uma lista com mutex
+/*!
+ *  Nos dois casos a thread 0 atualiza a lista sem parar e as demais
+ *  somam os dados; conta so as leituras.
+ */
+static void bench_rcu_array_list() {
+    std::puts("RcuArrayList: leituras/s (1 escritor)");
+    for (int threads = 2; threads <= MAX_THREADS; threads *= 2) {
+        structures::RcuArrayList<int> rcu(64);
+        auto rcu_work = [&rcu](int t, const std::atomic<bool>& stop) {
+            long count = 0;
+            if (t == 0) {
+                while (!stop) {
+                    rcu.update([](structures::ArrayList<int>& version) {
+                        if (version.full()) {
+                            version.clear();
+                        }
+                        version.push_back(1);
+                    });
+                }
+                return count;
+            }
+            auto reader = rcu.reader();
+            long sum = 0;
+            while (!stop) {
+                auto snapshot = reader.snapshot();
+                for (std::size_t i = 0; i < snapshot->size(); i++) {
+                    sum += (*snapshot)[i];
+                }
+                count++;
+            }
+            return sum >= 0 ? count : 0;
+        };
+
+        structures::ArrayList<int> plain(64);
+        std::mutex lock;
+        auto mutex_work = [&plain, &lock](int t,
+                                          const std::atomic<bool>& stop) {
+            long count = 0;
+            long sum = 0;
+            while (!stop) {
+                std::lock_guard<std::mutex> guard(lock);
+                if (t == 0) {
+                    if (plain.full()) {
+                        plain.clear();
+                    }
+                    plain.push_back(1);
+                    continue;
+                }
+                for (std::size_t i = 0; i < plain.size(); i++) {
+                    sum += plain[i];
+                }
+                count++;
+            }
+            return sum >= 0 ? count : 0;
+        };
+        std::printf("  %d threads: rcu %12.0f  mutex %12.0f\n", threads,
+                    measure(threads, rcu_work), measure(threads, mutex_work));
+    }
+}
+
+//! lista hand-over-hand contra DoublyCircularList com um mutex
+/*!
+ *  Cada thread insere nas duas pontas e retira da frente e do fim; conta
+ *  as operacoes.
+ */
+static void bench_concurrent_list() {
+    std::puts("ConcurrentDoublyCircularList: operacoes/s");
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        structures::ConcurrentDoublyCircularList<int> concurrent;
+        auto concurrent_work = [&concurrent](int t,
+                                             const std::atomic<bool>& stop) {
+            long count = 0;
+            while (!stop) {
+                concurrent.push_back(t);
+                concurrent.push_front(t);
+                count += 2;
+                try {
+                    concurrent.pop_front();
+                    count++;
+                    concurrent.pop_back();
+                    count++;
+                } catch (const std::out_of_range&) {}
+            }
+            return count;
+        };
+
+        structures::DoublyCircularList<int> plain;
+        std::mutex lock;
+        auto mutex_work = [&plain, &lock](int t,
+                                          const std::atomic<bool>& stop) {
+            long count = 0;
+            while (!stop) {
+                std::lock_guard<std::mutex> guard(lock);
+                plain.push_back(t);
+                plain.push_front(t);
+                plain.pop_front();
+                plain.pop_back();
+                count += 4;
+            }
+            return count;
+        };
+        std::printf("  %d threads: hand-over-hand %12.0f  mutex %12.0f\n",
+                    threads, measure(threads, concurrent_work),
+                    measure(threads, mutex_work));
+    }
+}
+
+//! WorkStealingDeque contra um std::deque com mutex
+/*!
+ *  A thread 0 e' a dona: poe 8 tarefas no fundo e tira ate 8 de volta;
+ *  as demais roubam do topo. Conta as tarefas retiradas pelas duas vias.
+ */
+static void bench_work_stealing_deque() {
+    std::puts("WorkStealingDeque: tarefas retiradas/s (1 dona)");
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        structures::WorkStealingDeque<long> deque;
+        auto deque_work = [&deque](int t, const std::atomic<bool>& stop) {
+            long count = 0;
+            long data;
+            while (!stop) {
+                if (t != 0) {
+                    count += deque.steal(&data);
+                    continue;
+                }
+                for (long i = 0; i < 8; i++) {
+                    deque.push(i);
+                }
+                for (int i = 0; i < 8 && deque.pop(&data); i++) {
+                    count++;
+                }
+            }
+            return count;
+        };
+
+        std::deque<long> plain;
+        std::mutex lock;
+        auto mutex_work = [&plain, &lock](int t,
+                                          const std::atomic<bool>& stop) {
+            long count = 0;
+            while (!stop) {
+                if (t != 0) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (!plain.empty()) {
+                        plain.pop_front();
+                        count++;
+                    }
+                    continue;
+                }
+                for (long i = 0; i < 8; i++) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    plain.push_back(i);
+                }
+                for (int i = 0; i < 8; i++) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (plain.empty()) {
+                        break;
+                    }
+                    plain.pop_back();
+                    count++;
+                }
+            }
+            return count;
+        };
+        std::printf("  %d threads: chase-lev %12.0f  mutex %12.0f\n",
+                    threads, measure(threads, deque_work),
+                    measure(threads, mutex_work));
+    }
+}
+
+//! referencia: a interface de TaskScheduler sobre uma fila global com lock
+/*!
+ *  Todas as threads disputam o mesmo std::deque; a ordem e' LIFO, como
+ *  no fundo dos deques de TaskScheduler, para a recursao nao se
+ *  aprofundar demais. Workers ociosos so cedem a vez.
+ */
+class LockedPool {
+ public:
+    class Group {
+     public:
+        explicit Group(LockedPool* pool) : pool_{pool}, pending_{0} {}
+        ~Group() { wait(); }
+        template<typename F>
+        void run(F&& f) {
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            pool_->submit([this, f] {
+                f();
+                pending_.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        void wait() {
+            while (pending_.load(std::memory_order_acquire) != 0) {
+                if (!pool_->run_one()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+     private:
+        LockedPool* pool_;
+        std::atomic<std::size_t> pending_;
+    };
+
+    explicit LockedPool(std::size_t workers) : stop_{false} {
+        for (std::size_t i = 0; i < workers; i++) {
+            threads_.emplace_back([this] {
+                while (!stop_.load(std::memory_order_relaxed)) {
+                    if (!run_one()) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+    }
+    ~LockedPool() {
+        stop_ = true;
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+ private:
+    void submit(std::function<void()> task) {
+        std::lock_guard<std::mutex> guard(lock_);
+        tasks_.push_back(std::move(task));
+    }
+    bool run_one() {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            if (tasks_.empty()) {
+                return false;
+            }
+            task = std::move(tasks_.back());
+            tasks_.pop_back();
+        }
+        task();
+        return true;
+    }
+
+    std::deque<std::function<void()>> tasks_;
+    std::mutex lock_;
+    std::atomic<bool> stop_;
+    std::vector<std::thread> threads_;
+};
+
+//! fib recursivo sem tarefas
+static long fib_sequential(int n) {
+    return n < 2 ? n : fib_sequential(n - 1) + fib_sequential(n - 2);
+}
+
+//! fib recursivo com um ramo por tarefa ate a folha sequencial
+template<typename S>
+static long fib(S* scheduler, int n) {
+    if (n < FIB_LEAF) {
+        return fib_sequential(n);
+    }
+    long first = 0;
+    typename S::Group group(scheduler);
+    group.run([scheduler, n, &first] { first = fib(scheduler, n - 1); });
+    long second = fib(scheduler, n - 2);
+    group.wait();
+    return first + second;
+}
+
+//! quicksort com a metade esquerda numa tarefa; folhas com std::sort
+template<typename S>
+static void quicksort(S* scheduler, int* first, int* last) {
+    if (last - first < SORT_LEAF) {
+        std::sort(first, last);
+        return;
+    }
+    int a = *first;
+    int b = first[(last - first) / 2];
+    int c = *(last - 1);
+    int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+    int* low = std::partition(first, last,
+                              [pivot](int x) { return x < pivot; });
+    int* high = std::partition(low, last,
+                               [pivot](int x) { return !(pivot < x); });
+    typename S::Group group(scheduler);
+    group.run([scheduler, first, low] { quicksort(scheduler, first, low); });
+    quicksort(scheduler, high, last);
+    group.wait();
+}
+
+//! ms de uma execucao de fib e do quicksort no escalonador dado
+template<typename S>
+static std::pair<double, double> fork_join(S* scheduler,
+                                           const std::vector<int>& input) {
+    auto start = std::chrono::steady_clock::now();
+    long result = fib(scheduler, FIB_N);
+    std::chrono::duration<double, std::milli> fib_ms =
+        std::chrono::steady_clock::now() - start;
+    std::vector<int> data(input);
+    start = std::chrono::steady_clock::now();
+    quicksort(scheduler, data.data(), data.data() + data.size());
+    std::chrono::duration<double, std::milli> sort_ms =
+        std::chrono::steady_clock::now() - start;
+    if (result < 0 || !std::is_sorted(data.begin(), data.end())) {
+        throw std::logic_error("fork-join errado");
+    }
+    return {fib_ms.count(), sort_ms.count()};
+}
+
+//! TaskScheduler contra LockedPool em fib e quicksort fork-join
+/*!
+ *  Mede a escala do roubo de trabalho; com 1 worker o custo e' o da
+ *  criacao das tarefas sobre a recursao sequencial. A referencia
+ *  sequencial e' fib sem tarefas e std::sort.
+ */
+static void bench_task_scheduler() {
+    std::mt19937 random(46);
+    std::vector<int> input(SORT_SIZE);
+    for (int& data : input) {
+        data = static_cast<int>(random());
+    }
+    std::vector<int> sorted(input);
+    auto start = std::chrono::steady_clock::now();
+    std::sort(sorted.begin(), sorted.end());
+    std::chrono::duration<double, std::milli> sort_ms =
+        std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    long result = fib_sequential(FIB_N);
+    std::chrono::duration<double, std::milli> fib_ms =
+        std::chrono::steady_clock::now() - start;
+    std::printf("TaskScheduler: fib(%d) e quicksort de %zu ints em ms\n",
+                FIB_N, SORT_SIZE);
+    std::puts("             roubo fib  lock fib  roubo sort  lock sort");
+    std::printf("  sequencial %10.1f %9s %11.1f %10s (fib = %ld)\n",
+                fib_ms.count(), "-", sort_ms.count(), "-", result);
+    for (int workers = 1; workers <= MAX_THREADS; workers *= 2) {
+        std::pair<double, double> stealing;
+        std::pair<double, double> locked;
+        {
+            structures::TaskScheduler scheduler(workers);
+            stealing = fork_join(&scheduler, input);
+        }
+        {
+            LockedPool pool(workers);
+            locked = fork_join(&pool, input);
+        }
+        std::printf("  %d workers %11.1f %9.1f %11.1f %10.1f\n", workers,
+                    stealing.first, locked.first, stealing.second,
+                    locked.second);
+    }
+}
+
+int main() {
+    bench_rcu_array_list();
+    bench_concurrent_list();
+    bench_work_stealing_deque();
+    bench_task_scheduler();
+    return 0;
+}
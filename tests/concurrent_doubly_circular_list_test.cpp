@@ -0,0 +1,100 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Compilado com -fsanitize=thread (veja o Makefile).
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "../concurrent_doubly_circular_list.h"
+
+using List = structures::ConcurrentDoublyCircularList<int>;
+
+static const int THREADS = 8;
+static const int OPERATIONS = 4000;
+
+//! nos dois sentidos a lista tem size() dados
+static void assert_consistent(const List& list) {
+    std::size_t forward = 0;
+    std::size_t backward = 0;
+    list.for_each([&forward](int) { forward++; });
+    list.for_each_reverse([&backward](int) { backward++; });
+    assert(forward == list.size() && backward == forward);
+}
+
+//! operacoes sem concorrencia mantem a ordem
+static void test_sequential() {
+    List list;
+    list.push_back(2);
+    list.push_front(1);
+    list.insert(5, 2);
+    list.insert_sorted(3);
+    std::vector<int> seen;
+    list.for_each([&seen](int data) { seen.push_back(data); });
+    assert((seen == std::vector<int>{1, 2, 3, 5}));
+    seen.clear();
+    list.for_each_reverse([&seen](int data) { seen.push_back(data); });
+    assert((seen == std::vector<int>{5, 3, 2, 1}));
+    assert(list.pop_back() == 5 && list.pop_front() == 1);
+    assert(list.remove(3) && !list.remove(9) && list.size() == 1);
+}
+
+//! 8 threads misturando insercoes, remocoes e travessias nos dois sentidos
+static void test_stress() {
+    List list;
+    std::atomic<long> pushed{0};
+    std::atomic<long> popped{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&list, &pushed, &popped, t] {
+            for (int i = 0; i < OPERATIONS; i++) {
+                switch ((i + t) % 8) {
+                case 0: list.push_back(i); pushed++; break;
+                case 1: list.push_front(i); pushed++; break;
+                case 2: list.insert_sorted(i); pushed++; break;
+                case 3:
+                    try {
+                        list.pop_back();
+                        popped++;
+                    } catch (const std::out_of_range&) {}
+                    break;
+                case 4:
+                    try {
+                        list.pop_front();
+                        popped++;
+                    } catch (const std::out_of_range&) {}
+                    break;
+                case 5:
+                    if (list.remove(i - 5)) {
+                        popped++;
+                    }
+                    break;
+                case 6: {
+                    std::size_t count = 0;
+                    list.for_each_reverse([&count](int) { count++; });
+                    break;
+                }
+                default:
+                    list.contains(i);
+                    list.for_each([](int) {});
+                    break;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert_consistent(list);
+    assert(pushed - popped == static_cast<long>(list.size()));
+    list.clear();
+    assert(list.empty());
+}
+
+int main() {
+    test_sequential();
+    test_stress();
+    std::puts("concurrent_doubly_circular_list_test: ok");
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Lacos quentes sob cada politica de erro (veja error_policy.h): soma por
+// ArrayList::at, ondas de push/pop numa ArrayStack e pares enqueue/dequeue
+// numa ArrayQueue, todos com ints. A ultima linha usa os try_* (que so
+// devolvem Status) da politica padrao. Compilado com -O2 -DNDEBUG, como
+// o resto de make bench, entao UncheckedPolicy nao testa nada. Mostra ns
+// por operacao.
+#include <cstdio>
+#include <type_traits>
+
+#include "../array_list.h"
+#include "../array_queue.h"
+#include "../array_stack.h"
+#include "./bench.h"
+
+static const std::size_t SIZE = 1u << 20;
+static const int ROUNDS = 100;
+static const double OPERATIONS = static_cast<double>(SIZE) * ROUNDS;
+
+using structures::ExpectedPolicy;
+using structures::ThrowPolicy;
+using structures::UncheckedPolicy;
+
+//! valor devolvido por uma operacao, conforme a politica
+template<typename P, typename R>
+static decltype(auto) unwrap(R&& result) {
+    if constexpr (std::is_same<P, ExpectedPolicy>::value) {
+        return *result;
+    } else {
+        return std::forward<R>(result);
+    }
+}
+
+//! ns por at numa soma sobre a lista inteira
+template<typename P>
+static double sum_at() {
+    structures::ArrayList<int, P> list(SIZE);
+    for (std::size_t i = 0; i < SIZE; i++) {
+        list.push_back(static_cast<int>(i));
+    }
+    long sum = 0;
+    bench::Stopwatch watch;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            sum += unwrap<P>(list.at(i));
+        }
+    }
+    double ns = watch.ms() * 1e6 / OPERATIONS;
+    bench::keep(sum);
+    return ns;
+}
+
+//! ns por push+pop em ondas que enchem e esvaziam a pilha
+template<typename P>
+static double stack_waves() {
+    structures::ArrayStack<int, P> stack(SIZE);
+    long sum = 0;
+    bench::Stopwatch watch;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            stack.push(static_cast<int>(i));
+        }
+        for (std::size_t i = 0; i < SIZE; i++) {
+            sum += unwrap<P>(stack.pop());
+        }
+    }
+    double ns = watch.ms() * 1e6 / OPERATIONS;
+    bench::keep(sum);
+    return ns;
+}
+
+//! ns por enqueue+dequeue com a fila pela metade
+template<typename P>
+static double queue_pairs() {
+    structures::ArrayQueue<int, P> queue(SIZE);
+    for (std::size_t i = 0; i < SIZE / 2; i++) {
+        queue.enqueue(static_cast<int>(i));
+    }
+    long sum = 0;
+    bench::Stopwatch watch;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            queue.enqueue(static_cast<int>(i));
+            sum += unwrap<P>(queue.dequeue());
+        }
+    }
+    double ns = watch.ms() * 1e6 / OPERATIONS;
+    bench::keep(sum);
+    return ns;
+}
+
+//! as mesmas ondas e pares com try_push/try_pop e try_enqueue/try_dequeue
+static void try_operations(double* stack_ns, double* queue_ns) {
+    structures::ArrayStack<int> stack(SIZE);
+    long sum = 0;
+    int data;
+    bench::Stopwatch watch;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            stack.try_push(static_cast<int>(i));
+        }
+        while (stack.try_pop(&data) == structures::Status::OK) {
+            sum += data;
+        }
+    }
+    *stack_ns = watch.ms() * 1e6 / OPERATIONS;
+    structures::ArrayQueue<int> queue(SIZE);
+    for (std::size_t i = 0; i < SIZE / 2; i++) {
+        queue.try_enqueue(static_cast<int>(i));
+    }
+    watch.restart();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (std::size_t i = 0; i < SIZE; i++) {
+            queue.try_enqueue(static_cast<int>(i));
+            queue.try_dequeue(&data);
+            sum += data;
+        }
+    }
+    *queue_ns = watch.ms() * 1e6 / OPERATIONS;
+    bench::keep(sum);
+}
+
+template<typename P>
+static void row(const char* name) {
+    std::printf("  %-16s %8.2f %8.2f %8.2f\n", name, sum_at<P>(),
+                stack_waves<P>(), queue_pairs<P>());
+}
+
+int main() {
+    std::printf("%zu ints x %d rodadas, ns por operacao\n", SIZE, ROUNDS);
+    std::puts("                         at    pilha     fila");
+    row<ThrowPolicy>("ThrowPolicy");
+    row<ExpectedPolicy>("ExpectedPolicy");
+    row<UncheckedPolicy>("UncheckedPolicy");
+    double stack_ns;
+    double queue_ns;
+    try_operations(&stack_ns, &queue_ns);
+    std::printf("  %-16s %8s %8.2f %8.2f\n", "try_*", "-", stack_ns,
+                queue_ns);
+    return 0;
+}
@@ -0,0 +1,105 @@
+// Copyright [2019] <Bryan Martins Lima>
+// COUNT caminhos de arquivo ordenados numa ArrayListString e congelados
+// em FrontCodedStringList com varios tamanhos de bloco. Mostra a razao de
+// memoria (heap da lista, por mallinfo2, sobre memory_usage) e ns por
+// find e por at aleatorios. A referencia de busca e' uma busca binaria
+// com strcmp sobre a propria ArrayListString.
+#include <malloc.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../front_coded_string_list.h"
+#include "./bench.h"
+
+static const std::size_t COUNT = 1000000;
+static const std::size_t LOOKUPS = 1000000;
+static const std::size_t BLOCKS[] = {4, 8, 16, 32, 64};
+
+static std::size_t heap_bytes() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+//! caminhos com diretorios compartilhados, como numa arvore de fontes
+static std::vector<std::string> paths() {
+    static const char* const roots[] = {"/usr/share/doc/", "/usr/lib/",
+                                        "/home/user/projects/",
+                                        "/usr/include/"};
+    static const char* const parts[] = {"src/", "include/", "test/",
+                                        "build/", "docs/"};
+    std::mt19937 random(43);
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < COUNT; i++) {
+        std::string key = roots[random() % 4];
+        key += "package-" + std::to_string(random() % 2000) + "/";
+        key += parts[random() % 5];
+        key += "module_" + std::to_string(random() % 100) + "/file_";
+        key += std::to_string(i) + ".cpp";
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+int main() {
+    std::vector<std::string> keys = paths();
+    std::mt19937 random(44);
+    std::vector<std::size_t> picks(LOOKUPS);
+    for (std::size_t& pick : picks) {
+        pick = random() % COUNT;
+    }
+    std::size_t before = heap_bytes();
+    structures::ArrayListString list(COUNT);
+    for (const std::string& key : keys) {
+        list.push_back(key.c_str());
+    }
+    std::size_t list_bytes = heap_bytes() - before;
+    bench::Stopwatch watch;
+    std::size_t sum = 0;
+    for (std::size_t pick : picks) {
+        const char* key = keys[pick].c_str();
+        std::size_t low = 0;
+        std::size_t high = list.size();
+        while (low < high) {
+            std::size_t middle = low + (high - low) / 2;
+            if (std::strcmp(list[middle], key) < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        sum += low;
+    }
+    double list_find = watch.ms() * 1e6 / LOOKUPS;
+    bench::keep(sum);
+    std::printf("%zu caminhos: razao de memoria, ns por find e por at\n",
+                COUNT);
+    std::puts("                      memoria     find       at");
+    std::printf("  %-16s %6.1f MiB %8.0f %8s\n", "ArrayListString",
+                list_bytes / 1048576.0, list_find, "-");
+    for (std::size_t block : BLOCKS) {
+        structures::FrontCodedStringList frozen(list, block);
+        watch.restart();
+        for (std::size_t pick : picks) {
+            sum += frozen.find(keys[pick]);
+        }
+        double find = watch.ms() * 1e6 / LOOKUPS;
+        watch.restart();
+        for (std::size_t pick : picks) {
+            sum += frozen.at(pick).size();
+        }
+        double at = watch.ms() * 1e6 / LOOKUPS;
+        bench::keep(sum);
+        char name[16];
+        std::snprintf(name, sizeof(name), "bloco %zu", block);
+        std::printf("  %-16s %9.1fx %8.0f %8.0f\n", name,
+                    static_cast<double>(list_bytes) / frozen.memory_usage(),
+                    find, at);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../front_coded_string_list.h"
+
+using Frozen = structures::FrontCodedStringList;
+
+//! congela as strings ja ordenadas
+static Frozen freeze(const std::vector<std::string>& sorted,
+                     std::size_t block_size) {
+    structures::ArrayListString list(sorted.size() + 1);
+    for (const std::string& data : sorted) {
+        list.push_back(data.c_str());
+    }
+    return Frozen(list, block_size);
+}
+
+//! at, for_each e find iguais a busca no vetor de referencia
+static void check(const Frozen& frozen,
+                  const std::vector<std::string>& sorted,
+                  const std::vector<std::string>& probes) {
+    assert(frozen.size() == sorted.size());
+    std::vector<std::string> all;
+    frozen.for_each([&all](std::string_view data) { all.emplace_back(data); });
+    assert(all == sorted);
+    for (std::size_t i = 0; i < sorted.size(); i++) {
+        assert(frozen.at(i) == sorted[i]);
+    }
+    for (const std::string& probe : probes) {
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), probe);
+        std::size_t expected = it != sorted.end() && *it == probe ?
+            static_cast<std::size_t>(it - sorted.begin()) : sorted.size();
+        assert(frozen.find(probe) == expected);
+        assert(frozen.contains(probe) == (expected != sorted.size()));
+    }
+}
+
+//! repetidos que atravessam a cabeca de um bloco: find da a primeira
+static void test_duplicates_across_heads() {
+    std::vector<std::string> probes{"", "a", "b", "x", "xx", "y", "z", "zz"};
+    // primeira ocorrencia no meio do bloco, seguindo no proximo
+    check(freeze({"a", "b", "x", "x", "x", "x", "y", "z"}, 4),
+          {"a", "b", "x", "x", "x", "x", "y", "z"}, probes);
+    // primeira ocorrencia e' a propria cabeca
+    check(freeze({"a", "b", "c", "d", "x", "x", "y"}, 4),
+          {"a", "b", "c", "d", "x", "x", "y"}, probes);
+    // varios blocos inteiros de repetidos
+    std::vector<std::string> run{"a"};
+    run.insert(run.end(), 11, "x");
+    run.push_back("y");
+    for (std::size_t block : {1u, 2u, 3u, 4u, 16u}) {
+        check(freeze(run, block), run, probes);
+        assert(freeze(run, block).find("x") == 1);
+    }
+}
+
+//! caminhos aleatorios com repetidos, em varios tamanhos de bloco
+static void test_against_sorted_vector() {
+    std::mt19937 random(43);
+    static const char* const dirs[] = {"/usr/lib/", "/usr/include/",
+                                       "/usr/", "/home/u/src/"};
+    std::vector<std::string> sorted;
+    for (int i = 0; i < 3000; i++) {
+        sorted.push_back(std::string(dirs[random() % 4]) + "m" +
+                         std::to_string(random() % 40) + "/f" +
+                         std::to_string(random() % 50));
+    }
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<std::string> probes(sorted.begin(), sorted.begin() + 200);
+    for (int i = 0; i < 300; i++) {
+        std::string probe = sorted[random() % sorted.size()];
+        // ausentes: antes, entre e depois das presentes
+        probes.push_back(probe + "0");
+        probes.push_back(probe.substr(0, probe.size() - 1));
+        probes.push_back(sorted[random() % sorted.size()]);
+    }
+    probes.push_back("");
+    probes.push_back("/");
+    probes.push_back("~");
+    for (std::size_t block : {1u, 2u, 7u, 16u, 64u, 5000u}) {
+        check(freeze(sorted, block), sorted, probes);
+    }
+    // front coding tem que caber em bem menos que as strings inteiras
+    std::size_t raw = 0;
+    for (const std::string& data : sorted) {
+        raw += data.size() + 1;
+    }
+    assert(freeze(sorted, 16).memory_usage() * 2 < raw);
+}
+
+//! bloco vazio, lista fora de ordem e index invalido
+static void test_errors() {
+    int thrown = 0;
+    try { freeze({"a"}, 0); }
+    catch (const std::invalid_argument&) { thrown++; }
+    try { freeze({"b", "a"}, 4); }
+    catch (const std::invalid_argument&) { thrown++; }
+    Frozen empty = freeze({}, 4);
+    assert(empty.empty() && empty.find("a") == 0 && !empty.contains(""));
+    try { empty.at(0); } catch (const std::out_of_range&) { thrown++; }
+    assert(thrown == 3);
+}
+
+int main() {
+    test_duplicates_across_heads();
+    test_against_sorted_vector();
+    test_errors();
+    std::puts("front_coded_string_list_test: ok");
+    return 0;
+}
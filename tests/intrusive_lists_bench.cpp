@@ -0,0 +1,154 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Rotatividade em listas de objetos que ja vivem num pool: cada passo
+// retira um objeto e coloca outro. Listas intrusivas contra as versoes
+// que alocam um Node por insercao, guardando ponteiros para os objetos.
+// No rodizio sai o primeiro e entra um no fim; na retirada aleatoria sai
+// um objeto qualquer por referencia (handle na DoublyCircularList).
+// LinkedList e DoublyLinkedList com Node sao so declaracoes, entao a
+// referencia e' a lista com Node mais proxima que existe. CircularList
+// percorre a lista no push_back, entao as listas simples usam push_front.
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../circular_list.h"
+#include "../doubly_circular_list.h"
+#include "../intrusive_doubly_circular_list.h"
+#include "../intrusive_doubly_linked_list.h"
+#include "../intrusive_linked_list.h"
+#include "../intrusive_linked_queue.h"
+#include "../linked_queue.h"
+#include "./bench.h"
+
+static const std::size_t POOL = 1u << 20;
+static const std::size_t LIVE = POOL / 2;
+static const std::size_t STEPS = 20000000;
+
+struct Item {
+    long value;
+    structures::SListHook slist;
+    structures::SListHook queue;
+    structures::ListHook list;
+    structures::ListHook ring;
+};
+
+//! LIVE objetos na lista, depois STEPS passos de pop + push
+template<typename List, typename Push, typename Pop>
+static double rotate(std::vector<Item>* pool, Push push, Pop pop) {
+    List list;
+    for (std::size_t i = 0; i < LIVE; i++) {
+        push(&list, &(*pool)[i]);
+    }
+    std::size_t next = LIVE;
+    long sum = 0;
+    bench::Stopwatch watch;
+    for (std::size_t i = 0; i < STEPS; i++) {
+        sum += pop(&list)->value;
+        push(&list, &(*pool)[next]);
+        next = next + 1 == POOL ? 0 : next + 1;
+    }
+    bench::keep(sum);
+    return watch.ms();
+}
+
+//! cada passo retira um objeto vivo sorteado e poe um livre no fim
+template<typename List, typename Handle, typename Push, typename Erase>
+static double churn(std::vector<Item>* pool, Push push, Erase erase) {
+    List list;
+    std::vector<Handle> handles(POOL);
+    std::vector<std::size_t> live(LIVE), free;
+    for (std::size_t i = 0; i < POOL; i++) {
+        if (i < LIVE) {
+            live[i] = i;
+            handles[i] = push(&list, &(*pool)[i]);
+        } else {
+            free.push_back(i);
+        }
+    }
+    std::mt19937 random(37);
+    bench::Stopwatch watch;
+    for (std::size_t i = 0; i < STEPS; i++) {
+        std::size_t& slot = live[random() % LIVE];
+        erase(&list, handles[slot]);
+        std::size_t in = free.back();
+        free.back() = slot;
+        slot = in;
+        handles[in] = push(&list, &(*pool)[in]);
+    }
+    return watch.ms();
+}
+
+int main() {
+    std::vector<Item> pool(POOL);
+    for (std::size_t i = 0; i < POOL; i++) {
+        pool[i].value = static_cast<long>(i);
+    }
+    std::printf("%zu objetos vivos de %zu, %zu passos: ms\n", LIVE, POOL,
+                STEPS);
+    std::puts("  rodizio");
+
+    using ISList = structures::IntrusiveLinkedList<Item, &Item::slist>;
+    using Circular = structures::CircularList<Item*>;
+    std::printf("  IntrusiveLinkedList         %8.1f  CircularList       "
+                "%8.1f\n",
+        rotate<ISList>(&pool,
+            [](ISList* list, Item* item) { list->push_front(*item); },
+            [](ISList* list) { return &list->pop_front(); }),
+        rotate<Circular>(&pool,
+            [](Circular* list, Item* item) { list->push_front(item); },
+            [](Circular* list) { return list->pop_front(); }));
+
+    using IQueue = structures::IntrusiveLinkedQueue<Item, &Item::queue>;
+    using Queue = structures::LinkedQueue<Item*>;
+    std::printf("  IntrusiveLinkedQueue        %8.1f  LinkedQueue        "
+                "%8.1f\n",
+        rotate<IQueue>(&pool,
+            [](IQueue* queue, Item* item) { queue->enqueue(*item); },
+            [](IQueue* queue) { return &queue->dequeue(); }),
+        rotate<Queue>(&pool,
+            [](Queue* queue, Item* item) { queue->enqueue(item); },
+            [](Queue* queue) { return queue->dequeue(); }));
+
+    using IList = structures::IntrusiveDoublyLinkedList<Item, &Item::list>;
+    using IRing = structures::IntrusiveDoublyCircularList<Item, &Item::ring>;
+    using Ring = structures::DoublyCircularList<Item*>;
+    double ring = rotate<Ring>(&pool,
+        [](Ring* ring, Item* item) { ring->push_back(item); },
+        [](Ring* ring) { return ring->pop_front(); });
+    std::printf("  IntrusiveDoublyLinkedList   %8.1f  DoublyCircularList "
+                "%8.1f\n",
+        rotate<IList>(&pool,
+            [](IList* list, Item* item) { list->push_back(*item); },
+            [](IList* list) { return &list->pop_front(); }),
+        ring);
+    std::printf("  IntrusiveDoublyCircularList %8.1f  DoublyCircularList "
+                "%8.1f\n",
+        rotate<IRing>(&pool,
+            [](IRing* ring, Item* item) { ring->push_back(*item); },
+            [](IRing* ring) { return &ring->pop_front(); }),
+        ring);
+
+    std::puts("  retirada aleatoria");
+    ring = churn<Ring, Ring::Handle>(&pool,
+        [](Ring* ring, Item* item) { return ring->push_back(item); },
+        [](Ring* ring, Ring::Handle node) { ring->erase(node); });
+    std::printf("  IntrusiveDoublyLinkedList   %8.1f  DoublyCircularList "
+                "%8.1f\n",
+        churn<IList, Item*>(&pool,
+            [](IList* list, Item* item) {
+                list->push_back(*item);
+                return item;
+            },
+            [](IList* list, Item* item) { list->erase(*item); }),
+        ring);
+    std::printf("  IntrusiveDoublyCircularList %8.1f  DoublyCircularList "
+                "%8.1f\n",
+        churn<IRing, Item*>(&pool,
+            [](IRing* ring, Item* item) {
+                ring->push_back(*item);
+                return item;
+            },
+            [](IRing* ring, Item* item) { ring->erase(*item); }),
+        ring);
+    return 0;
+}
@@ -0,0 +1,179 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "../intrusive_doubly_circular_list.h"
+#include "../intrusive_doubly_linked_list.h"
+#include "../intrusive_linked_list.h"
+#include "../intrusive_linked_queue.h"
+
+//! alocacoes feitas por new desde o inicio do programa
+static long allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+//! objeto com um gancho para cada tipo de lista
+struct Item {
+    int value;
+    structures::SListHook slist;
+    structures::SListHook queue;
+    structures::ListHook list;
+    structures::ListHook ring;
+};
+
+using SList = structures::IntrusiveLinkedList<Item, &Item::slist>;
+using Queue = structures::IntrusiveLinkedQueue<Item, &Item::queue>;
+using List = structures::IntrusiveDoublyLinkedList<Item, &Item::list>;
+using Ring = structures::IntrusiveDoublyCircularList<Item, &Item::ring>;
+
+//! valores do inicio ao fim
+template<typename L>
+static std::vector<int> values(const L& list) {
+    std::vector<int> out;
+    list.for_each([&out](const Item& item) { out.push_back(item.value); });
+    return out;
+}
+
+//! o mesmo objeto nas quatro listas; sair de uma nao mexe nas outras
+static void test_multiple_membership() {
+    std::vector<Item> items(5);
+    for (int i = 0; i < 5; i++) {
+        items[i].value = i;
+    }
+    SList slist;
+    Queue queue;
+    List list;
+    Ring ring;
+    for (Item& item : items) {
+        slist.push_back(item);
+        queue.enqueue(item);
+        list.push_front(item);
+        ring.push_back(item);
+    }
+    list.erase(items[2]);
+    assert(slist.remove(items[2]) && !slist.remove(items[2]));
+    assert((values(list) == std::vector<int>{4, 3, 1, 0}));
+    assert((values(slist) == std::vector<int>{0, 1, 3, 4}));
+    assert((values(ring) == std::vector<int>{0, 1, 2, 3, 4}));
+    assert(ring.contains(items[2]) && !list.contains(items[2]));
+    assert(queue.size() == 5 && queue.dequeue().value == 0);
+    ring.move_to_front(items[4]);
+    assert(ring.front().value == 4 && list.front().value == 4);
+    assert(slist.back().value == 4 && queue.back().value == 4);
+}
+
+//! erase por referencia na cabeca, no meio e na cauda
+static void test_unlink() {
+    std::vector<Item> items(6);
+    List list;
+    Ring ring;
+    for (int i = 0; i < 6; i++) {
+        items[i].value = i;
+        list.push_back(items[i]);
+        ring.push_back(items[i]);
+    }
+    for (int i : {0, 3, 5}) {
+        list.erase(items[i]);
+        ring.erase(items[i]);
+        assert(!Ring::linked(items[i]));
+    }
+    assert((values(list) == std::vector<int>{1, 2, 4}));
+    assert((values(ring) == std::vector<int>{1, 2, 4}));
+    assert(list.front().value == 1 && list.back().value == 4);
+    assert(ring.front().value == 1 && ring.back().value == 4);
+    std::vector<int> reverse;
+    list.for_each_reverse([&reverse](const Item& item) {
+        reverse.push_back(item.value);
+    });
+    assert((reverse == std::vector<int>{4, 2, 1}));
+    // reinsere um objeto retirado
+    list.insert_before(items[4], items[3]);
+    ring.insert_before(items[1], items[0]);
+    assert((values(list) == std::vector<int>{1, 2, 3, 4}));
+    assert((values(ring) == std::vector<int>{0, 1, 2, 4}));
+    bool thrown = false;
+    try { ring.erase(items[5]); } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(list.pop_back().value == 4 && ring.pop_front().value == 0);
+    assert(list.size() == 3 && ring.size() == 3);
+}
+
+//! a lista desliga os objetos ao ser limpa ou destruida
+static void test_clear_unlinks() {
+    Item item{7, {}, {}, {}, {}};
+    {
+        Ring ring;
+        SList slist;
+        ring.push_back(item);
+        slist.push_back(item);
+        assert(Ring::linked(item) && item.slist.next() == nullptr);
+    }
+    assert(!Ring::linked(item));
+    Queue queue;
+    queue.enqueue(item);
+    queue.clear();
+    assert(queue.empty());
+    bool thrown = false;
+    try { queue.dequeue(); } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+//! nenhuma operacao aloca
+static void test_no_allocation() {
+    std::vector<Item> items(1000);
+    SList slist;
+    Queue queue;
+    List list;
+    Ring ring;
+    long before = allocations;
+    for (int round = 0; round < 10; round++) {
+        for (Item& item : items) {
+            slist.push_front(item);
+            queue.enqueue(item);
+            list.push_back(item);
+            ring.push_front(item);
+        }
+        for (std::size_t i = 0; i < items.size(); i += 2) {
+            list.erase(items[i]);
+            ring.erase(items[i]);
+        }
+        while (!queue.empty()) {
+            queue.dequeue();
+            slist.pop_front();
+        }
+        list.clear();
+        ring.clear();
+    }
+    assert(allocations == before);
+}
+
+int main() {
+    test_multiple_membership();
+    test_unlink();
+    test_clear_unlinks();
+    test_no_allocation();
+    std::puts("intrusive_lists_test: ok");
+    return 0;
+}
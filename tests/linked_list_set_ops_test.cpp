@@ -0,0 +1,145 @@
+// Copyright [2019] <Bryan Martins Lima>
+// merge e operacoes de conjunto das listas encadeadas contra <algorithm>,
+// contando as instancias vivas para pegar nodo perdido ou liberado demais.
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "../circular_list.h"
+#include "../doubly_circular_list.h"
+
+static const int ROUNDS = 2000;
+
+//! inteiro que conta quantas instancias existem
+struct Counted {
+    static long live;
+    int value;
+
+    Counted(int value = 0) : value(value) { live++; }  // NOLINT
+    Counted(const Counted& other) : value(other.value) { live++; }
+    Counted& operator=(const Counted& other) = default;
+    ~Counted() { live--; }
+
+    bool operator<(const Counted& other) const { return value < other.value; }
+    bool operator==(const Counted& other) const {
+        return value == other.value;
+    }
+};
+
+long Counted::live = 0;
+
+static std::vector<int> random_sorted(std::mt19937* random, std::size_t size,
+                                      int range) {
+    std::vector<int> values;
+    for (std::size_t i = 0; i < size; i++) {
+        values.push_back(static_cast<int>((*random)() % range));
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+template<typename List>
+static void fill(List* list, const std::vector<int>& values) {
+    for (int value : values) {
+        list->push_back(value);
+    }
+}
+
+//! esvazia a lista pelo fim; confere a ordem e, na dupla, os prev
+template<typename List>
+static bool drain_equal(List* list, const std::vector<int>& expected) {
+    bool equal = list->size() == expected.size();
+    for (std::size_t i = expected.size(); equal && i > 0; i--) {
+        equal = list->pop_back().value == expected[i - 1];
+    }
+    return equal && list->empty();
+}
+
+//! uma operacao de a com b; depois dela cada dado vivo esta numa lista
+template<typename List, typename Op>
+static void check(const std::vector<int>& a, const std::vector<int>& b,
+                  Op op, const std::vector<int>& expected) {
+    List list;
+    List other;
+    long before = Counted::live;
+    fill(&list, a);
+    fill(&other, b);
+    op(&list, &other);
+    assert(Counted::live - before ==
+           static_cast<long>(list.size() + other.size()));
+    assert(drain_equal(&list, expected));
+}
+
+template<typename List>
+static void check_set_ops(const std::vector<int>& a,
+                          const std::vector<int>& b) {
+    std::vector<int> expected;
+    std::merge(a.begin(), a.end(), b.begin(), b.end(),
+               std::back_inserter(expected));
+    check<List>(a, b, [](List* list, List* other) {
+        list->merge(*other);
+        assert(other->empty());
+    }, expected);
+
+    expected.clear();
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                   std::back_inserter(expected));
+    check<List>(a, b, [](List* list, List* other) {
+        list->set_union(*other);
+        assert(other->empty());
+    }, expected);
+
+    expected.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(expected));
+    check<List>(a, b, [](List* list, List* other) {
+        list->set_intersection(*other);
+    }, expected);
+
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected));
+    check<List>(a, b, [](List* list, List* other) {
+        list->set_difference(*other);
+    }, expected);
+}
+
+//! com a propria lista: merge e uniao nao mudam nada, diferenca esvazia
+template<typename List>
+static void check_self_ops(const std::vector<int>& a) {
+    check<List>(a, {}, [](List* list, List*) {
+        list->merge(*list);
+        list->set_union(*list);
+        list->set_intersection(*list);
+    }, a);
+    check<List>(a, {}, [](List* list, List*) {
+        list->set_difference(*list);
+    }, {});
+}
+
+//! tamanhos pequenos e desiguais, com e sem repetidos
+template<typename List>
+static void test_set_ops() {
+    std::mt19937 random(11);
+    for (int round = 0; round < ROUNDS; round++) {
+        std::size_t size_a = random() % 12;
+        std::size_t size_b = random() % (round % 4 == 0 ? 64 : 12);
+        int range = 1 + static_cast<int>(random() % (size_a + size_b + 2));
+        auto a = random_sorted(&random, size_a, range);
+        auto b = random_sorted(&random, size_b, range);
+        check_set_ops<List>(a, b);
+        check_set_ops<List>(b, a);
+        check_self_ops<List>(a);
+    }
+    assert(Counted::live == 0);
+}
+
+int main() {
+    test_set_ops<structures::CircularList<Counted>>();
+    test_set_ops<structures::DoublyCircularList<Counted>>();
+    std::puts("linked_list_set_ops_test: ok");
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Copyright [2019] <Bryan Martins Lima>
+// LruCache com politica LRU e 2Q sobre traces Zipfianos de KEYS chaves:
+// get e, na falta, put. Mostra a taxa de acerto e milhoes de ops/s para
+// alguns expoentes e capacidades, e num trace com varreduras sequenciais
+// intercaladas, onde 2Q deve segurar as chaves quentes.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../lru_cache.h"
+#include "./bench.h"
+
+static const int KEYS = 1000000;
+static const std::size_t LENGTH = 5000000;
+static const double EXPONENTS[] = {0.8, 1.0, 1.2};
+static const std::size_t CAPACITIES[] = {10000, 100000};
+static const std::size_t SCAN = 50000;
+
+using Cache = structures::LruCache<int, int>;
+
+//! trace Zipfiano: a chave de posto r sai com peso 1/r^exponent
+static std::vector<int> zipf(double exponent, std::mt19937* random) {
+    std::vector<double> cdf(KEYS);
+    double total = 0;
+    for (int r = 0; r < KEYS; r++) {
+        total += 1 / std::pow(r + 1, exponent);
+        cdf[r] = total;
+    }
+    // postos espalhados pelas chaves, para nao favorecer o hash
+    std::vector<int> keys(KEYS);
+    for (int i = 0; i < KEYS; i++) {
+        keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), *random);
+    std::uniform_real_distribution<double> uniform(0, total);
+    std::vector<int> trace(LENGTH);
+    for (int& key : trace) {
+        auto rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(*random));
+        key = keys[std::min<long>(rank - cdf.begin(), KEYS - 1)];
+    }
+    return trace;
+}
+
+//! roda o trace e imprime acerto (%) e milhoes de ops/s
+static void run(const std::vector<int>& trace, std::size_t capacity,
+                Cache::Policy policy) {
+    Cache cache(capacity, policy);
+    bench::Stopwatch watch;
+    for (int key : trace) {
+        if (!cache.get(key)) {
+            cache.put(key, key);
+        }
+    }
+    double ms = watch.ms();
+    std::printf(" %10.2f %6.2f", 100.0 * cache.hits() / trace.size(),
+                trace.size() / ms / 1e3);
+}
+
+static void row(const char* name, const std::vector<int>& trace,
+                std::size_t capacity) {
+    std::printf("  %-10s %10zu", name, capacity);
+    run(trace, capacity, Cache::Policy::LRU);
+    run(trace, capacity, Cache::Policy::TWO_QUEUE);
+    std::puts("");
+}
+
+int main() {
+    std::mt19937 random(36);
+    std::printf("%zu acessos a %d chaves: acerto %% e milhoes de ops/s\n",
+                LENGTH, KEYS);
+    std::puts("  trace      capacidade LRU:acerto  ops/s  2Q:acerto  ops/s");
+    for (double exponent : EXPONENTS) {
+        std::vector<int> trace = zipf(exponent, &random);
+        char name[16];
+        std::snprintf(name, sizeof(name), "zipf %.1f", exponent);
+        for (std::size_t capacity : CAPACITIES) {
+            row(name, trace, capacity);
+        }
+        if (exponent == 1.0) {
+            // a cada SCAN acessos, uma varredura de SCAN chaves frias
+            std::vector<int> scanned;
+            int cold = KEYS;
+            for (std::size_t i = 0; i < trace.size(); i++) {
+                scanned.push_back(trace[i]);
+                if (i % SCAN == SCAN - 1) {
+                    for (std::size_t j = 0; j < SCAN; j++) {
+                        scanned.push_back(cold++);
+                    }
+                }
+            }
+            for (std::size_t capacity : CAPACITIES) {
+                row("zipf+scan", scanned, capacity);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+#include "../lru_cache.h"
+
+using Cache = structures::LruCache<int, int>;
+
+//! peso = valor
+static std::size_t by_value(const int&, const int& value) {
+    return static_cast<std::size_t>(value);
+}
+
+//! LRU: despeja a menos recente, get promove
+static void test_lru() {
+    Cache cache(3);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    assert(*cache.get(1) == 10);
+    cache.put(4, 40);
+    assert(!cache.contains(2));
+    assert(cache.contains(1) && cache.contains(3) && cache.contains(4));
+    assert(cache.size() == 3 && cache.weight() == 3);
+    assert(cache.erase(1) && !cache.erase(1));
+    assert(cache.hits() == 1);
+}
+
+//! 2Q: a entrada atualizada nunca e' a vitima, mesmo sendo a mais antiga
+//! da fila de entrada com a lista principal vazia
+static void test_two_queue_keeps_updated() {
+    Cache cache(4, by_value, Cache::Policy::TWO_QUEUE);
+    assert(cache.put(1, 1));
+    assert(cache.put(2, 1));
+    assert(cache.put(1, 4));
+    assert(cache.contains(1));
+    assert(!cache.contains(2));
+    assert(cache.weight() == 4);
+}
+
+//! peso maior que a capacidade e' recusado e tira a chave antiga
+static void test_oversized() {
+    Cache cache(4, by_value, Cache::Policy::TWO_QUEUE);
+    cache.put(1, 2);
+    assert(!cache.put(1, 5));
+    assert(!cache.contains(1) && cache.empty());
+}
+
+//! 2Q: chave que volta depois de despejada vai para a lista principal
+//! e sobrevive a uma varredura
+static void test_two_queue_scan() {
+    Cache cache(8, Cache::Policy::TWO_QUEUE);
+    for (int i = 0; i < 8; i++) {
+        cache.put(i, i);
+    }
+    cache.put(100, 0);
+    cache.put(0, 0);  // fantasma: entra na principal
+    for (int i = 200; i < 300; i++) {
+        cache.put(i, i);
+        assert(cache.weight() <= 8);
+    }
+    assert(cache.contains(0));
+}
+
+int main() {
+    test_lru();
+    test_two_queue_keeps_updated();
+    test_oversized();
+    test_two_queue_scan();
+    std::puts("lru_cache_test: ok");
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Parser de registros CSV (um por linha) lendo de uma ArrayQueue<char>
+// alimentada em blocos, PASSES vezes sobre STREAM bytes. Sem espelho o
+// parser precisa juntar num buffer auxiliar o registro que passa da volta;
+// com espelho o que esta na fila e' um trecho so. Mostra MB/s e quantos
+// registros foram copiados por atravessar a volta, para algumas
+// capacidades de fila.
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "../array_queue.h"
+#include "./bench.h"
+
+static const std::size_t STREAM = std::size_t(1) << 24;
+static const std::size_t PASSES = 8;
+static const std::size_t CAPACITIES[] = {4096, 65536, 1048576};
+
+using Queue = structures::ArrayQueue<char>;
+
+//! soma dos campos numericos de um registro sem o '\n'
+static std::size_t parse(const char* data, std::size_t size) {
+    std::size_t sum = 0;
+    std::size_t field = 0;
+    for (std::size_t i = 0; i < size; i++) {
+        if (data[i] >= '0' && data[i] <= '9') {
+            field = field * 10 + (data[i] - '0');
+        } else if (data[i] == ',') {
+            sum += field;
+            field = 0;
+        }
+    }
+    return sum + field;
+}
+
+//! registros completos de um trecho contiguo; devolve os bytes usados
+static std::size_t parse_span(const char* data, std::size_t size,
+                              std::size_t& sum) {
+    std::size_t used = 0;
+    while (used < size) {
+        const void* end = std::memchr(data + used, '\n', size - used);
+        if (end == nullptr) {
+            break;
+        }
+        std::size_t length = static_cast<const char*>(end) - (data + used);
+        sum += parse(data + used, length);
+        used += length + 1;
+    }
+    return used;
+}
+
+//! consome os registros completos da fila; sem espelho junta o da volta
+static void drain(Queue& queue, std::string& scratch, std::size_t& sum,
+                  std::size_t& split) {
+    auto read = queue.readable_spans();
+    std::size_t used = parse_span(read.first.data, read.first.size, sum);
+    if (used < read.first.size && read.second.size > 0) {
+        const void* end = std::memchr(read.second.data, '\n',
+                                      read.second.size);
+        if (end == nullptr) {
+            queue.consume(used);
+            return;
+        }
+        std::size_t tail = static_cast<const char*>(end) - read.second.data;
+        scratch.assign(read.first.data + used, read.first.size - used);
+        scratch.append(read.second.data, tail);
+        sum += parse(scratch.data(), scratch.size());
+        split++;
+        used = read.first.size + tail + 1;
+        used += parse_span(read.second.data + tail + 1,
+                           read.second.size - tail - 1, sum);
+    } else if (used == read.first.size) {
+        used += parse_span(read.second.data, read.second.size, sum);
+    }
+    queue.consume(used);
+}
+
+//! linhas de ate ~300 bytes: campos numericos e um texto
+static std::string records() {
+    std::mt19937 random(45);
+    std::string stream;
+    while (stream.size() < STREAM) {
+        stream += std::to_string(random() % 100000);
+        for (std::size_t i = random() % 40; i > 0; i--) {
+            stream += "," + std::to_string(random() % 1000000);
+        }
+        stream += ",sensor-" + std::to_string(random() % 512) + "\n";
+    }
+    return stream;
+}
+
+int main() {
+    std::string stream = records();
+    std::printf("%zu MiB de registros CSV, %zu passadas, MB/s\n",
+                stream.size() >> 20, PASSES);
+    std::puts("  capacidade       comum   espelhado   copiados");
+    for (std::size_t capacity : CAPACITIES) {
+        double rates[2];
+        std::size_t copied = 0;
+        std::size_t sums[2];
+        for (bool mirrored : {false, true}) {
+            Queue queue(capacity, mirrored);
+            std::string scratch;
+            std::size_t sum = 0;
+            std::size_t split = 0;
+            bench::Stopwatch watch;
+            for (std::size_t pass = 0; pass < PASSES; pass++) {
+                std::size_t fed = 0;
+                while (fed < stream.size() || !queue.empty()) {
+                    // alimenta como um socket: o que couber no espaco livre
+                    auto write = queue.writable_spans();
+                    std::size_t n = 0;
+                    for (auto span : {write.first, write.second}) {
+                        std::size_t chunk = std::min(span.size,
+                                                     stream.size() - fed);
+                        std::memcpy(span.data, stream.data() + fed, chunk);
+                        fed += chunk;
+                        n += chunk;
+                    }
+                    queue.commit_write(n);
+                    drain(queue, scratch, sum, split);
+                }
+            }
+            rates[mirrored] = stream.size() * PASSES / watch.ms() / 1e3;
+            sums[mirrored] = sum;
+            if (!mirrored) {
+                copied = split;
+            }
+        }
+        if (sums[0] != sums[1]) {
+            std::puts("somas diferentes");
+            return 1;
+        }
+        bench::keep(sums);
+        std::printf("  %10zu %11.0f %11.0f %10zu\n", capacity, rates[0],
+                    rates[1], copied);
+    }
+    return 0;
+}
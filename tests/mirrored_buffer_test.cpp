@@ -0,0 +1,124 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "../array_queue.h"
+#include "../mirrored_buffer.h"
+
+using structures::MirroredBuffer;
+
+//! tres bytes: a pagina nao e' multipla do tamanho
+struct Packed {
+    char bytes[3];
+};
+
+//! tamanho arredondado para paginas; pedido vazio nao mapeia nada
+static void test_rounding() {
+    std::size_t page = MirroredBuffer::page_size();
+    MirroredBuffer buffer;
+    assert(!buffer.is_open() && buffer.data() == nullptr);
+    assert(buffer.allocate(1) && buffer.size() == page);
+    assert(buffer.allocate(page) && buffer.size() == page);
+    assert(buffer.allocate(page + 1) && buffer.size() == 2 * page);
+    assert(!buffer.allocate(0));
+    assert(!buffer.is_open() && buffer.size() == 0);
+}
+
+//! escrita que passa do fim reaparece no inicio e vice-versa
+static void test_wrap() {
+    MirroredBuffer buffer;
+    assert(buffer.allocate(3 * MirroredBuffer::page_size()));
+    char* data = buffer.data();
+    std::size_t size = buffer.size();
+    for (std::size_t i = 0; i < size; i++) {
+        data[i] = static_cast<char>(i % 251);
+    }
+    for (std::size_t i = 0; i < size; i++) {
+        assert(data[i + size] == data[i]);
+    }
+    // registro gravado a 5 bytes do fim, lido como um trecho so
+    const char record[] = "registro que atravessa o fim";
+    std::memcpy(data + size - 5, record, sizeof(record));
+    assert(std::memcmp(data, record + 5, sizeof(record) - 5) == 0);
+    assert(std::strcmp(data + size - 5, record) == 0);
+    // escrita pela segunda copia tambem vale na primeira
+    data[size + 7] = '#';
+    assert(data[7] == '#');
+}
+
+//! movimento transfere o mapeamento; release deixa vazio
+static void test_move_release() {
+    MirroredBuffer first;
+    assert(first.allocate(1));
+    char* data = first.data();
+    data[0] = 'm';
+    MirroredBuffer second(std::move(first));
+    assert(!first.is_open() && second.data() == data);
+    MirroredBuffer third;
+    assert(third.allocate(1));
+    third = std::move(second);
+    assert(!second.is_open() && third.data() == data);
+    assert(third.data()[third.size()] == 'm');
+    third.release();
+    assert(!third.is_open() && third.size() == 0);
+    third.release();
+}
+
+//! fila espelhada: o que esta na fila e' sempre um trecho contiguo
+static void test_queue_contiguous() {
+    std::size_t page = MirroredBuffer::page_size();
+    structures::ArrayQueue<char> queue(100, true);
+    assert(queue.mirrored() && queue.max_size() == page);
+    for (std::size_t i = 0; i < page - 10; i++) {
+        queue.enqueue('.');
+    }
+    queue.consume(page - 10);
+    const std::string record = "campo1,campo2,campo3 que passa da volta";
+    auto write = queue.writable_spans();
+    assert(write.first.size == page && write.second.size == 0);
+    std::memcpy(write.first.data, record.data(), record.size());
+    queue.commit_write(record.size());
+    auto read = queue.readable_spans();
+    assert(read.first.size == record.size() && read.second.size == 0);
+    assert(std::string(read.first.data, read.first.size) == record);
+    // a parte depois da volta esta no inicio do buffer
+    for (std::size_t i = 0; i < record.size(); i++) {
+        assert(queue.dequeue() == record[i]);
+    }
+}
+
+//! T nao trivial ou que nao divide a pagina: buffer comum, dois trechos
+static void test_fallback() {
+    structures::ArrayQueue<std::string> strings(10, true);
+    assert(!strings.mirrored() && strings.max_size() == 10);
+    for (int i = 0; i < 12; i++) {
+        strings.enqueue(std::to_string(i));
+        if (strings.size() > 6) {
+            strings.dequeue();
+        }
+    }
+    auto read = strings.readable_spans();
+    assert(read.first.size == 4 && read.second.size == 2);
+    assert(read.first.data[0] == "6" && read.second.data[1] == "11");
+    structures::ArrayQueue<Packed> packed(7, true);
+    assert(!packed.mirrored() && packed.max_size() == 7);
+    for (int i = 0; i < 5; i++) {
+        packed.enqueue(Packed{{'a', 'b', 'c'}});
+    }
+    packed.consume(5);
+    auto write = packed.writable_spans();
+    assert(write.first.size == 2 && write.second.size == 5);
+}
+
+int main() {
+    test_rounding();
+    test_wrap();
+    test_move_release();
+    test_queue_contiguous();
+    test_fallback();
+    std::puts("mirrored_buffer_test: ok");
+    return 0;
+}
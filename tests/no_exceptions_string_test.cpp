@@ -0,0 +1,42 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Como no_exceptions_test.cpp, para as listas de strings.
+#include <cstdio>
+
+#include "../front_coded_string_list.h"
+#include "../string_list.h"
+#include "../string_pool.h"
+
+#if STRUCTURES_EXCEPTIONS
+#error "compile com -fno-exceptions"
+#endif
+
+template class structures::ArrayList<int>;
+template class structures::BasicArrayListString<>;
+template class structures::BasicArrayListString<structures::ExpectedPolicy>;
+template class structures::BasicArrayListString<structures::UncheckedPolicy>;
+
+int main() {
+    structures::ArrayListString strings(4);
+    strings.insert_sorted("b");
+    strings.insert_sorted("a");
+    strings.push_back("c");
+    char *popped = strings.pop_back();
+    if (popped == nullptr) {
+        return 1;
+    }
+    delete [] popped;
+
+    structures::BasicArrayListString<structures::ExpectedPolicy> checked(1);
+    checked.push_back("x");
+    if (checked.push_back("y").error() != structures::Status::FULL ||
+        checked.at(1).error() != structures::Status::INVALID_INDEX ||
+        checked.remove("y").error() != structures::Status::NOT_FOUND) {
+        return 1;
+    }
+    structures::FrontCodedStringList coded(strings, 4);
+    if (!coded.contains("a") || coded.at(1) != "b") {
+        return 1;
+    }
+    std::puts("no_exceptions_string_test: ok");
+    return 0;
+}
@@ -0,0 +1,118 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Compilado com -fno-exceptions (veja o Makefile): instancia todos os
+// membros de cada container para garantir que nenhum usa throw/try.
+// string_list.h tem sua propria ArrayList e fica em
+// no_exceptions_string_test.cpp.
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "../array_list.h"
+#include "../array_queue.h"
+#include "../array_stack.h"
+#include "../burst_trie.h"
+#include "../circular_list.h"
+#include "../compact_doubly_list.h"
+#include "../concurrent_doubly_circular_list.h"
+#include "../doubly_circular_list.h"
+#include "../intrusive_doubly_circular_list.h"
+#include "../intrusive_doubly_linked_list.h"
+#include "../intrusive_linked_list.h"
+#include "../intrusive_linked_queue.h"
+#include "../linked_queue.h"
+#include "../lru_cache.h"
+#include "../persistent_list.h"
+#include "../persistent_stack.h"
+#include "../priority_queue.h"
+#include "../rcu_array_list.h"
+#include "../segmented_queue.h"
+#include "../segmented_stack.h"
+#include "../soa_array_list.h"
+#include "../task_scheduler.h"
+#include "../timer_wheel.h"
+#include "../work_stealing_deque.h"
+
+#if STRUCTURES_EXCEPTIONS
+#error "compile com -fno-exceptions"
+#endif
+
+struct Item {
+    structures::ListHook hook;
+    structures::SListHook slist_hook;
+    int value;
+};
+
+struct Row {
+    int a;
+    double b;
+};
+
+template<>
+struct structures::soa_fields<Row> {
+    static constexpr auto members = std::make_tuple(&Row::a, &Row::b);
+};
+
+using structures::ExpectedPolicy;
+using structures::UncheckedPolicy;
+
+template class structures::ArrayList<int>;
+template class structures::ArrayList<int, ExpectedPolicy>;
+template class structures::ArrayList<int, UncheckedPolicy>;
+template class structures::ArrayQueue<char>;
+template class structures::ArrayQueue<char, ExpectedPolicy>;
+template class structures::ArrayStack<int>;
+template class structures::ArrayStack<int, ExpectedPolicy>;
+template class structures::CircularList<int>;
+template class structures::CircularList<int, ExpectedPolicy>;
+template class structures::DoublyCircularList<int>;
+template class structures::DoublyCircularList<int, UncheckedPolicy>;
+template class structures::LinkedQueue<int>;
+template class structures::LinkedQueue<int, ExpectedPolicy>;
+template class structures::CompactDoublyList<int>;
+template class structures::ConcurrentDoublyCircularList<int>;
+template class structures::IntrusiveDoublyCircularList<Item, &Item::hook>;
+template class structures::IntrusiveDoublyLinkedList<Item, &Item::hook>;
+template class structures::IntrusiveLinkedList<Item, &Item::slist_hook>;
+template class structures::IntrusiveLinkedQueue<Item, &Item::slist_hook>;
+template class structures::LruCache<int, int>;
+template class structures::PersistentList<int>;
+template class structures::PersistentStack<int>;
+template class structures::PriorityQueue<int>;
+template class structures::RcuArrayList<int>;
+template class structures::SegmentedQueue<int>;
+template class structures::SegmentedStack<int>;
+template class structures::SoaArrayList<Row>;
+template class structures::TimerWheel<int>;
+template class structures::WorkStealingDeque<int>;
+
+// sem excecoes so a copia/movimento de T pode lancar
+static_assert(noexcept(std::declval<structures::ArrayList<int>&>().at(0)),
+              "at com ThrowPolicy nao lanca sem excecoes");
+static_assert(noexcept(std::declval<structures::LinkedQueue<int>&>().dequeue()),
+              "dequeue com ThrowPolicy nao lanca sem excecoes");
+static_assert(!noexcept(std::declval<structures::ArrayList<std::string>&>()
+                            .push_back(std::string())),
+              "copiar std::string pode lancar");
+
+int main() {
+    structures::TaskScheduler scheduler(2);
+    structures::TaskScheduler::Group group(&scheduler);
+    int sum = 0;
+    group.run([&sum] { sum += 1; });
+    group.wait();
+
+    structures::BurstTrie trie;
+    trie.insert_sorted("a");
+
+    structures::ArrayQueue<char, ExpectedPolicy> queue(16);
+    if (queue.write_to_fd(1).error() != structures::Status::EMPTY) {
+        return 1;
+    }
+
+    if (sum != 1 || !trie.contains("a")) {
+        return 1;
+    }
+    std::puts("no_exceptions_test: ok");
+    return 0;
+}
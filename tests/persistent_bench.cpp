@@ -0,0 +1,81 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Snapshots de uma pilha de BASE dados sob push/pop: PersistentStack
+// (snapshot = copia O(1)) contra copiar a cadeia inteira (std::list).
+// A cada EVERY operacoes guarda um snapshot, mantendo os RETAINED mais
+// recentes; mostra operacoes/s e os nodos vivos no fim.
+#include <algorithm>
+#include <cstdio>
+#include <list>
+#include <vector>
+
+#include "../persistent_stack.h"
+#include "./bench.h"
+
+static const int BASE = 10000;
+static const long OPERATIONS = 1000000;
+static const int RETAINED = 16;
+static const int EVERY[] = {1000, 100, 10, 1};
+
+//! dado que conta as copias vivas (= nodos)
+struct Counted {
+    static long live;
+    int value;
+
+    Counted(int value) : value(value) { live++; }  // NOLINT
+    Counted(const Counted& other) : value(other.value) { live++; }
+    ~Counted() { live--; }
+};
+
+long Counted::live = 0;
+
+//! roda operations operacoes; push e pop alternados em torno de BASE
+template<typename Stack, typename Push, typename Pop>
+static void run(long operations, int every, Push push, Pop pop,
+                double* rate, long* nodes) {
+    Stack stack;
+    for (int i = 0; i < BASE; i++) {
+        push(&stack, i);
+    }
+    std::vector<Stack> snapshots(RETAINED);
+    bench::Stopwatch watch;
+    for (long i = 0; i < operations; i++) {
+        if (i % 2 == 0) {
+            push(&stack, static_cast<int>(i));
+        } else {
+            pop(&stack);
+        }
+        if (i % every == 0) {
+            snapshots[(i / every) % RETAINED] = stack;
+        }
+    }
+    *rate = operations / watch.ms() / 1e3;
+    *nodes = Counted::live;
+}
+
+int main() {
+    using Persistent = structures::PersistentStack<Counted>;
+    using Chain = std::list<Counted>;
+    std::printf("pilha de %d, %d snapshots guardados: milhoes de ops/s e "
+                "nodos vivos\n", BASE, RETAINED);
+    std::puts("  a cada   persistente      nodos   copia   nodos");
+    for (int every : EVERY) {
+        double persistent_rate;
+        long persistent_nodes;
+        run<Persistent>(OPERATIONS, every,
+            [](Persistent* stack, int data) { *stack = stack->push(data); },
+            [](Persistent* stack) { *stack = stack->pop(); },
+            &persistent_rate, &persistent_nodes);
+        // copiar BASE nodos por snapshot: limita o numero de snapshots
+        long operations = std::min<long>(OPERATIONS, 1000L * every);
+        double copy_rate;
+        long copy_nodes;
+        run<Chain>(operations, every,
+            [](Chain* stack, int data) { stack->push_front(data); },
+            [](Chain* stack) { stack->pop_front(); },
+            &copy_rate, &copy_nodes);
+        std::printf("  %6d  %12.2f %10ld %7.3f %7ld\n", every,
+                    persistent_rate, persistent_nodes, copy_rate,
+                    copy_nodes);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Compilado com -fsanitize=thread (veja o Makefile).
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "../persistent_list.h"
+#include "../persistent_stack.h"
+
+static const int THREADS = 4;
+static const int OPERATIONS = 20000;
+
+//! inteiro que conta quantos nodos (copias) existem
+struct Counted {
+    static std::atomic<long> live;
+    int value;
+
+    Counted(int value) : value(value) { live++; }  // NOLINT
+    Counted(const Counted& other) : value(other.value) { live++; }
+    ~Counted() { live--; }
+
+    bool operator==(const Counted& other) const {
+        return value == other.value;
+    }
+};
+
+std::atomic<long> Counted::live{0};
+
+using List = structures::PersistentList<Counted>;
+
+//! versoes novas nao mudam as antigas e dividem a cauda
+static void test_versions() {
+    {
+        List empty;
+        List one = empty.push_front(1);
+        List two = one.push_front(2);
+        List other = one.push_front(3);
+        List popped = two.pop_front();
+        assert(empty.empty() && one.size() == 1 && two.size() == 2);
+        assert(two.front().value == 2 && two.at(1).value == 1);
+        assert(other.front().value == 3 && other.at(1).value == 1);
+        assert(popped.size() == 1 && popped.front().value == 1);
+        // 1 esta uma vez so, dividido por one, two, other e popped
+        assert(Counted::live == 3);
+        assert(two.find(1) == 1 && !two.contains(3) && other.contains(3));
+        List copy = two;
+        two.clear();
+        assert(two.empty() && copy.size() == 2 && Counted::live == 3);
+        bool thrown = false;
+        try { empty.pop_front(); } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    assert(Counted::live == 0);
+}
+
+//! cadeia longa e' liberada sem recursao
+static void test_long_chain() {
+    {
+        List list;
+        for (int i = 0; i < 1000000; i++) {
+            list = list.push_front(i);
+        }
+        assert(list.size() == 1000000 && list.front().value == 999999);
+    }
+    assert(Counted::live == 0);
+}
+
+//! pilha persistente sobre a lista
+static void test_stack() {
+    {
+        structures::PersistentStack<Counted> stack;
+        auto one = stack.push(1);
+        auto two = one.push(2);
+        assert(two.top().value == 2 && two.pop().top().value == 1);
+        assert(one.size() == 1 && two.size() == 2 && stack.empty());
+        two.clear();
+        assert(two.empty() && one.top().value == 1);
+    }
+    assert(Counted::live == 0);
+}
+
+//! threads derivam e soltam versoes que dividem nodos ao mesmo tempo
+static void test_concurrent_versions() {
+    {
+        List base;
+        for (int i = 0; i < 100; i++) {
+            base = base.push_front(i);
+        }
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++) {
+            // cada thread recebe sua copia; so a lista e' compartilhada
+            threads.emplace_back([base, t] {
+                List mine = base;
+                long sum = 0;
+                for (int i = 0; i < OPERATIONS; i++) {
+                    if (i % 3 == 2 && !mine.empty()) {
+                        mine = mine.pop_front();
+                    } else {
+                        mine = mine.push_front(t);
+                    }
+                    if (mine.size() > 150) {
+                        mine = base;
+                    }
+                    sum += mine.front().value;
+                }
+                assert(sum >= 0);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(base.size() == 100 && base.at(99).value == 0);
+        assert(Counted::live == 100);
+    }
+    assert(Counted::live == 0);
+}
+
+int main() {
+    test_versions();
+    test_long_chain();
+    test_stack();
+    test_concurrent_versions();
+    std::puts("persistent_list_test: ok");
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Fila de prioridade com n inteiros aleatorios: push de todos e pop ate
+// esvaziar. PriorityQueue com aridade 2, 4 e 8 contra ArrayList com
+// insert_sorted e pop_back, que desloca o array a cada insercao e por isso
+// so roda ate SORTED_LIMIT.
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "../array_list.h"
+#include "../priority_queue.h"
+#include "./bench.h"
+
+static const std::size_t SIZES[] = {10000, 100000, 1000000, 10000000};
+static const std::size_t SORTED_LIMIT = 100000;
+
+//! ms para inserir data e retirar tudo de volta
+template<std::size_t D>
+static double heap_ms(const std::vector<int>& data) {
+    bench::Stopwatch watch;
+    structures::PriorityQueue<int, std::less<int>, D> queue;
+    for (int value : data) {
+        queue.push(value);
+    }
+    long sum = 0;
+    while (!queue.empty()) {
+        sum += queue.pop();
+    }
+    bench::keep(sum);
+    return watch.ms();
+}
+
+static double sorted_ms(const std::vector<int>& data) {
+    bench::Stopwatch watch;
+    structures::ArrayList<int> list(data.size());
+    for (int value : data) {
+        list.insert_sorted(value);
+    }
+    long sum = 0;
+    while (!list.empty()) {
+        sum += list.pop_back();
+    }
+    bench::keep(sum);
+    return watch.ms();
+}
+
+int main() {
+    std::mt19937 random(34);
+    std::puts("push de n inteiros e pop de todos: ms");
+    std::puts("         n     D=2     D=4     D=8  insert_sorted");
+    for (std::size_t n : SIZES) {
+        std::vector<int> data(n);
+        for (int& value : data) {
+            value = static_cast<int>(random());
+        }
+        std::printf("  %8zu %7.1f %7.1f %7.1f", n, heap_ms<2>(data),
+                    heap_ms<4>(data), heap_ms<8>(data));
+        if (n <= SORTED_LIMIT) {
+            std::printf(" %14.1f\n", sorted_ms(data));
+        } else {
+            std::printf(" %14s\n", "-");
+        }
+    }
+    return 0;
+}
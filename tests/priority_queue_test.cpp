@@ -0,0 +1,73 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "../priority_queue.h"
+
+using Queue = structures::PriorityQueue<int>;
+
+//! topo e' sempre o maior; pop sai em ordem
+static void test_order() {
+    std::vector<int> data{5, 1, 9, 3, 7, 2, 8};
+    Queue queue(data.begin(), data.end());
+    for (int expected : {9, 8, 7, 5, 3, 2, 1}) {
+        assert(queue.pop() == expected);
+    }
+    assert(queue.empty());
+}
+
+//! handle de elemento retirado nao enxerga o elemento que reusa o id
+static void test_stale_handle() {
+    Queue queue;
+    Queue::Handle old = queue.push(5);
+    queue.pop();
+    Queue::Handle fresh = queue.push(7);
+    assert(!queue.contains(old));
+    assert(queue.contains(fresh) && queue.get(fresh) == 7);
+    bool thrown = false;
+    try {
+        queue.update(old, 1);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown && queue.top() == 7);
+}
+
+//! clear e merge tambem invalidam os handles antigos
+static void test_clear_and_merge() {
+    Queue queue;
+    Queue::Handle a = queue.push(1);
+    queue.clear();
+    queue.push(2);
+    assert(!queue.contains(a));
+
+    Queue other;
+    Queue::Handle b = other.push(3);
+    queue.merge(other);
+    other.push(4);
+    assert(!other.contains(b) && other.size() == 1);
+    assert(queue.size() == 2 && queue.top() == 3);
+}
+
+//! decrease_key e update reposicionam o elemento
+static void test_update() {
+    Queue queue;
+    Queue::Handle low = queue.push(1);
+    queue.push(5);
+    queue.decrease_key(low, 10);
+    assert(queue.top() == 10);
+    queue.update(low, 0);
+    assert(queue.top() == 5 && queue.get(low) == 0);
+}
+
+int main() {
+    test_order();
+    test_stale_handle();
+    test_clear_and_merge();
+    test_update();
+    std::puts("priority_queue_test: ok");
+    return 0;
+}
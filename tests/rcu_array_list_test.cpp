@@ -0,0 +1,81 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Compilado com -fsanitize=thread (veja o Makefile).
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "../rcu_array_list.h"
+
+using List = structures::RcuArrayList<int>;
+
+static const int READERS = 6;
+static const int UPDATES = 2000;
+static const std::size_t CAPACITY = 64;
+
+//! snapshot continua na versao em que foi tirado
+static void test_snapshot_isolation() {
+    List list(CAPACITY);
+    list.update([](structures::ArrayList<int>& version) {
+        version.push_back(1);
+    });
+    auto reader = list.reader();
+    auto before = reader.snapshot();
+    list.update([](structures::ArrayList<int>& version) {
+        version.push_back(2);
+    });
+    assert(before->size() == 1 && (*before)[0] == 1);
+    assert(list.reclaim() == 0);
+    {
+        // aninhado: ve a versao nova e a antiga segue protegida
+        auto after = reader.snapshot();
+        assert(after->size() == 2 && before->size() == 1);
+    }
+    assert(list.reclaim() == 0);
+}
+
+//! leitores nunca veem um lote pela metade nem uma versao liberada
+static void test_concurrent_readers() {
+    List list(CAPACITY);
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < READERS; t++) {
+        readers.emplace_back([&list, &stop] {
+            auto reader = list.reader();
+            while (!stop.load()) {
+                auto snapshot = reader.snapshot();
+                std::size_t size = snapshot->size();
+                assert(size % 2 == 0);
+                for (std::size_t i = 0; i < size; i++) {
+                    assert((*snapshot)[i] == static_cast<int>(i));
+                }
+            }
+        });
+    }
+    // cada lote acrescenta dois dados, ou esvazia a lista se encheu
+    for (int i = 0; i < UPDATES; i++) {
+        list.update([](structures::ArrayList<int>& version) {
+            if (version.size() + 2 > version.max_size()) {
+                version.clear();
+            }
+            int next = static_cast<int>(version.size());
+            version.push_back(next);
+            version.push_back(next + 1);
+        });
+    }
+    stop = true;
+    for (auto& thread : readers) {
+        thread.join();
+    }
+    list.reclaim();
+    auto reader = list.reader();
+    assert(reader.snapshot()->size() % 2 == 0);
+}
+
+int main() {
+    test_snapshot_isolation();
+    test_concurrent_readers();
+    std::puts("rcu_array_list_test: ok");
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Mensagens pequenas (ints) por SegmentedQueue, LinkedQueue e std::queue
+// (sobre std::deque). Regime estavel: fila com DEPTH mensagens e MESSAGES
+// pares enqueue/dequeue. Rajadas: BURST enqueues seguidos de BURST
+// dequeues, ate MESSAGES. Mostra milhoes de mensagens por segundo.
+#include <cstdio>
+#include <queue>
+
+#include "../linked_queue.h"
+#include "../segmented_queue.h"
+#include "./bench.h"
+
+static const std::size_t MESSAGES = 50000000;
+static const std::size_t DEPTHS[] = {16, 1000, 100000};
+static const std::size_t BURST = 1000000;
+
+//! milhoes de pares enqueue/dequeue por segundo com depth na fila
+template<typename Queue, typename Push, typename Pop>
+static double steady(std::size_t depth, Push push, Pop pop) {
+    Queue queue;
+    long sum = 0;
+    for (std::size_t i = 0; i < depth; i++) {
+        push(&queue, static_cast<int>(i));
+    }
+    bench::Stopwatch watch;
+    for (std::size_t i = 0; i < MESSAGES; i++) {
+        push(&queue, static_cast<int>(i));
+        sum += pop(&queue);
+    }
+    double rate = MESSAGES / watch.ms() / 1e3;
+    bench::keep(sum);
+    return rate;
+}
+
+//! milhoes de mensagens por segundo em rajadas de BURST
+template<typename Queue, typename Push, typename Pop>
+static double bursts(Push push, Pop pop) {
+    Queue queue;
+    long sum = 0;
+    bench::Stopwatch watch;
+    for (std::size_t done = 0; done < MESSAGES; done += BURST) {
+        for (std::size_t i = 0; i < BURST; i++) {
+            push(&queue, static_cast<int>(i));
+        }
+        for (std::size_t i = 0; i < BURST; i++) {
+            sum += pop(&queue);
+        }
+    }
+    double rate = MESSAGES / watch.ms() / 1e3;
+    bench::keep(sum);
+    return rate;
+}
+
+int main() {
+    using Segmented = structures::SegmentedQueue<int>;
+    using Linked = structures::LinkedQueue<int>;
+    using Standard = std::queue<int>;
+    auto segmented_push = [](Segmented* queue, int data) {
+        queue->enqueue(data);
+    };
+    auto segmented_pop = [](Segmented* queue) { return queue->dequeue(); };
+    auto linked_push = [](Linked* queue, int data) { queue->enqueue(data); };
+    auto linked_pop = [](Linked* queue) { return queue->dequeue(); };
+    auto standard_push = [](Standard* queue, int data) { queue->push(data); };
+    auto standard_pop = [](Standard* queue) {
+        int data = queue->front();
+        queue->pop();
+        return data;
+    };
+    std::printf("%zu mensagens int, milhoes por segundo\n", MESSAGES);
+    std::puts("                  Segmented     Linked  std::queue");
+    for (std::size_t depth : DEPTHS) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "estavel %zu", depth);
+        std::printf("  %-14s %10.1f %10.1f %11.1f\n", name,
+                    steady<Segmented>(depth, segmented_push, segmented_pop),
+                    steady<Linked>(depth, linked_push, linked_pop),
+                    steady<Standard>(depth, standard_push, standard_pop));
+    }
+    std::printf("  %-14s %10.1f %10.1f %11.1f\n", "rajadas 1M",
+                bursts<Segmented>(segmented_push, segmented_pop),
+                bursts<Linked>(linked_push, linked_pop),
+                bursts<Standard>(standard_push, standard_pop));
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "../segmented_queue.h"
+
+//! alocacoes feitas por new desde o inicio do programa
+static long allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+using Queue = structures::SegmentedQueue<std::string>;
+
+//! ondas de enqueue/dequeue cruzando blocos, conferidas com um deque
+static void test_waves() {
+    Queue queue(4);
+    std::deque<std::string> reference;
+    std::mt19937 random(48);
+    for (int wave = 0; wave < 300; wave++) {
+        std::size_t pushes = random() % 40;
+        for (std::size_t i = 0; i < pushes; i++) {
+            std::string data(20 + random() % 20, 'a' + random() % 26);
+            if (random() % 2) {
+                queue.enqueue(data);
+            } else {
+                std::string moved = data;
+                queue.enqueue(std::move(moved));
+            }
+            reference.push_back(data);
+            assert(queue.back() == reference.back());
+        }
+        std::size_t pops = random() % (reference.size() + 1);
+        for (std::size_t i = 0; i < pops; i++) {
+            assert(queue.front() == reference.front());
+            assert(queue.dequeue() == reference.front());
+            reference.pop_front();
+        }
+        assert(queue.size() == reference.size());
+        assert(queue.empty() == reference.empty());
+        if (!reference.empty()) {
+            assert(queue.back() == reference.back());
+        }
+    }
+    // clear no meio de um bloco e reuso
+    queue.clear();
+    assert(queue.empty() && queue.size() == 0);
+    queue.enqueue("depois");
+    assert(queue.front() == "depois" && queue.back() == "depois");
+}
+
+//! fila em regime estavel reaproveita os blocos do cache sem alocar
+static void test_recycling() {
+    structures::SegmentedQueue<int> queue(8);
+    for (int i = 0; i < 20; i++) {
+        queue.enqueue(i);
+    }
+    int next = 0;
+    // aquecimento: o cache passa a ter os blocos que a fila precisa
+    for (int i = 20; i < 100; i++) {
+        queue.enqueue(i);
+        assert(queue.dequeue() == next++);
+    }
+    long before = allocations;
+    for (int i = 100; i < 100000; i++) {
+        queue.enqueue(i);
+        assert(queue.dequeue() == next++);
+    }
+    assert(allocations == before);
+    // ondas maiores que o cache voltam a alocar
+    for (int i = 0; i < 200; i++) {
+        queue.enqueue(i);
+    }
+    assert(allocations > before);
+    assert(queue.size() == 220);
+}
+
+//! tamanhos de bloco padrao e vazia falhando com out_of_range
+static void test_sizes_and_empty() {
+    assert(structures::SegmentedQueue<int>().segment_size() == 1024);
+    struct Big {
+        char bytes[1024];
+    };
+    assert(structures::SegmentedQueue<Big>().segment_size() == 16);
+    structures::SegmentedQueue<int> single(0);
+    assert(single.segment_size() == 1);
+    for (int i = 0; i < 10; i++) {
+        single.enqueue(i);
+    }
+    for (int i = 0; i < 10; i++) {
+        assert(single.front() == i && single.back() == 9);
+        assert(single.dequeue() == i);
+    }
+    Queue queue;
+    int thrown = 0;
+    try { queue.dequeue(); } catch (const std::out_of_range&) { thrown++; }
+    try { queue.front(); } catch (const std::out_of_range&) { thrown++; }
+    try { queue.back(); } catch (const std::out_of_range&) { thrown++; }
+    assert(thrown == 3);
+}
+
+int main() {
+    test_waves();
+    test_recycling();
+    test_sizes_and_empty();
+    std::puts("segmented_queue_test: ok");
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Ondas fundas de push/pop: SegmentedStack contra std::vector, que cresce
+// dobrando e copiando. Alem do tempo total, mostra o pior lote de BATCH
+// pushes, onde aparece o pico de uma realocacao.
+#include <cstdio>
+#include <vector>
+
+#include "../segmented_stack.h"
+#include "./bench.h"
+
+static const std::size_t DEPTH = 1u << 24;
+static const std::size_t BATCH = 1u << 16;
+static const int WAVES = 3;
+
+struct Timing {
+    double total;
+    double worst_batch;
+};
+
+//! WAVES ondas ate DEPTH e de volta a zero, num conteiner novo
+template<typename Stack, typename Push, typename Pop>
+static Timing waves(Push push, Pop pop) {
+    Stack stack;
+    Timing timing{0, 0};
+    long sum = 0;
+    bench::Stopwatch total;
+    for (int wave = 0; wave < WAVES; wave++) {
+        for (std::size_t i = 0; i < DEPTH; i += BATCH) {
+            bench::Stopwatch batch;
+            for (std::size_t j = 0; j < BATCH; j++) {
+                push(&stack, static_cast<int>(i + j));
+            }
+            double ms = batch.ms();
+            timing.worst_batch = ms > timing.worst_batch ? ms
+                                                         : timing.worst_batch;
+        }
+        for (std::size_t i = 0; i < DEPTH; i++) {
+            sum += pop(&stack);
+        }
+    }
+    timing.total = total.ms();
+    bench::keep(sum);
+    return timing;
+}
+
+int main() {
+    using Segmented = structures::SegmentedStack<int>;
+    using Vector = std::vector<int>;
+    Timing segmented = waves<Segmented>(
+        [](Segmented* stack, int data) { stack->push(data); },
+        [](Segmented* stack) { return stack->pop(); });
+    Timing vector = waves<Vector>(
+        [](Vector* stack, int data) { stack->push_back(data); },
+        [](Vector* stack) {
+            int data = stack->back();
+            stack->pop_back();
+            return data;
+        });
+    std::printf("%d ondas de %zu ints: ms total, pior lote de %zu pushes\n",
+                WAVES, DEPTH, BATCH);
+    std::printf("  SegmentedStack %8.1f %8.3f\n", segmented.total,
+                segmented.worst_batch);
+    std::printf("  std::vector    %8.1f %8.3f\n", vector.total,
+                vector.worst_batch);
+    return 0;
+}
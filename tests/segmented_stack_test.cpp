@@ -0,0 +1,84 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../segmented_stack.h"
+
+using Stack = structures::SegmentedStack<std::string>;
+
+//! ondas de push/pop cruzando blocos, conferidas com um vector
+static void test_waves() {
+    Stack stack(4);
+    std::vector<std::string> reference;
+    std::mt19937 random(3);
+    for (int wave = 0; wave < 200; wave++) {
+        std::size_t pushes = random() % 300;
+        for (std::size_t i = 0; i < pushes; i++) {
+            std::string data = std::to_string(random());
+            stack.push(data);
+            reference.push_back(data);
+        }
+        std::size_t pops = random() % (reference.size() + 1);
+        for (std::size_t i = 0; i < pops; i++) {
+            assert(stack.top() == reference.back());
+            assert(stack.pop() == reference.back());
+            reference.pop_back();
+        }
+        assert(stack.size() == reference.size());
+        assert(stack.max_size() >= stack.size());
+    }
+    stack.clear();
+    assert(stack.empty() && stack.max_size() == 0);
+}
+
+//! crescer nao move nenhum dado ja empilhado
+static void test_no_relocation() {
+    structures::SegmentedStack<int> stack(1);
+    std::vector<int*> addresses;
+    for (int i = 0; i < 5000; i++) {
+        stack.push(i);
+        addresses.push_back(&stack.top());
+    }
+    for (int i = 0; i < 5000; i++) {
+        assert(*addresses[i] == i);
+    }
+    // blocos de 1, 2, 4, ...: a capacidade e' a soma deles
+    assert(stack.max_size() == 8191);
+}
+
+//! oscilar na fronteira de um bloco reaproveita o bloco em cache
+static void test_hysteresis() {
+    structures::SegmentedStack<int> stack(4);
+    for (int i = 0; i < 5; i++) {
+        stack.push(i);  // o quinto abre o segundo bloco
+    }
+    int* second = &stack.top();
+    for (int round = 0; round < 100; round++) {
+        stack.pop();
+        assert(stack.max_size() == 4 && stack.top() == 3);
+        stack.push(round);
+        assert(&stack.top() == second && stack.max_size() == 12);
+    }
+}
+
+//! vazia falha com out_of_range
+static void test_empty() {
+    Stack stack;
+    int thrown = 0;
+    try { stack.pop(); } catch (const std::out_of_range&) { thrown++; }
+    try { stack.top(); } catch (const std::out_of_range&) { thrown++; }
+    assert(thrown == 2);
+}
+
+int main() {
+    test_waves();
+    test_no_relocation();
+    test_hysteresis();
+    test_empty();
+    std::puts("segmented_stack_test: ok");
+    return 0;
+}
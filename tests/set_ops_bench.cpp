@@ -0,0 +1,141 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Operacoes de conjunto conforme a razao entre os tamanhos: a lista grande
+// fica fixa e a pequena encolhe. A partir de GALLOP_RATIO (32) a
+// intersecao de ArrayList galopa; abaixo dela varre com SSE2.
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "../array_list.h"
+#include "../doubly_circular_list.h"
+#include "./bench.h"
+
+static const std::size_t LARGE = 1u << 20;
+static const std::size_t LINKED_LARGE = 1u << 17;
+static const std::size_t RATIOS[] = {1, 4, 16, 32, 128, 1024};
+static const int REPEATS = 5;
+
+static std::vector<std::int32_t> random_sorted(std::mt19937* random,
+                                               std::size_t size) {
+    std::vector<std::int32_t> values(size);
+    for (auto& value : values) {
+        value = static_cast<std::int32_t>((*random)() % (4 * LARGE));
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+template<typename List>
+static void fill(List* list, const std::vector<std::int32_t>& values) {
+    for (auto value : values) {
+        list->push_back(value);
+    }
+}
+
+//! melhor de REPEATS para op sobre listas novas; so op entra no tempo
+template<typename List, typename Op>
+static double time_list(const std::vector<std::int32_t>& a,
+                        const std::vector<std::int32_t>& b, Op op,
+                        List* (*make)(std::size_t)) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        List* list = make(a.size() + b.size());
+        List* other = make(b.size());
+        fill(list, a);
+        fill(other, b);
+        bench::Stopwatch watch;
+        op(list, other);
+        double ms = watch.ms();
+        bench::keep(list->size());
+        best = r == 0 || ms < best ? ms : best;
+        delete list;
+        delete other;
+    }
+    return best;
+}
+
+//! o mesmo com std::set_* sobre vetores, saida ja reservada
+template<typename Op>
+static double time_std(const std::vector<std::int32_t>& a,
+                       const std::vector<std::int32_t>& b, Op op) {
+    double best = 0;
+    std::vector<std::int32_t> out;
+    for (int r = 0; r < REPEATS; r++) {
+        out.clear();
+        out.reserve(a.size() + b.size());
+        bench::Stopwatch watch;
+        op(a, b, &out);
+        double ms = watch.ms();
+        bench::keep(out.size());
+        best = r == 0 || ms < best ? ms : best;
+    }
+    return best;
+}
+
+using Array = structures::ArrayList<std::int32_t>;
+using Linked = structures::DoublyCircularList<std::int32_t>;
+
+static Array* make_array(std::size_t capacity) { return new Array(capacity); }
+static Linked* make_linked(std::size_t) { return new Linked(); }
+
+//! ArrayList contra std::set_intersection e std::set_union
+static void bench_array_list() {
+    std::mt19937 random(3);
+    auto large = random_sorted(&random, LARGE);
+    std::puts("ArrayList<int32_t>: ms, grande com 2^20 dados");
+    std::puts("  razao  intersecao   std::set_*   uniao   std::set_*");
+    for (std::size_t ratio : RATIOS) {
+        auto small = random_sorted(&random, LARGE / ratio);
+        double intersection = time_list<Array>(large, small,
+            [](Array* list, Array* other) {
+                list->set_intersection(*other);
+            }, make_array);
+        double std_intersection = time_std(large, small,
+            [](const std::vector<std::int32_t>& a,
+               const std::vector<std::int32_t>& b,
+               std::vector<std::int32_t>* out) {
+                std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                                      std::back_inserter(*out));
+            });
+        double union_ = time_list<Array>(large, small,
+            [](Array* list, Array* other) { list->set_union(*other); },
+            make_array);
+        double std_union = time_std(large, small,
+            [](const std::vector<std::int32_t>& a,
+               const std::vector<std::int32_t>& b,
+               std::vector<std::int32_t>* out) {
+                std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                               std::back_inserter(*out));
+            });
+        std::printf("  %5zu  %10.3f  %11.3f  %6.3f  %11.3f\n", ratio,
+                    intersection, std_intersection, union_, std_union);
+    }
+}
+
+//! DoublyCircularList: merge religa nodos, intersecao libera os sem par
+static void bench_linked_list() {
+    std::mt19937 random(5);
+    auto large = random_sorted(&random, LINKED_LARGE);
+    std::puts("DoublyCircularList<int32_t>: ms, grande com 2^17 dados");
+    std::puts("  razao       merge  intersecao");
+    for (std::size_t ratio : RATIOS) {
+        auto small = random_sorted(&random, LINKED_LARGE / ratio);
+        double merge = time_list<Linked>(large, small,
+            [](Linked* list, Linked* other) { list->merge(*other); },
+            make_linked);
+        double intersection = time_list<Linked>(large, small,
+            [](Linked* list, Linked* other) {
+                list->set_intersection(*other);
+            }, make_linked);
+        std::printf("  %5zu  %10.3f  %10.3f\n", ratio, merge, intersection);
+    }
+}
+
+int main() {
+    bench_array_list();
+    bench_linked_list();
+    return 0;
+}
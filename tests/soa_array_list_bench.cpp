@@ -0,0 +1,85 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Varredura por um campo de 8 bytes em COUNT linhas de 64 bytes: AoS
+// (ArrayList<Trade>, cada linha inteira passa pela cache) contra SoA
+// (SoaArrayList<Trade>, so a coluna do campo). Conta as linhas que passam
+// no filtro e procura a primeira, que so aparece no fim; melhor de
+// REPEATS, em ms.
+#include <cstdio>
+#include <tuple>
+
+#include "../array_list.h"
+#include "../soa_array_list.h"
+#include "./bench.h"
+
+static const std::size_t COUNT = 1u << 22;
+static const int REPEATS = 5;
+
+struct Trade {
+    double price;
+    double bid;
+    double ask;
+    long qty;
+    long id;
+    long timestamp;
+    long venue;
+    long flags;
+};
+
+template<>
+struct structures::soa_fields<Trade> {
+    static constexpr auto members = std::make_tuple(
+        &Trade::price, &Trade::bid, &Trade::ask, &Trade::qty, &Trade::id,
+        &Trade::timestamp, &Trade::venue, &Trade::flags);
+};
+
+template<typename F>
+static double best_ms(F scan) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        bench::Stopwatch watch;
+        bench::keep(scan());
+        double ms = watch.ms();
+        best = r == 0 || ms < best ? ms : best;
+    }
+    return best;
+}
+
+int main() {
+    static_assert(sizeof(Trade) == 64, "linha de 64 bytes");
+    structures::ArrayList<Trade> rows(COUNT);
+    structures::SoaArrayList<Trade> columns(COUNT);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        long n = static_cast<long>(i);
+        // so a ultima linha passa de 1000 no preco
+        Trade trade{i + 1 == COUNT ? 2000.0 : static_cast<double>(n % 997),
+                    0, 0, n % 100, n, n, n % 16, 0};
+        rows.push_back(trade);
+        columns.push_back(trade);
+    }
+    double aos_count = best_ms([&rows] {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < rows.size(); i++) {
+            count += rows[i].price > 500 ? 1u : 0u;
+        }
+        return count;
+    });
+    double soa_count = best_ms([&columns] {
+        return columns.count_if<0>([](double price) { return price > 500; });
+    });
+    double aos_find = best_ms([&rows] {
+        std::size_t i = 0;
+        while (i < rows.size() && !(rows[i].price > 1000)) {
+            i++;
+        }
+        return i;
+    });
+    double soa_find = best_ms([&columns] {
+        return columns.find_if<0>([](double price) { return price > 1000; });
+    });
+    std::printf("%zu linhas de %zu bytes, filtro em price: ms\n", COUNT,
+                sizeof(Trade));
+    std::puts("                 AoS      SoA");
+    std::printf("  count_if  %8.2f %8.2f\n", aos_count, soa_count);
+    std::printf("  find_if   %8.2f %8.2f\n", aos_find, soa_find);
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../soa_array_list.h"
+
+struct Trade {
+    double price;
+    int qty;
+    long id;
+    std::string venue;
+
+    bool operator==(const Trade& other) const {
+        return price == other.price && qty == other.qty &&
+               id == other.id && venue == other.venue;
+    }
+};
+
+template<>
+struct structures::soa_fields<Trade> {
+    static constexpr auto members = std::make_tuple(
+        &Trade::price, &Trade::qty, &Trade::id, &Trade::venue);
+};
+
+using List = structures::SoaArrayList<Trade>;
+
+static Trade trade(long id) {
+    // venue longa o bastante para sair do buffer curto de std::string
+    return Trade{id * 0.5, static_cast<int>(id % 7), id,
+                 "venue-" + std::string(20, 'v') + std::to_string(id)};
+}
+
+//! linhas e colunas iguais ao vetor de referencia
+static void check(const List& list, const std::vector<Trade>& expected) {
+    assert(list.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        assert(list.at(i) == expected[i]);
+        assert(list.column<0>()[i] == expected[i].price);
+        assert(list.column<3>()[i] == expected[i].venue);
+    }
+}
+
+//! operacoes aleatorias comparadas com um std::vector de linhas
+static void test_against_vector() {
+    std::mt19937 random(39);
+    List list(200);
+    std::vector<Trade> expected;
+    for (long step = 0; step < 5000; step++) {
+        std::size_t size = expected.size();
+        switch (random() % 7) {
+        case 0:
+        case 1:
+            if (size < 200) {
+                list.push_back(trade(step));
+                expected.push_back(trade(step));
+            }
+            break;
+        case 2:
+            if (size < 200) {
+                std::size_t index = random() % (size + 1);
+                list.insert(trade(step), index);
+                expected.insert(expected.begin() + index, trade(step));
+            }
+            break;
+        case 3:
+            if (size > 0) {
+                std::size_t index = random() % size;
+                assert(list.pop(index) == expected[index]);
+                expected.erase(expected.begin() + index);
+            }
+            break;
+        case 4:
+            if (size > 0) {
+                assert(list.pop_front() == expected.front());
+                expected.erase(expected.begin());
+            }
+            break;
+        case 5:
+            if (size > 0) {
+                std::size_t index = random() % size;
+                list.set(index, trade(-step));
+                expected[index] = trade(-step);
+            }
+            break;
+        case 6:
+            if (size > 0) {
+                std::size_t index = random() % size;
+                list.get<1>(index) = 100;
+                expected[index].qty = 100;
+            }
+            break;
+        }
+        if (step % 100 == 0) {
+            check(list, expected);
+        }
+    }
+    check(list, expected);
+}
+
+//! find_if acha o primeiro acerto dentro e nas bordas dos blocos
+static void test_find_if() {
+    List list(300);
+    for (long i = 0; i < 300; i++) {
+        list.push_back(Trade{0, 0, i, ""});
+    }
+    for (long target : {0L, 1L, 63L, 64L, 65L, 127L, 128L, 255L, 256L,
+                        299L}) {
+        assert(list.find_if<2>([target](long id) {
+            return id >= target;
+        }) == static_cast<std::size_t>(target));
+        // dois acertos no mesmo bloco: vale o primeiro
+        assert(list.find_if<2>([target](long id) {
+            return id == target || id == target + 1;
+        }) == static_cast<std::size_t>(target));
+    }
+    assert(list.find_if<2>([](long id) { return id < 0; }) == 300);
+    assert(list.count_if<2>([](long id) { return id % 3 == 0; }) == 100);
+    List empty;
+    assert(empty.find_if<0>([](double) { return true; }) == 0);
+}
+
+//! cheia, vazia e posicoes invalidas lancam sem mexer na lista
+static void test_errors() {
+    List list(2);
+    int thrown = 0;
+    try { list.pop_back(); } catch (const std::out_of_range&) { thrown++; }
+    list.push_back(trade(1));
+    list.push_front(trade(2));
+    assert(list.full());
+    try { list.push_back(trade(3)); } catch (const std::out_of_range&) {
+        thrown++;
+    }
+    try { list.at(2); } catch (const std::out_of_range&) { thrown++; }
+    try { list.get<0>(2); } catch (const std::out_of_range&) { thrown++; }
+    assert(thrown == 4);
+    assert(list.pop_back() == trade(1) && list.pop_back() == trade(2));
+    try { list.insert(trade(4), 1); } catch (const std::out_of_range&) {
+        thrown++;
+    }
+    assert(thrown == 5 && list.empty());
+}
+
+int main() {
+    test_against_vector();
+    test_find_if();
+    test_errors();
+    std::puts("soa_array_list_test: ok");
+    return 0;
+}
@@ -0,0 +1,253 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../string_list.h"
+
+static const char* const PATH = "string_list_test.bin";
+static const char* const TEXT = "string_list_test.txt";
+static const std::size_t TEXT_SIZE = 3u << 20;  // blocos de 1 MiB
+
+//! todas as insercoes aceitam ate MAX_LENGTH - 1 bytes e recusam o resto
+static void test_length_limit() {
+    structures::ArrayListString list(4);
+    std::string fits(structures::ArrayListString::MAX_LENGTH - 1, 'a');
+    std::string too_long(structures::ArrayListString::MAX_LENGTH, 'b');
+    list.insert(fits.c_str(), 0);
+    int thrown = 0;
+    try { list.push_back(too_long.c_str()); }
+    catch (const std::out_of_range&) { thrown++; }
+    try { list.push_front(too_long.c_str()); }
+    catch (const std::out_of_range&) { thrown++; }
+    try { list.insert_sorted(too_long.c_str()); }
+    catch (const std::out_of_range&) { thrown++; }
+    assert(thrown == 3 && list.size() == 1);
+}
+
+//! remove de dado ausente falha em vez de seguir em silencio
+static void test_remove_missing() {
+    structures::ArrayListString list(4);
+    int thrown = 0;
+    try { list.remove("a"); } catch (const std::out_of_range&) { thrown++; }
+    list.push_back("a");
+    try { list.remove("b"); } catch (const std::out_of_range&) { thrown++; }
+    list.remove("a");
+    assert(thrown == 2 && list.empty());
+}
+
+//! com ExpectedPolicy as falhas voltam como Status
+static void test_expected() {
+    using List = structures::BasicArrayListString<structures::ExpectedPolicy>;
+    List list(2);
+    std::string too_long(List::MAX_LENGTH, 'c');
+    assert(list.push_back(too_long.c_str()).error() ==
+           structures::Status::TOO_LONG);
+    assert(list.pop_back().error() == structures::Status::EMPTY);
+    assert(list.try_push_back("b") == structures::Status::OK);
+    list.push_front("a");
+    assert(list.try_push_back("c") == structures::Status::FULL);
+    assert(std::strcmp(list.at(1).value(), "b") == 0);
+    char* popped = nullptr;
+    assert(list.try_pop_back(&popped) == structures::Status::OK);
+    assert(std::strcmp(popped, "b") == 0);
+    delete [] popped;
+}
+
+//! lista mapeada recusa escrita com Status::READ_ONLY
+static void test_read_only() {
+    using List = structures::BasicArrayListString<structures::ExpectedPolicy>;
+    List list(2);
+    list.push_back("a");
+    list.save(PATH);
+    List mapped = List::open_mapped(PATH);
+    assert(mapped.push_back("b").error() == structures::Status::READ_ONLY);
+    assert(mapped.pop_back().error() == structures::Status::READ_ONLY);
+    assert(mapped.load_file(PATH).error() == structures::Status::READ_ONLY);
+    assert(mapped.size() == 1 && std::strcmp(mapped[0], "a") == 0);
+}
+
+//! grava size bytes de data na posicao offset do arquivo
+static void patch(const char* path, long offset, const void* data,
+                  std::size_t size) {
+    std::FILE* file = std::fopen(path, "r+b");
+    std::fseek(file, offset, SEEK_SET);
+    std::fwrite(data, 1, size, file);
+    std::fclose(file);
+}
+
+//! open_mapped recusa o arquivo
+static bool rejected(const char* path, bool verify) {
+    try {
+        structures::ArrayListString::open_mapped(path, verify);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+//! tabela corrompida e' recusada ao abrir, antes de qualquer leitura
+static void test_corrupt_table() {
+    // fora de ordem: sem indice de prefixo, os offsets comecam no byte 64
+    // e o blob "b\0a\0cc\0" fecha o arquivo
+    structures::ArrayListString list(3);
+    list.push_back("b");
+    list.push_back("a");
+    list.push_back("cc");
+    const long count_at = 16;
+    const long checksum_at = 40;
+    const long offsets_at = 64;
+    const long blob_end = offsets_at + 4 * 8 + 7;
+
+    structures::ArrayListString sorted(2);
+    sorted.push_back("a");
+    sorted.push_back("b");
+    sorted.save(PATH);  // com indice de prefixo
+    assert(!rejected(PATH, true));
+    list.save(PATH);
+    assert(!rejected(PATH, true));
+    // (count + 1) * 8 da a volta
+    std::uint64_t count = (std::uint64_t(1) << 61) - 1;
+    patch(PATH, count_at, &count, sizeof(count));
+    assert(rejected(PATH, false));
+
+    list.save(PATH);
+    std::uint64_t last = 6;  // o blob tem 7 bytes
+    patch(PATH, offsets_at + 3 * 8, &last, sizeof(last));
+    assert(rejected(PATH, false));
+
+    list.save(PATH);
+    patch(PATH, blob_end - 1, "x", 1);
+    assert(rejected(PATH, false));
+
+    // offsets fora de ordem com checksum refeito: so verify percebe
+    list.save(PATH);
+    std::uint64_t offsets[4] = {0, 4, 2, 7};
+    std::uint64_t sum = structures::checksum(offsets, sizeof(offsets));
+    patch(PATH, offsets_at, offsets, sizeof(offsets));
+    patch(PATH, checksum_at, &sum, sizeof(sum));
+    assert(!rejected(PATH, false) && rejected(PATH, true));
+    // checksum errado: verify recusa
+    list.save(PATH);
+    sum = 0;
+    patch(PATH, checksum_at, &sum, sizeof(sum));
+    assert(!rejected(PATH, false) && rejected(PATH, true));
+}
+
+//! texto com palavras repetidas, linhas CRLF e sem quebra no fim;
+//! devolve as linhas como load_file deve le-las
+static std::vector<std::string> write_text() {
+    std::mt19937 random(5);
+    std::string text;
+    std::vector<std::string> lines;
+    while (text.size() < TEXT_SIZE) {
+        std::string line = "w" + std::to_string(random() % 50000);
+        line.append(random() % 20, 'x');
+        lines.push_back(line);
+        text += line + (random() % 4 == 0 ? "\r\n" : "\n");
+    }
+    lines.push_back("fim");
+    text += "fim";
+    std::FILE* file = std::fopen(TEXT, "wb");
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+    return lines;
+}
+
+//! carga com threads de uma lista que ja tem um dado
+static std::vector<std::string> load(std::size_t threads, bool sort,
+                                     bool deduplicate) {
+    structures::ArrayListString list(1);
+    list.push_back("w7");
+    structures::StringLoadOptions options;
+    options.threads = threads;
+    options.sort = sort;
+    options.deduplicate = deduplicate;
+    list.load_file(TEXT, options);
+    std::vector<std::string> loaded;
+    for (std::size_t i = 0; i < list.size(); i++) {
+        loaded.push_back(list[i]);
+    }
+    return loaded;
+}
+
+//! arquivo de varios MiB em varias threads e' lido como em uma so
+static void test_load_threads() {
+    std::vector<std::string> expected = write_text();
+    expected.insert(expected.begin(), "w7");
+    for (int options = 0; options < 4; options++) {
+        bool sort = options & 1;
+        bool deduplicate = options & 2;
+        std::vector<std::string> reference = expected;
+        if (sort) {
+            std::sort(reference.begin(), reference.end());
+        }
+        if (deduplicate) {
+            std::unordered_set<std::string> seen;
+            std::size_t kept = 0;
+            for (const std::string& line : reference) {
+                if (seen.insert(line).second) {
+                    reference[kept++] = line;
+                }
+            }
+            reference.resize(kept);
+        }
+        assert(load(1, sort, deduplicate) == reference);
+        assert(load(4, sort, deduplicate) == reference);
+    }
+}
+
+//! strings do arena: pop entrega copia propria, remove nao libera
+static void test_load_arena() {
+    structures::ArrayListString list(1);
+    list.push_back("heap");
+    list.load_file(TEXT);
+    char* popped = list.pop_back();
+    assert(std::strcmp(popped, "fim") == 0);
+    delete [] popped;
+    list.remove(list[1]);
+    popped = list.pop_front();
+    assert(std::strcmp(popped, "heap") == 0);
+    delete [] popped;
+    list.clear();
+    assert(list.empty() && list.load_file(TEXT) > 0);
+}
+
+//! arquivo que nao abre falha pela Policy
+static void test_load_io_error() {
+    using Expected = structures::BasicArrayListString<
+        structures::ExpectedPolicy>;
+    Expected list(1);
+    assert(list.load_file("nao_existe.txt").error() ==
+           structures::Status::IO_ERROR);
+    structures::ArrayListString throwing(1);
+    bool thrown = false;
+    try {
+        throwing.load_file("nao_existe.txt");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && throwing.empty());
+}
+
+int main() {
+    test_length_limit();
+    test_remove_missing();
+    test_expected();
+    test_read_only();
+    test_corrupt_table();
+    test_load_threads();
+    test_load_arena();
+    test_load_io_error();
+    std::remove(PATH);
+    std::remove(TEXT);
+    std::puts("string_list_test: ok");
+    return 0;
+}
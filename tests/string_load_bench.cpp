@@ -0,0 +1,81 @@
+// Copyright [2019] <Bryan Martins Lima>
+// ArrayListString::load_file em GB/s conforme threads e opcoes, contra
+// std::getline lendo o mesmo arquivo para um vector<std::string>.
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../string_list.h"
+#include "./bench.h"
+
+static const char* const PATH = "string_load_bench.txt";
+static const std::size_t SIZE = 16u << 20;
+static const int REPEATS = 3;
+
+//! linhas de 2 a 40 bytes tiradas de um vocabulario com repetidos
+static std::size_t write_text() {
+    std::mt19937 random(9);
+    std::string text;
+    while (text.size() < SIZE) {
+        text += "k" + std::to_string(random() % 200000);
+        text.append(random() % 32, 'x');
+        text += '\n';
+    }
+    std::FILE* file = std::fopen(PATH, "wb");
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+    return text.size();
+}
+
+//! melhor de REPEATS cargas, em GB/s
+static double load_rate(std::size_t bytes, std::size_t threads, bool sort,
+                        bool deduplicate) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        structures::ArrayListString list;
+        structures::StringLoadOptions options;
+        options.threads = threads;
+        options.sort = sort;
+        options.deduplicate = deduplicate;
+        bench::Stopwatch watch;
+        list.load_file(PATH, options);
+        double rate = bytes / watch.ms() / 1e6;
+        bench::keep(list.size());
+        best = rate > best ? rate : best;
+    }
+    return best;
+}
+
+static double getline_rate(std::size_t bytes) {
+    double best = 0;
+    for (int r = 0; r < REPEATS; r++) {
+        bench::Stopwatch watch;
+        std::ifstream file(PATH);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+        double rate = bytes / watch.ms() / 1e6;
+        bench::keep(lines.size());
+        best = rate > best ? rate : best;
+    }
+    return best;
+}
+
+int main() {
+    std::size_t bytes = write_text();
+    std::printf("load_file de %zu MiB: GB/s\n", bytes >> 20);
+    std::printf("  std::getline:     %6.2f\n", getline_rate(bytes));
+    std::puts("  threads  simples   sort  dedup  sort+dedup");
+    for (std::size_t threads = 1; threads <= 8; threads *= 2) {
+        std::printf("  %7zu  %7.2f  %5.2f  %5.2f  %10.2f\n", threads,
+                    load_rate(bytes, threads, false, false),
+                    load_rate(bytes, threads, true, false),
+                    load_rate(bytes, threads, false, true),
+                    load_rate(bytes, threads, true, true));
+    }
+    std::remove(PATH);
+    return 0;
+}
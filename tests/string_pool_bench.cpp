@@ -0,0 +1,92 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Log com LINES linhas tiradas de DISTINCT mensagens: ArrayListString
+// copiando cada linha contra o modo internado (StringPool). Mostra MB/s
+// de load_file e de push_back, MiB de heap da lista carregada
+// (mallinfo2) e ms para FINDS buscas.
+#include <malloc.h>
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../string_list.h"
+#include "./bench.h"
+
+static const char* const PATH = "string_pool_bench.txt";
+static const std::size_t LINES = 4000000;
+static const std::size_t DISTINCT = 5000;
+static const std::size_t FINDS = 200;
+
+static std::size_t heap_bytes() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+//! lista vazia, com ou sem pool
+static structures::ArrayListString make_list(bool interned) {
+    if (interned) {
+        return structures::ArrayListString(
+            1, std::make_shared<structures::StringPool>());
+    }
+    return structures::ArrayListString(1);
+}
+
+int main() {
+    std::mt19937 random(42);
+    std::vector<std::string> messages;
+    for (std::size_t i = 0; i < DISTINCT; i++) {
+        messages.push_back("INFO worker-" + std::to_string(i % 64) +
+                           " request " + std::to_string(i) +
+                           " finished with status " +
+                           std::to_string(200 + i % 5));
+    }
+    std::vector<const char*> lines;
+    std::size_t bytes = 0;
+    std::FILE* file = std::fopen(PATH, "w");
+    for (std::size_t i = 0; i < LINES; i++) {
+        // poucas mensagens dominam, como num log de verdade
+        std::size_t pick = random() % DISTINCT;
+        pick = pick * (random() % DISTINCT) / DISTINCT;
+        lines.push_back(messages[pick].c_str());
+        bytes += messages[pick].size() + 1;
+        std::fprintf(file, "%s\n", lines.back());
+    }
+    std::fclose(file);
+    std::printf("%zu linhas, %zu mensagens distintas, %.1f MiB\n", LINES,
+                DISTINCT, bytes / 1048576.0);
+    std::puts("              load MB/s  push MB/s   MiB heap  ms find");
+    for (bool interned : {false, true}) {
+        double load;
+        double mib;
+        {
+            std::size_t before = heap_bytes();
+            structures::ArrayListString list = make_list(interned);
+            structures::StringLoadOptions options;
+            options.threads = 1;
+            bench::Stopwatch watch;
+            list.load_file(PATH, options);
+            load = bytes / watch.ms() / 1e3;
+            mib = (heap_bytes() - before) / 1048576.0;
+        }
+        structures::ArrayListString list = make_list(interned);
+        list.reserve(LINES);
+        bench::Stopwatch watch;
+        for (const char* line : lines) {
+            list.push_back(line);
+        }
+        double push = bytes / watch.ms() / 1e3;
+        watch.restart();
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < FINDS; i++) {
+            found += list.find(messages[DISTINCT - 1 - i].c_str());
+        }
+        double find = watch.ms();
+        bench::keep(found);
+        std::printf("  %-10s %10.1f %10.1f %10.1f %8.1f\n",
+                    interned ? "internado" : "copia", load, push, mib, find);
+    }
+    std::remove(PATH);
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../string_list.h"
+#include "../string_pool.h"
+
+static const char* const TEXT = "string_pool_test.txt";
+
+using List = structures::ArrayListString;
+
+//! strings iguais dividem um ponteiro; contas de bytes e economia
+static void test_intern() {
+    structures::StringPool pool;
+    const char* a = pool.intern("alpha");
+    const char* b = pool.intern(std::string("alp") + "ha");
+    const char* c = pool.intern("beta");
+    assert(a == b && a != c && std::strcmp(a, "alpha") == 0);
+    assert(pool.lookup("alpha") == a && pool.lookup("gamma") == nullptr);
+    assert(pool.lookup("alph") == nullptr);
+    // string vazia e com '\0' no meio tambem sao internadas
+    const char* empty = pool.intern("");
+    std::string_view nul("a\0b", 3);
+    const char* inner = pool.intern(nul);
+    assert(*empty == '\0' && pool.lookup("") == empty);
+    assert(pool.lookup(nul) == inner && std::memcmp(inner, "a\0b", 4) == 0);
+    assert(pool.size() == 4);
+    assert(pool.bytes() == 6 + 5 + 1 + 4);
+    assert(pool.saved() == 6);
+    assert(pool.memory_usage() >= pool.bytes());
+}
+
+//! ponteiros nao mudam quando o pool abre blocos novos
+static void test_stable_pointers() {
+    structures::StringPool pool;
+    std::vector<const char*> pointers;
+    for (int i = 0; i < 20000; i++) {
+        pointers.push_back(pool.intern("key-" + std::to_string(i)));
+    }
+    // maior que um bloco: ganha bloco proprio
+    std::string big(100000, 'z');
+    const char* large = pool.intern(big);
+    const char* small = pool.intern("depois do grande");
+    for (int i = 0; i < 20000; i++) {
+        std::string key = "key-" + std::to_string(i);
+        assert(std::strcmp(pointers[i], key.c_str()) == 0);
+        assert(pool.intern(key) == pointers[i]);
+    }
+    assert(large == pool.lookup(big) && big == large);
+    assert(std::strcmp(small, "depois do grande") == 0);
+}
+
+//! duas listas no mesmo pool guardam o mesmo ponteiro
+static void test_shared_pool() {
+    auto pool = std::make_shared<structures::StringPool>();
+    List first(8, pool);
+    List second(8, pool);
+    first.push_back("get");
+    first.insert_sorted("put");
+    second.push_front("put");
+    second.insert("get", 0);
+    assert(first.pool() == pool.get() && second.pool() == pool.get());
+    assert(first[0] == second[0] && first[1] == second[1]);
+    assert(first[0] == pool->lookup("get"));
+    assert(pool->size() == 2 && pool->saved() == 8);
+}
+
+//! find e contains comparam ponteiros; chave fora do pool nao acha nada
+static void test_pointer_find() {
+    auto pool = std::make_shared<structures::StringPool>();
+    List list(16, pool);
+    for (const char* key : {"b", "a", "c", "a", "b"}) {
+        list.push_back(key);
+    }
+    std::string probe = "c";
+    assert(list.find(probe.c_str()) == 2);
+    assert(list.find(std::string_view("a")) == 1);
+    assert(list.contains("b") && !list.contains("d"));
+    // a chave existe no pool mas nao nesta lista
+    pool->intern("d");
+    assert(!list.contains("d") && list.find("d") == list.size());
+    List other(4, pool);
+    other.push_back("e");
+    assert(!list.contains("e"));
+}
+
+//! pop, remove e clear nao liberam: as strings continuam no pool
+static void test_pop_keeps_strings() {
+    auto pool = std::make_shared<structures::StringPool>();
+    char* popped;
+    {
+        List list(8, pool);
+        list.push_back("first");
+        list.push_back("second");
+        list.push_back("third");
+        list.push_back("first");
+        popped = list.pop_front();
+        assert(popped == pool->lookup("first"));
+        list.remove("second");
+        assert(list.pop_back() == popped);
+        list.clear();
+        assert(list.empty());
+    }
+    // a lista acabou; o pool ainda guarda tudo
+    assert(std::strcmp(popped, "first") == 0);
+    assert(std::strcmp(pool->lookup("second"), "second") == 0);
+    assert(pool->size() == 3);
+}
+
+//! load_file interna as linhas no pool da lista
+static void test_load() {
+    std::FILE* file = std::fopen(TEXT, "w");
+    for (int i = 0; i < 30000; i++) {
+        std::fprintf(file, "event-%d\n", i % 100);
+    }
+    std::fclose(file);
+    auto pool = std::make_shared<structures::StringPool>();
+    List list(1, pool);
+    assert(list.load_file(TEXT) == 30000);
+    assert(pool->size() == 100);
+    assert(list[0] == list[100] && list[0] == pool->lookup("event-0"));
+    assert(list.find("event-42") == 42);
+    std::remove(TEXT);
+}
+
+int main() {
+    test_intern();
+    test_stable_pointers();
+    test_shared_pool();
+    test_pointer_find();
+    test_pop_keeps_strings();
+    test_load();
+    std::puts("string_pool_test: ok");
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Copyright [2019] <Bryan Martins Lima>
+// insert_sorted de COUNT chaves e find de cada uma (mais COUNT ausentes)
+// em ArrayListString, que guarda tamanho e os 8 primeiros bytes junto do
+// ponteiro, contra a mesma lista so de char* comparando com strcmp. Tres
+// conjuntos de chaves: palavras curtas, caminhos de arquivo e URLs com
+// prefixo comum longo (onde os 8 bytes iniciais nao decidem). ms.
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../string_list.h"
+#include "./bench.h"
+
+static const std::size_t COUNT = 20000;
+
+//! lista ordenada de copias char*, comparando com strcmp
+class RawList {
+ public:
+    ~RawList() {
+        for (char* data : contents_) {
+            delete [] data;
+        }
+    }
+    void insert_sorted(const char* data) {
+        std::size_t index = 0;
+        while (index < contents_.size() &&
+               std::strcmp(contents_[index], data) < 0) {
+            index++;
+        }
+        char* copy = new char[std::strlen(data) + 1];
+        std::strcpy(copy, data);
+        contents_.insert(contents_.begin() + index, copy);
+    }
+    std::size_t find(const char* data) const {
+        for (std::size_t i = 0; i < contents_.size(); i++) {
+            if (std::strcmp(contents_[i], data) == 0) {
+                return i;
+            }
+        }
+        return contents_.size();
+    }
+
+ private:
+    std::vector<char*> contents_;
+};
+
+static std::vector<std::string> words(std::mt19937* random) {
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < 2 * COUNT; i++) {
+        std::string key;
+        for (std::size_t n = 3 + (*random)() % 8; n > 0; n--) {
+            key += static_cast<char>('a' + (*random)() % 26);
+        }
+        keys.push_back(key + std::to_string(i));
+    }
+    return keys;
+}
+
+static std::vector<std::string> paths(std::mt19937* random) {
+    static const char* const dirs[] = {"/usr/lib/", "/usr/include/c++/",
+                                       "/home/user/src/", "/var/log/"};
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < 2 * COUNT; i++) {
+        keys.push_back(std::string(dirs[(*random)() % 4]) + "module" +
+                       std::to_string((*random)() % 100) + "/file" +
+                       std::to_string(i) + ".h");
+    }
+    return keys;
+}
+
+static std::vector<std::string> urls(std::mt19937* random) {
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < 2 * COUNT; i++) {
+        keys.push_back("https://example.com/api/v2/users/" +
+                       std::to_string((*random)() % 1000000) + "/items/" +
+                       std::to_string(i));
+    }
+    return keys;
+}
+
+//! ms para inserir as COUNT primeiras e ms para procurar todas as chaves
+template<typename List>
+static void run(const std::vector<std::string>& keys, List* list) {
+    bench::Stopwatch watch;
+    for (std::size_t i = 0; i < COUNT; i++) {
+        list->insert_sorted(keys[i].c_str());
+    }
+    double insert = watch.ms();
+    watch.restart();
+    std::size_t found = 0;
+    for (const std::string& key : keys) {
+        found += list->find(key.c_str()) != COUNT ? 1u : 0u;
+    }
+    double find = watch.ms();
+    bench::keep(found);
+    std::printf(" %9.1f %9.1f", insert, find);
+}
+
+int main() {
+    std::mt19937 random(40);
+    std::printf("%zu insert_sorted e %zu find (metade ausente): ms\n",
+                COUNT, 2 * COUNT);
+    std::puts("             ArrayListString          strcmp");
+    std::puts("               insere   procura    insere   procura");
+    struct Set {
+        const char* name;
+        std::vector<std::string> (*make)(std::mt19937*);
+    };
+    for (Set set : {Set{"palavras", words}, Set{"caminhos", paths},
+                    Set{"URLs", urls}}) {
+        std::vector<std::string> keys = set.make(&random);
+        std::printf("  %-9s", set.name);
+        structures::ArrayListString list(COUNT);
+        run(keys, &list);
+        RawList raw;
+        run(keys, &raw);
+        std::puts("");
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright [2019] <Bryan Martins Lima>
+// Compilado com -fsanitize=thread (veja o Makefile). O TSan nao modela
+// atomic_thread_fence: o deque e' conferido tambem pelo resultado.
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "../task_scheduler.h"
+#include "../work_stealing_deque.h"
+
+using structures::TaskScheduler;
+
+static const int THIEVES = 3;
+static const int PUSHES = 50000;
+
+//! fib recursivo, um ramo em outra tarefa
+static long fib(TaskScheduler* scheduler, int n) {
+    if (n < 12) {
+        return n < 2 ? n : fib(scheduler, n - 1) + fib(scheduler, n - 2);
+    }
+    long first = 0;
+    TaskScheduler::Group group(scheduler);
+    group.run([scheduler, n, &first] { first = fib(scheduler, n - 1); });
+    long second = fib(scheduler, n - 2);
+    group.wait();
+    return first + second;
+}
+
+//! quicksort com a metade da esquerda em outra tarefa
+static void sort(TaskScheduler* scheduler, int* begin, int* end) {
+    if (end - begin < 512) {
+        std::sort(begin, end);
+        return;
+    }
+    int pivot = begin[(end - begin) / 2];
+    int* less = std::partition(begin, end, [pivot](int v) {
+        return v < pivot;
+    });
+    int* greater = std::partition(less, end, [pivot](int v) {
+        return v == pivot;
+    });
+    TaskScheduler::Group group(scheduler);
+    group.run([scheduler, begin, less] { sort(scheduler, begin, less); });
+    sort(scheduler, greater, end);
+    group.wait();
+}
+
+//! dono empilha e desempilha enquanto ladroes roubam; nada se perde
+static void test_deque_steal() {
+    structures::WorkStealingDeque<int> deque(2);  // forca varios grow
+    std::atomic<bool> done{false};
+    std::atomic<long> sum{0};
+    std::atomic<int> taken{0};
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < THIEVES; t++) {
+        thieves.emplace_back([&deque, &done, &sum, &taken] {
+            int data;
+            while (!done || !deque.empty()) {
+                if (deque.steal(&data)) {
+                    sum += data;
+                    taken++;
+                }
+            }
+        });
+    }
+    int data;
+    for (int i = 1; i <= PUSHES; i++) {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(&data)) {
+            sum += data;
+            taken++;
+        }
+    }
+    while (deque.pop(&data)) {
+        sum += data;
+        taken++;
+    }
+    done = true;
+    for (auto& thread : thieves) {
+        thread.join();
+    }
+    assert(taken == PUSHES);
+    assert(sum == static_cast<long>(PUSHES) * (PUSHES + 1) / 2);
+    assert(deque.capacity() > 2);
+}
+
+//! recursao fork-join mais funda que o numero de workers
+static void test_fork_join() {
+    TaskScheduler scheduler(4);
+    assert(scheduler.workers() == 4);
+    assert(fib(&scheduler, 22) == 17711);
+
+    std::vector<int> data(50000);
+    std::mt19937 random(1);
+    for (int& value : data) {
+        value = static_cast<int>(random() % 10000);
+    }
+    sort(&scheduler, data.data(), data.data() + data.size());
+    assert(std::is_sorted(data.begin(), data.end()));
+}
+
+//! excecao de uma tarefa chega a quem espera o grupo
+static void test_exception() {
+    TaskScheduler scheduler(2);
+    bool thrown = false;
+    {
+        TaskScheduler::Group group(&scheduler);
+        group.run([] { throw std::runtime_error("falha"); });
+        group.run([] {});
+        try {
+            group.wait();
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+    }
+    assert(thrown);
+    assert(fib(&scheduler, 15) == 610);
+}
+
+int main() {
+    test_deque_steal();
+    test_fork_join();
+    test_exception();
+    std::puts("task_scheduler_test: ok");
+    return 0;
+}
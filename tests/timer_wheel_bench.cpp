@@ -0,0 +1,96 @@
+// Copyright [2019] <Bryan Martins Lima>
+// COUNT temporizadores com vencimento aleatorio em ate SPAN ticks: agenda
+// todos, cancela metade e avanca o tempo em passos de STEP ate o fim.
+// TimerWheel contra std::multimap ordenado por vencimento, que e' O(log n)
+// por operacao; mostra ms de cada fase.
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../timer_wheel.h"
+#include "./bench.h"
+
+static const std::size_t COUNT = 10000000;
+static const std::uint64_t SPAN = 1u << 20;
+static const std::uint64_t STEP = 1000;
+
+struct Phases {
+    double schedule;
+    double cancel;
+    double expire;
+    long fired;
+};
+
+static Phases wheel_phases(const std::vector<std::uint64_t>& deadlines) {
+    using Wheel = structures::TimerWheel<int>;
+    Phases phases;
+    Wheel wheel;
+    std::vector<Wheel::Handle> handles(deadlines.size());
+    bench::Stopwatch watch;
+    for (std::size_t i = 0; i < deadlines.size(); i++) {
+        handles[i] = wheel.schedule(deadlines[i], static_cast<int>(i));
+    }
+    phases.schedule = watch.ms();
+    watch.restart();
+    for (std::size_t i = 0; i < deadlines.size(); i += 2) {
+        wheel.cancel(handles[i]);
+    }
+    phases.cancel = watch.ms();
+    watch.restart();
+    long fired = 0;
+    for (std::uint64_t now = 0; now <= SPAN; now += STEP) {
+        wheel.advance(now, [&fired](int data) { fired += data & 1; });
+    }
+    phases.expire = watch.ms();
+    phases.fired = fired;
+    return phases;
+}
+
+static Phases map_phases(const std::vector<std::uint64_t>& deadlines) {
+    using Map = std::multimap<std::uint64_t, int>;
+    Phases phases;
+    Map timers;
+    std::vector<Map::iterator> handles(deadlines.size());
+    bench::Stopwatch watch;
+    for (std::size_t i = 0; i < deadlines.size(); i++) {
+        handles[i] = timers.emplace(deadlines[i], static_cast<int>(i));
+    }
+    phases.schedule = watch.ms();
+    watch.restart();
+    for (std::size_t i = 0; i < deadlines.size(); i += 2) {
+        timers.erase(handles[i]);
+    }
+    phases.cancel = watch.ms();
+    watch.restart();
+    long fired = 0;
+    for (std::uint64_t now = 0; now <= SPAN; now += STEP) {
+        while (!timers.empty() && timers.begin()->first <= now) {
+            fired += timers.begin()->second & 1;
+            timers.erase(timers.begin());
+        }
+    }
+    phases.expire = watch.ms();
+    phases.fired = fired;
+    return phases;
+}
+
+static void print(const char* name, const Phases& phases) {
+    std::printf("  %-14s %9.1f %9.1f %9.1f %10ld\n", name, phases.schedule,
+                phases.cancel, phases.expire, phases.fired);
+}
+
+int main() {
+    std::mt19937_64 random(35);
+    std::vector<std::uint64_t> deadlines(COUNT);
+    for (std::uint64_t& deadline : deadlines) {
+        deadline = 1 + random() % SPAN;
+    }
+    std::printf("%zu temporizadores em %llu ticks: ms por fase\n", COUNT,
+                static_cast<unsigned long long>(SPAN));
+    std::puts("                    agenda   cancela     vence disparados");
+    print("TimerWheel", wheel_phases(deadlines));
+    print("std::multimap", map_phases(deadlines));
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Copyright [2019] <Bryan Martins Lima>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../timer_wheel.h"
+
+using Wheel = structures::TimerWheel<int>;
+
+//! avanca ate now e devolve os dados disparados, ordenados
+static std::vector<int> advance(Wheel* wheel, std::uint64_t now) {
+    std::vector<int> fired;
+    std::size_t count = wheel->advance(now, [&fired](int data) {
+        fired.push_back(data);
+    });
+    assert(count == fired.size());
+    std::sort(fired.begin(), fired.end());
+    return fired;
+}
+
+//! vencimentos dos dois lados de cada fronteira de nivel disparam no
+//! tick exato, partindo de um tempo alinhado e de um desalinhado
+static void test_cascade_boundaries() {
+    const std::uint64_t limit = std::uint64_t(1) << 32;
+    for (std::uint64_t start : {std::uint64_t(0), std::uint64_t(1000)}) {
+        Wheel wheel(start);
+        std::vector<std::uint64_t> deadlines;
+        for (std::uint64_t edge : {std::uint64_t(1) << 8,
+                                   std::uint64_t(1) << 16,
+                                   std::uint64_t(1) << 24, limit}) {
+            for (std::uint64_t d : {edge - 1, edge, edge + 1}) {
+                deadlines.push_back(start + d);
+            }
+        }
+        // alem do ultimo nivel: estaciona e e' conferido na cascata
+        deadlines.push_back(start + 3 * limit + 7);
+        for (std::size_t i = 0; i < deadlines.size(); i++) {
+            wheel.schedule(deadlines[i], static_cast<int>(i));
+        }
+        for (std::size_t i = 0; i < deadlines.size(); i++) {
+            assert(advance(&wheel, deadlines[i] - 1).empty());
+            assert(advance(&wheel, deadlines[i]) ==
+                   std::vector<int>{static_cast<int>(i)});
+            assert(wheel.now() == deadlines[i]);
+            assert(wheel.size() == deadlines.size() - i - 1);
+        }
+        assert(wheel.empty());
+    }
+}
+
+//! o indice de um cancelado volta para reuso; o handle velho nao cancela
+//! o temporizador novo que ocupa o mesmo indice
+static void test_cancel_then_reuse() {
+    Wheel wheel;
+    Wheel::Handle old = wheel.schedule(10, 1);
+    assert(wheel.cancel(old) && !wheel.cancel(old));
+    assert(wheel.empty());
+    // o indice so e' liberado quando a posicao dele e' processada
+    assert(advance(&wheel, 10).empty());
+    Wheel::Handle fresh = wheel.schedule(20, 2);
+    assert(!wheel.cancel(old));
+    assert(wheel.size() == 1);
+    assert(advance(&wheel, 20) == std::vector<int>{2});
+    assert(!wheel.cancel(fresh));
+    // de novo, com o cancelado ainda numa posicao de nivel alto
+    Wheel::Handle far = wheel.schedule(100000, 3);
+    assert(wheel.cancel(far));
+    Wheel::Handle near = wheel.schedule(30, 4);
+    assert(advance(&wheel, 100000) == std::vector<int>{4});
+    Wheel::Handle reused = wheel.schedule(100010, 5);
+    assert(!wheel.cancel(far) && !wheel.cancel(near));
+    assert(wheel.cancel(reused) && wheel.empty());
+    assert(advance(&wheel, 200000).empty());
+}
+
+//! agendar dentro de on_expire cai num tick futuro
+static void test_schedule_on_expire() {
+    Wheel wheel;
+    wheel.schedule(5, 0);
+    std::vector<int> fired;
+    wheel.advance(300, [&wheel, &fired](int data) {
+        fired.push_back(data);
+        if (data < 3) {
+            wheel.schedule(wheel.now(), data + 1);
+        }
+    });
+    assert((fired == std::vector<int>{0, 1, 2, 3}));
+}
+
+//! operacoes aleatorias comparadas com um multimap de vencimentos
+static void test_against_multimap() {
+    std::mt19937_64 random(35);
+    const std::uint64_t spans[] = {300, 70000, std::uint64_t(1) << 25};
+    Wheel wheel(12345);
+    std::uint64_t now = 12345;
+    std::multimap<std::uint64_t, int> expected;
+    std::vector<Wheel::Handle> handles;
+    std::vector<std::multimap<std::uint64_t, int>::iterator> entries;
+    std::vector<bool> pending;
+    for (int round = 0; round < 2000; round++) {
+        for (int i = 0; i < 20; i++) {
+            std::uint64_t span = spans[random() % 3];
+            // alguns ja vencidos: disparam no tick seguinte a now
+            std::uint64_t deadline = now - 50 + random() % span;
+            int id = static_cast<int>(handles.size());
+            handles.push_back(wheel.schedule(deadline, id));
+            entries.push_back(
+                expected.emplace(std::max(deadline, now + 1), id));
+            pending.push_back(true);
+        }
+        for (int i = 0; i < 5; i++) {
+            int id = static_cast<int>(random() % handles.size());
+            assert(wheel.cancel(handles[id]) == pending[id]);
+            if (pending[id]) {
+                expected.erase(entries[id]);
+                pending[id] = false;
+            }
+        }
+        now += random() % spans[random() % 3] / 16;
+        std::vector<int> due;
+        while (!expected.empty() && expected.begin()->first <= now) {
+            due.push_back(expected.begin()->second);
+            pending[expected.begin()->second] = false;
+            expected.erase(expected.begin());
+        }
+        std::sort(due.begin(), due.end());
+        assert(advance(&wheel, now) == due);
+        assert(wheel.size() == expected.size());
+    }
+}
+
+int main() {
+    test_cascade_boundaries();
+    test_cancel_then_reuse();
+    test_schedule_on_expire();
+    test_against_multimap();
+    std::puts("timer_wheel_test: ok");
+    return 0;
+}
@@ -0,0 +1,258 @@
+//! Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_TIMER_WHEEL_H
+#define STRUCTURES_TIMER_WHEEL_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "./circular_list.h"
+
+namespace structures {
+
+//! Classe de roda de temporizadores hierarquica
+/*!
+ *  LEVELS niveis de SLOTS posicoes; cada posicao e' uma CircularList com
+ *  os indices dos temporizadores que vencem naquele intervalo. O nivel L
+ *  guarda vencimentos ate 2^(8(L+1)) ticks a frente; quando o nivel
+ *  abaixo da a volta, a posicao correspondente e' redistribuida
+ *  (cascata). schedule e cancel sao O(1); cancel apenas marca o
+ *  temporizador, que e' descartado quando sua posicao for processada.
+ */
+template<typename T>
+class TimerWheel {
+ public:
+    //! referencia a um temporizador agendado
+    class Handle {
+     public:
+        //! handle invalido
+        Handle() : index_{static_cast<std::size_t>(-1)}, generation_{0} {}
+
+     private:
+        friend class TimerWheel;
+        Handle(std::size_t index, std::uint32_t generation):
+            index_{index},
+            generation_{generation}
+        {}
+        std::size_t index_;
+        std::uint32_t generation_;
+    };
+
+    //! construtor com o tempo inicial (em ticks)
+    explicit TimerWheel(std::uint64_t now = 0);
+    //! destrutor
+    ~TimerWheel();
+    //! agenda data para o tick deadline (vencidos disparam no proximo)
+    Handle schedule(std::uint64_t deadline, const T& data);
+    //! cancela; false se ja disparou ou foi cancelado
+    bool cancel(Handle handle);
+    //! avanca ate now, chamando on_expire(data) para cada vencido
+    template<typename F>
+    std::size_t advance(std::uint64_t now, F&& on_expire);
+    //! tempo atual (ultimo tick processado)
+    std::uint64_t now() const;
+    //! numero de temporizadores ativos
+    std::size_t size() const;
+    //! roda vazia
+    bool empty() const;
+
+ private:
+    struct Timer {
+        T data;
+        std::uint64_t deadline;
+        std::uint32_t generation;
+        bool active;
+    };
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    //! coloca o temporizador index na posicao do seu vencimento
+    void place(std::size_t index);
+    //! redistribui a posicao slot do nivel level
+    void cascade(std::size_t level, std::size_t slot);
+    //! devolve o temporizador index para a lista de livres
+    void release(std::size_t index);
+
+    CircularList<std::size_t>* slots_;  // LEVELS * SLOTS listas
+    std::vector<Timer> timers_;
+    std::vector<std::size_t> free_;
+    std::uint64_t current_;  // proximo tick a processar
+    std::size_t size_;
+
+    static const std::size_t SLOT_BITS = 8u;
+    static const std::size_t SLOTS = 1u << SLOT_BITS;
+    static const std::size_t LEVELS = 4u;
+
+    std::size_t counts_[LEVELS];  // entradas (inclusive canceladas) por nivel
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::TimerWheel<T>::TimerWheel(std::uint64_t now) {
+    slots_ = new CircularList<std::size_t>[LEVELS * SLOTS];
+    current_ = now + 1;
+    size_ = 0;
+    for (std::size_t level = 0; level < LEVELS; level++) {
+        counts_[level] = 0;
+    }
+}
+
+template<typename T>
+structures::TimerWheel<T>::~TimerWheel() {
+    delete [] slots_;
+}
+
+template<typename T>
+void structures::TimerWheel<T>::place(std::size_t index) {
+    std::uint64_t deadline = timers_[index].deadline;
+    if (deadline < current_) {
+        deadline = current_;
+    }
+    std::uint64_t delta = deadline - current_;
+    std::size_t level = 0;
+    while (level + 1 < LEVELS && delta >> (SLOT_BITS * (level + 1)) != 0) {
+        level++;
+    }
+    if (delta >> (SLOT_BITS * LEVELS) != 0) {
+        // alem do ultimo nivel: estaciona no ponto mais distante e o
+        // vencimento real e' conferido de novo na cascata
+        deadline = current_ + (std::uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+    }
+    std::size_t slot = (deadline >> (SLOT_BITS * level)) & (SLOTS - 1);
+    slots_[level * SLOTS + slot].push_front(index);
+    counts_[level]++;
+}
+
+template<typename T>
+void structures::TimerWheel<T>::cascade(std::size_t level, std::size_t slot) {
+    CircularList<std::size_t>& list = slots_[level * SLOTS + slot];
+    while (!list.empty()) {
+        std::size_t index = list.pop_front();
+        counts_[level]--;
+        if (timers_[index].active) {
+            place(index);
+        } else {
+            release(index);
+        }
+    }
+}
+
+template<typename T>
+void structures::TimerWheel<T>::release(std::size_t index) {
+    timers_[index].generation++;
+    free_.push_back(index);
+}
+
+template<typename T>
+typename structures::TimerWheel<T>::Handle
+structures::TimerWheel<T>::schedule(std::uint64_t deadline, const T& data) {
+    std::size_t index;
+    if (!free_.empty()) {
+        index = free_.back();
+        free_.pop_back();
+        timers_[index].data = data;
+        timers_[index].deadline = deadline;
+        timers_[index].active = true;
+    } else {
+        index = timers_.size();
+        timers_.push_back(Timer{data, deadline, 0, true});
+    }
+    place(index);
+    size_++;
+    return Handle(index, timers_[index].generation);
+}
+
+template<typename T>
+bool structures::TimerWheel<T>::cancel(Handle handle) {
+    if (handle.index_ >= timers_.size()) {
+        return false;
+    }
+    Timer& timer = timers_[handle.index_];
+    if (timer.generation != handle.generation_ || !timer.active) {
+        return false;
+    }
+    timer.active = false;
+    size_--;
+    return true;
+}
+
+template<typename T>
+template<typename F>
+std::size_t structures::TimerWheel<T>::advance(std::uint64_t now,
+                                               F&& on_expire) {
+    std::size_t fired = 0;
+    std::vector<std::size_t> batch;
+    while (current_ <= now) {
+        // se os niveis 0..empty-1 estao vazios nada acontece antes da
+        // proxima cascata do nivel empty: pula direto para ela
+        std::size_t empty = 0;
+        while (empty < LEVELS && counts_[empty] == 0) {
+            empty++;
+        }
+        if (empty == LEVELS) {
+            current_ = now + 1;
+            break;
+        }
+        if (empty > 0) {
+            std::uint64_t step = std::uint64_t(1) << (SLOT_BITS * empty);
+            std::uint64_t next = (current_ + step - 1) & ~(step - 1);
+            if (next > now) {
+                current_ = now + 1;
+                break;
+            }
+            current_ = next;
+        }
+        std::uint64_t tick = current_;
+        std::size_t slot = tick & (SLOTS - 1);
+        // cada nivel que da a volta desce uma posicao do nivel acima
+        for (std::size_t level = 1; level < LEVELS; level++) {
+            if ((tick >> (SLOT_BITS * (level - 1))) & (SLOTS - 1)) {
+                break;
+            }
+            cascade(level, (tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+        }
+        CircularList<std::size_t>& list = slots_[slot];
+        while (!list.empty()) {
+            batch.push_back(list.pop_front());
+            counts_[0]--;
+        }
+        // novos agendamentos feitos em on_expire caem em ticks futuros
+        current_ = tick + 1;
+        for (std::size_t index : batch) {
+            Timer& timer = timers_[index];
+            if (!timer.active) {
+                release(index);
+            } else if (timer.deadline > tick) {
+                place(index);
+            } else {
+                timer.active = false;
+                size_--;
+                T data = std::move(timer.data);
+                release(index);
+                on_expire(data);
+                fired++;
+            }
+        }
+        batch.clear();
+    }
+    return fired;
+}
+
+template<typename T>
+std::uint64_t structures::TimerWheel<T>::now() const {
+    return current_ - 1;
+}
+
+template<typename T>
+std::size_t structures::TimerWheel<T>::size() const {
+    return size_;
+}
+
+template<typename T>
+bool structures::TimerWheel<T>::empty() const {
+    return size_ == 0;
+}
+
+#endif
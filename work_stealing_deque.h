@@ -0,0 +1,200 @@
+// Copyright [2019] <Bryan Martins Lima>
+#ifndef STRUCTURES_WORK_STEALING_DEQUE_H
+#define STRUCTURES_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace structures {
+
+template<typename T>
+//! Classe deque de roubo de trabalho (Chase-Lev), sem locks
+/*!
+ *  Uma unica thread dona empilha e desempilha no fundo (push/pop, LIFO);
+ *  qualquer outra thread rouba do topo (steal, FIFO) com um CAS. O caminho
+ *  rapido do dono nao faz operacao atomica read-modify-write: so pop do
+ *  ultimo elemento disputa o topo com os ladroes. O array circular dobra
+ *  quando enche; arrays antigos ficam guardados ate a destruicao, pois um
+ *  ladrao atrasado ainda pode estar lendo deles. T deve ser trivialmente
+ *  copiavel (tipicamente um ponteiro para tarefa).
+ */
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "T deve ser trivialmente copiavel");
+
+ public:
+    //! construtor padrão
+    WorkStealingDeque();
+    //! construtor com capacidade inicial (arredondada para potencia de 2)
+    explicit WorkStealingDeque(std::size_t capacity);
+    //! destrutor
+    ~WorkStealingDeque();
+    //! adiciona no fundo (somente a thread dona)
+    void push(const T& data);
+    //! remove do fundo em *data; false se vazio (somente a thread dona)
+    bool pop(T* data);
+    //! remove do topo em *data; false se vazio ou se perdeu a disputa
+    bool steal(T* data);
+    //! numero aproximado de elementos
+    std::size_t size() const;
+    //! verifica se (aparentemente) esta vazio
+    bool empty() const;
+    //! capacidade do array atual
+    std::size_t capacity() const;
+
+ private:
+    //! array circular de tamanho potencia de 2
+    struct Array {
+        explicit Array(std::size_t size);
+        T get(std::int64_t index) const;
+        void put(std::int64_t index, const T& data);
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    //! copia [top, bottom) para um array com o dobro do tamanho
+    Array* grow(Array* old, std::int64_t bottom, std::int64_t top);
+
+    // topo e fundo em linhas de cache separadas: ladroes x dono
+    alignas(64) std::atomic<std::int64_t> top_;
+    alignas(64) std::atomic<std::int64_t> bottom_;
+    std::atomic<Array*> array_;
+    std::vector<std::unique_ptr<Array>> arrays_;  // atual e antigos
+
+    static const auto DEFAULT_SIZE = 64u;
+};
+
+}  // namespace structures
+
+template<typename T>
+structures::WorkStealingDeque<T>::Array::Array(std::size_t size) {
+    mask = size - 1;
+    slots.reset(new std::atomic<T>[size]);
+}
+
+template<typename T>
+T structures::WorkStealingDeque<T>::Array::get(std::int64_t index) const {
+    return slots[static_cast<std::size_t>(index) & mask].load(
+        std::memory_order_relaxed);
+}
+
+template<typename T>
+void structures::WorkStealingDeque<T>::Array::put(std::int64_t index,
+                                                  const T& data) {
+    slots[static_cast<std::size_t>(index) & mask].store(
+        data, std::memory_order_relaxed);
+}
+
+template<typename T>
+structures::WorkStealingDeque<T>::WorkStealingDeque():
+    WorkStealingDeque(DEFAULT_SIZE)
+{}
+
+template<typename T>
+structures::WorkStealingDeque<T>::WorkStealingDeque(std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    arrays_.emplace_back(new Array(size));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    top_.store(0, std::memory_order_relaxed);
+    bottom_.store(0, std::memory_order_relaxed);
+}
+
+template<typename T>
+structures::WorkStealingDeque<T>::~WorkStealingDeque() {}
+
+template<typename T>
+typename structures::WorkStealingDeque<T>::Array*
+structures::WorkStealingDeque<T>::grow(Array* old, std::int64_t bottom,
+                                       std::int64_t top) {
+    Array* array = new Array(2 * (old->mask + 1));
+    arrays_.emplace_back(array);
+    for (std::int64_t i = top; i < bottom; i++) {
+        array->put(i, old->get(i));
+    }
+    array_.store(array, std::memory_order_release);
+    return array;
+}
+
+template<typename T>
+void structures::WorkStealingDeque<T>::push(const T& data) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<std::int64_t>(array->mask)) {
+        array = grow(array, bottom, top);
+    }
+    array->put(bottom, data);
+    // store release publica o slot para o load acquire de steal
+    bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+template<typename T>
+bool structures::WorkStealingDeque<T>::pop(T* data) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    // o fundo reservado precisa ser visivel antes de ler o topo
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    *data = array->get(bottom);
+    if (top == bottom) {
+        // ultimo elemento: disputa com os ladroes pelo topo
+        bool won = top_.compare_exchange_strong(
+            top, top + 1, std::memory_order_seq_cst,
+            std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+template<typename T>
+bool structures::WorkStealingDeque<T>::steal(T* data) {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+    Array* array = array_.load(std::memory_order_acquire);
+    T value = array->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return false;
+    }
+    *data = value;
+    return true;
+}
+
+template<typename T>
+std::size_t structures::WorkStealingDeque<T>::size() const {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0u;
+}
+
+template<typename T>
+bool structures::WorkStealingDeque<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+std::size_t structures::WorkStealingDeque<T>::capacity() const {
+    return array_.load(std::memory_order_relaxed)->mask + 1;
+}
+
+#endif